@@ -326,23 +326,7 @@ template<> struct ldlt_inplace<Lower>
       index_of_biggest_in_corner += k;
 
       transpositions.coeffRef(k) = IndexType(index_of_biggest_in_corner);
-      if(k != index_of_biggest_in_corner)
-      {
-        // apply the transposition while taking care to consider only
-        // the lower triangular part
-        Index s = size-index_of_biggest_in_corner-1; // trailing size after the biggest element
-        mat.row(k).head(k).swap(mat.row(index_of_biggest_in_corner).head(k));
-        mat.col(k).tail(s).swap(mat.col(index_of_biggest_in_corner).tail(s));
-        std::swap(mat.coeffRef(k,k),mat.coeffRef(index_of_biggest_in_corner,index_of_biggest_in_corner));
-        for(Index i=k+1;i<index_of_biggest_in_corner;++i)
-        {
-          Scalar tmp = mat.coeffRef(i,k);
-          mat.coeffRef(i,k) = numext::conj(mat.coeffRef(index_of_biggest_in_corner,i));
-          mat.coeffRef(index_of_biggest_in_corner,i) = numext::conj(tmp);
-        }
-        if(NumTraits<Scalar>::IsComplex)
-          mat.coeffRef(index_of_biggest_in_corner,k) = numext::conj(mat.coeff(index_of_biggest_in_corner,k));
-      }
+      swapLower(mat, k, index_of_biggest_in_corner);
 
       // partition the matrix:
       //       A00 |  -  |  -
@@ -381,21 +365,139 @@ template<> struct ldlt_inplace<Lower>
         return ret;
       }
 
-      if((rs>0) && pivot_is_valid)
-        A21 /= realAkk;
-      else if(rs>0)
-        ret = ret && (A21.array()==Scalar(0)).all();
-
-      if(found_zero_pivot && pivot_is_valid) ret = false; // factorization failed
-      else if(!pivot_is_valid) found_zero_pivot = true;
-
-      if (sign == PositiveSemiDef) {
-        if (realAkk < static_cast<RealScalar>(0)) sign = Indefinite;
-      } else if (sign == NegativeSemiDef) {
-        if (realAkk > static_cast<RealScalar>(0)) sign = Indefinite;
-      } else if (sign == ZeroSign) {
-        if (realAkk > static_cast<RealScalar>(0)) sign = PositiveSemiDef;
-        else if (realAkk < static_cast<RealScalar>(0)) sign = NegativeSemiDef;
+      ret = scalePivotColumn(A21, realAkk, found_zero_pivot, sign) && ret;
+    }
+
+    return ret;
+  }
+
+  /** \internal Applies the transposition of the rows and columns \a k and \a p>=k of the selfadjoint matrix
+    * whose lower triangular part is stored in \a mat. */
+  template<typename MatrixType>
+  static void swapLower(MatrixType& mat, Index k, Index p)
+  {
+    typedef typename MatrixType::Scalar Scalar;
+    if(k == p)
+      return;
+    // apply the transposition while taking care to consider only
+    // the lower triangular part
+    const Index size = mat.rows();
+    Index s = size-p-1; // trailing size after the biggest element
+    mat.row(k).head(k).swap(mat.row(p).head(k));
+    mat.col(k).tail(s).swap(mat.col(p).tail(s));
+    std::swap(mat.coeffRef(k,k),mat.coeffRef(p,p));
+    for(Index i=k+1;i<p;++i)
+    {
+      Scalar tmp = mat.coeffRef(i,k);
+      mat.coeffRef(i,k) = numext::conj(mat.coeffRef(p,i));
+      mat.coeffRef(p,i) = numext::conj(tmp);
+    }
+    if(NumTraits<Scalar>::IsComplex)
+      mat.coeffRef(p,k) = numext::conj(mat.coeff(p,k));
+  }
+
+  /** \internal Divides the column \a A21 below the updated pivot \a realAkk by the pivot, and updates the sign
+    * of the matrix and the zero pivot flag. \returns false if the factorization failed at this pivot. */
+  template<typename ColType, typename RealScalar>
+  static bool scalePivotColumn(ColType& A21, const RealScalar& realAkk, bool& found_zero_pivot, SignMatrix& sign)
+  {
+    using std::abs;
+    typedef typename ColType::Scalar Scalar;
+    bool ret = true;
+    bool pivot_is_valid = (abs(realAkk) > RealScalar(0));
+    Index rs = A21.size();
+
+    if((rs>0) && pivot_is_valid)
+      A21 /= realAkk;
+    else if(rs>0)
+      ret = (A21.array()==Scalar(0)).all();
+
+    if(found_zero_pivot && pivot_is_valid) ret = false; // factorization failed
+    else if(!pivot_is_valid) found_zero_pivot = true;
+
+    if (sign == PositiveSemiDef) {
+      if (realAkk < static_cast<RealScalar>(0)) sign = Indefinite;
+    } else if (sign == NegativeSemiDef) {
+      if (realAkk > static_cast<RealScalar>(0)) sign = Indefinite;
+    } else if (sign == ZeroSign) {
+      if (realAkk > static_cast<RealScalar>(0)) sign = PositiveSemiDef;
+      else if (realAkk < static_cast<RealScalar>(0)) sign = NegativeSemiDef;
+    }
+    return ret;
+  }
+
+  /* Blocked version of unblocked().
+   *
+   * The pivots of unblocked() are selected on the diagonal of the input matrix, which is not modified by
+   * its left-looking updates. Therefore, all the transpositions can be applied first, and the permuted
+   * matrix is then factorized without pivoting, by panels of columns: the columns of a panel are computed
+   * by left-looking updates restricted to the panel, and the trailing matrix is updated by a single
+   * triangular matrix product A22 -= (L21 D1) L21^*.
+   * This computes the same factorization and transpositions as unblocked(), up to rounding errors.
+   */
+  template<typename MatrixType, typename TranspositionType, typename Workspace>
+  static bool blocked(MatrixType& mat, TranspositionType& transpositions, Workspace& temp, SignMatrix& sign)
+  {
+    using std::abs;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename TranspositionType::StorageIndex IndexType;
+    eigen_assert(mat.rows()==mat.cols());
+    const Index size = mat.rows();
+    if(size<32)
+      return unblocked(mat, transpositions, temp, sign);
+
+    for(Index k = 0; k < size; ++k)
+    {
+      Index index_of_biggest_in_corner;
+      mat.diagonal().tail(size-k).cwiseAbs().maxCoeff(&index_of_biggest_in_corner);
+      index_of_biggest_in_corner += k;
+      transpositions.coeffRef(k) = IndexType(index_of_biggest_in_corner);
+      swapLower(mat, k, index_of_biggest_in_corner);
+    }
+
+    // The entire diagonal is zero, and no transposition was applied.
+    if(!(abs(numext::real(mat.coeff(0,0))) > RealScalar(0)))
+      return unblocked(mat, transpositions, temp, sign);
+
+    Index blockSize = size/8;
+    blockSize = (blockSize/16)*16;
+    blockSize = (std::min)((std::max)(blockSize,Index(8)), Index(128));
+
+    Matrix<Scalar,Dynamic,Dynamic,0,MatrixType::MaxRowsAtCompileTime,MatrixType::MaxColsAtCompileTime> W;
+    bool found_zero_pivot = false;
+    bool ret = true;
+    sign = ZeroSign;
+    for(Index k = 0; k < size; k += blockSize)
+    {
+      // partition the matrix:
+      //       A00 |  -  |  -
+      // lu  = A10 | A11 |  -
+      //       A20 | A21 | A22
+      const Index bs = (std::min)(blockSize, size-k);
+      const Index rs = size - k - bs;
+
+      for(Index j = 0; j < bs; ++j)
+      {
+        const Index c = k + j;
+        Block<MatrixType,Dynamic,1> a21(mat,c+1,c,size-c-1,1);
+        if(j>0)
+        {
+          Block<MatrixType,1,Dynamic> a10(mat,c,k,1,j);
+          Block<MatrixType,Dynamic,Dynamic> a20(mat,c+1,k,size-c-1,j);
+          temp.head(j) = mat.diagonal().real().segment(k,j).asDiagonal() * a10.adjoint();
+          mat.coeffRef(c,c) -= (a10 * temp.head(j)).value();
+          a21.noalias() -= a20 * temp.head(j);
+        }
+        ret = scalePivotColumn(a21, numext::real(mat.coeff(c,c)), found_zero_pivot, sign) && ret;
+      }
+
+      if(rs>0)
+      {
+        Block<MatrixType,Dynamic,Dynamic> A21(mat,k+bs,k,rs,bs);
+        Block<MatrixType,Dynamic,Dynamic> A22(mat,k+bs,k+bs,rs,rs);
+        W.noalias() = A21 * mat.diagonal().real().segment(k,bs).asDiagonal();
+        A22.template triangularView<Lower>() -= W * A21.adjoint();
       }
     }
 
@@ -466,6 +568,13 @@ template<> struct ldlt_inplace<Upper>
     return ldlt_inplace<Lower>::unblocked(matt, transpositions, temp, sign);
   }
 
+  template<typename MatrixType, typename TranspositionType, typename Workspace>
+  static EIGEN_STRONG_INLINE bool blocked(MatrixType& mat, TranspositionType& transpositions, Workspace& temp, SignMatrix& sign)
+  {
+    Transpose<MatrixType> matt(mat);
+    return ldlt_inplace<Lower>::blocked(matt, transpositions, temp, sign);
+  }
+
   template<typename MatrixType, typename TranspositionType, typename Workspace, typename WType>
   static EIGEN_STRONG_INLINE bool update(MatrixType& mat, TranspositionType& transpositions, Workspace& tmp, WType& w, const typename MatrixType::RealScalar& sigma=1)
   {
@@ -523,7 +632,7 @@ LDLT<MatrixType,_UpLo>& LDLT<MatrixType,_UpLo>::compute(const EigenBase<InputTyp
   m_temporary.resize(size);
   m_sign = internal::ZeroSign;
 
-  m_info = internal::ldlt_inplace<UpLo>::unblocked(m_matrix, m_transpositions, m_temporary, m_sign) ? Success : NumericalIssue;
+  m_info = internal::ldlt_inplace<UpLo>::blocked(m_matrix, m_transpositions, m_temporary, m_sign) ? Success : NumericalIssue;
 
   m_isInitialized = true;
   return *this;
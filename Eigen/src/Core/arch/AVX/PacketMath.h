@@ -86,9 +86,13 @@ template<> struct packet_traits<double> : default_packet_traits
     HasHalfPacket = 1,
 
     HasDiv  = 1,
+    HasSin  = EIGEN_FAST_MATH,
+    HasCos  = EIGEN_FAST_MATH,
+    HasLog  = 1,
     HasExp  = 1,
     HasSqrt = 1,
     HasRsqrt = 1,
+    HasTanh = EIGEN_FAST_MATH,
     HasBlend = 1,
     HasRound = 1,
     HasFloor = 1,
@@ -261,6 +265,9 @@ template<> EIGEN_STRONG_INLINE Packet8f pcmp_lt(const Packet8f& a, const Packet8
 template<> EIGEN_STRONG_INLINE Packet8f pcmp_eq(const Packet8f& a, const Packet8f& b) { return _mm256_cmp_ps(a,b,_CMP_EQ_OQ); }
 template<> EIGEN_STRONG_INLINE Packet4d pcmp_eq(const Packet4d& a, const Packet4d& b) { return _mm256_cmp_pd(a,b,_CMP_EQ_OQ); }
 template<> EIGEN_STRONG_INLINE Packet8f pcmp_lt_or_nan(const Packet8f& a, const Packet8f& b) { return _mm256_cmp_ps(a, b, _CMP_NGE_UQ); }
+template<> EIGEN_STRONG_INLINE Packet4d pcmp_le(const Packet4d& a, const Packet4d& b) { return _mm256_cmp_pd(a,b,_CMP_LE_OQ); }
+template<> EIGEN_STRONG_INLINE Packet4d pcmp_lt(const Packet4d& a, const Packet4d& b) { return _mm256_cmp_pd(a,b,_CMP_LT_OQ); }
+template<> EIGEN_STRONG_INLINE Packet4d pcmp_lt_or_nan(const Packet4d& a, const Packet4d& b) { return _mm256_cmp_pd(a, b, _CMP_NGE_UQ); }
 
 template<> EIGEN_STRONG_INLINE Packet8i pcmp_eq(const Packet8i& a, const Packet8i& b) {
 #ifdef EIGEN_VECTORIZE_AVX2
@@ -528,6 +535,19 @@ template<> EIGEN_STRONG_INLINE Packet8f pldexp<Packet8f>(const Packet8f& a, cons
   return pldexp_float(a,exponent);
 }
 
+template<> EIGEN_STRONG_INLINE Packet4d pfrexp<Packet4d>(const Packet4d& a, Packet4d& exponent) {
+  // Shift the biased exponents down in 128-bit halves, and gather their low
+  // 32 bits in a single vector to convert them.
+  const Packet4d cst_exp_mask = _mm256_castsi256_pd(_mm256_setr_epi32(0, 0x7ff00000, 0, 0x7ff00000, 0, 0x7ff00000, 0, 0x7ff00000));
+  const Packet4d cst_half = pset1<Packet4d>(0.5);
+  __m256i e = _mm256_castpd_si256(pand(a, cst_exp_mask));
+  __m128i lo = _mm_srli_epi64(_mm256_extractf128_si256(e, 0), 52);
+  __m128i hi = _mm_srli_epi64(_mm256_extractf128_si256(e, 1), 52);
+  __m128i emm0 = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2,0,2,0)));
+  exponent = psub(_mm256_cvtepi32_pd(emm0), pset1<Packet4d>(1022.0));
+  return por(pandnot(a, cst_exp_mask), cst_half);
+}
+
 template<> EIGEN_STRONG_INLINE Packet4d pldexp<Packet4d>(const Packet4d& a, const Packet4d& exponent) {
   // Build e=2^n by constructing the exponents in a 128-bit vector and
   // shifting them to where they belong in double-precision values.
@@ -649,6 +669,11 @@ template<> EIGEN_STRONG_INLINE bool predux_any(const Packet8f& x)
   return _mm256_movemask_ps(x)!=0;
 }
 
+template<> EIGEN_STRONG_INLINE bool predux_any(const Packet4d& x)
+{
+  return _mm256_movemask_pd(x)!=0;
+}
+
 template<int Offset>
 struct palign_impl<Offset,Packet8f>
 {
@@ -126,6 +126,97 @@ Packet plog_float(const Packet _x)
                               por(pselect(pos_inf_mask,cst_pos_inf,x), invalid_mask));
 }
 
+// Natural logarithm in double precision.
+// The mantissa m of x is brought in the range [sqrt(1/2),sqrt(2)) as in
+// plog_float, and log(1+(m-1)) is approximated by the rational function of the
+// cephes library: log(1+x) = x - x^2/2 + x^3 P(x)/Q(x). The relative error is
+// below 2 ulps over the whole positive range, denormals included.
+template <typename Packet>
+EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+EIGEN_UNUSED
+Packet plog_double(const Packet _x)
+{
+  Packet x = _x;
+
+  const Packet cst_1              = pset1<Packet>(1.0);
+  const Packet cst_half           = pset1<Packet>(0.5);
+  // The smallest non denormalized double, and 2^54 to scale the denormals.
+  const Packet cst_min_norm_pos   = pset1<Packet>((std::numeric_limits<double>::min)());
+  const Packet cst_2p54           = pset1<Packet>(18014398509481984.0);
+  const Packet cst_54             = pset1<Packet>(54.0);
+  const Packet cst_minus_inf      = pset1<Packet>(-NumTraits<double>::infinity());
+  const Packet cst_pos_inf        = pset1<Packet>( NumTraits<double>::infinity());
+
+  // Polynomial coefficients.
+  const Packet cst_cephes_SQRTHF = pset1<Packet>(0.70710678118654752440);
+  const Packet cst_cephes_log_p0 = pset1<Packet>(1.01875663804580931796E-4);
+  const Packet cst_cephes_log_p1 = pset1<Packet>(4.97494994976747001425E-1);
+  const Packet cst_cephes_log_p2 = pset1<Packet>(4.70579119878881725854E0);
+  const Packet cst_cephes_log_p3 = pset1<Packet>(1.44989225341610930846E1);
+  const Packet cst_cephes_log_p4 = pset1<Packet>(1.79368678507819816313E1);
+  const Packet cst_cephes_log_p5 = pset1<Packet>(7.70838733755885391666E0);
+  const Packet cst_cephes_log_q0 = pset1<Packet>(1.12873587189167450590E1);
+  const Packet cst_cephes_log_q1 = pset1<Packet>(4.52279145837532221105E1);
+  const Packet cst_cephes_log_q2 = pset1<Packet>(8.29875266912776603211E1);
+  const Packet cst_cephes_log_q3 = pset1<Packet>(7.11544750618563894466E1);
+  const Packet cst_cephes_log_q4 = pset1<Packet>(2.31251620126765340583E1);
+  const Packet cst_cephes_log_C1 = pset1<Packet>(2.121944400546905827679e-4);
+  const Packet cst_cephes_log_C2 = pset1<Packet>(0.693359375);
+
+  // Scale the positive denormals up to the normal range, pfrexp only handles
+  // normalized numbers.
+  Packet denormal_mask = pandnot(pcmp_lt(x, cst_min_norm_pos), pcmp_le(x, pzero(x)));
+  x = pselect(denormal_mask, pmul(x, cst_2p54), x);
+
+  Packet e;
+  // extract significant in the range [0.5,1) and exponent
+  x = pfrexp(x,e);
+  e = psub(e, pand(cst_54, denormal_mask));
+
+  // Shift the inputs from the range [0.5,1) to [sqrt(1/2),sqrt(2))
+  // and shift by -1, see plog_float.
+  Packet mask = pcmp_lt(x, cst_cephes_SQRTHF);
+  Packet tmp = pand(x, mask);
+  x = psub(x, cst_1);
+  e = psub(e, pand(cst_1, mask));
+  x = padd(x, tmp);
+
+  Packet x2 = pmul(x, x);
+
+  // Evaluate the numerator and the denominator of the rational interpolant.
+  Packet px = cst_cephes_log_p0;
+  px = pmadd(px, x, cst_cephes_log_p1);
+  px = pmadd(px, x, cst_cephes_log_p2);
+  px = pmadd(px, x, cst_cephes_log_p3);
+  px = pmadd(px, x, cst_cephes_log_p4);
+  px = pmadd(px, x, cst_cephes_log_p5);
+
+  Packet qx = padd(x, cst_cephes_log_q0);
+  qx = pmadd(qx, x, cst_cephes_log_q1);
+  qx = pmadd(qx, x, cst_cephes_log_q2);
+  qx = pmadd(qx, x, cst_cephes_log_q3);
+  qx = pmadd(qx, x, cst_cephes_log_q4);
+
+  Packet y = pmul(x, pdiv(pmul(x2, px), qx));
+
+  // Add the logarithm of the exponent back to the result of the interpolation,
+  // log(2) being split in two parts to keep the last digits right.
+  y = psub(y, pmul(e, cst_cephes_log_C1));
+  y = psub(y, pmul(x2, cst_half));
+  x = padd(x, y);
+  x = padd(x, pmul(e, cst_cephes_log_C2));
+
+  Packet invalid_mask = pcmp_lt_or_nan(_x, pzero(_x));
+  Packet iszero_mask  = pcmp_eq(_x,pzero(_x));
+  Packet pos_inf_mask = pcmp_eq(_x,cst_pos_inf);
+  // Filter out invalid inputs, i.e.:
+  //  - negative arg will be NAN
+  //  - 0 will be -INF
+  //  - +INF will be +INF
+  return pselect(iszero_mask, cst_minus_inf,
+                              por(pselect(pos_inf_mask,cst_pos_inf,x), invalid_mask));
+}
+
 // Exponential function. Works by writing "x = m*log(2) + r" where
 // "m = floor(x/log(2)+1/2)" and "r" is the remainder. The result is then
 // "exp(x) = 2^m*exp(r)" where exp(r) is in the range [-1,1).
@@ -467,5 +558,172 @@ Packet pcos_float(const Packet& x)
   return psincos_float<false>(x);
 }
 
+// Sine and cosine in double precision.
+// The argument is reduced to r = x - q*pi/2 in [-pi/4,pi/4] using the three
+// parts of pi/2 of fdlibm, each of which has at most 33 significant bits so
+// that the products q*(pi/2)_i are exact as long as |q| < 2^20. The sine and
+// cosine of r are then approximated by the polynomials of the cephes library
+// and selected according to the quadrant q mod 4. Beyond the range of this
+// reduction, the lanes are evaluated with the scalar std::sin/std::cos.
+template<bool ComputeSine,typename Packet>
+EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+EIGEN_UNUSED
+#if EIGEN_GNUC_AT_LEAST(4,4) && EIGEN_COMP_GNUC_STRICT
+__attribute__((optimize("-fno-unsafe-math-optimizations")))
+#endif
+Packet psincos_double(const Packet& _x)
+{
+// Workaround -ffast-math aggressive optimizations, see psincos_float.
+#if EIGEN_COMP_CLANG && defined(EIGEN_VECTORIZE_SSE)
+#define EIGEN_SINCOS_DONT_OPT(X) __asm__  ("" : "+x" (X));
+#else
+#define EIGEN_SINCOS_DONT_OPT(X)
+#endif
+
+  const Packet cst_2oPI            = pset1<Packet>(0.63661977236758134308); // 2/PI
+  const Packet cst_rounding_magic  = pset1<Packet>(6755399441055744.0); // 1.5*2^52 for rounding
+  const Packet cst_quarter         = pset1<Packet>(0.25);
+  const Packet cst_3o8             = pset1<Packet>(0.375);
+  const Packet cst_1               = pset1<Packet>(1.0);
+  const Packet cst_2               = pset1<Packet>(2.0);
+  const Packet cst_4               = pset1<Packet>(4.0);
+  const Packet cst_half            = pset1<Packet>(0.5);
+  // 2^20*pi/2, the largest argument for which the reduction is accurate.
+  const double huge_th = 1647099.0;
+
+  // Nearest integer q to x*2/pi.
+  Packet q = padd(pmul(_x, cst_2oPI), cst_rounding_magic);
+  EIGEN_SINCOS_DONT_OPT(q)
+  q = psub(q, cst_rounding_magic);
+
+  // Reduce x by q quadrants to get: -Pi/4 <= r <= +Pi/4.
+  Packet r = pmadd(q, pset1<Packet>(-1.57079632673412561417e+00), _x);
+  EIGEN_SINCOS_DONT_OPT(r)
+  r = pmadd(q, pset1<Packet>(-6.07710050630396597660e-11), r);
+  EIGEN_SINCOS_DONT_OPT(r)
+  r = pmadd(q, pset1<Packet>(-2.02226624871116645580e-21), r);
+
+  // For the cosine, cos(x) = sin(x+pi/2) is evaluated in the next quadrant.
+  Packet k = ComputeSine ? q : padd(q, cst_1);
+  // Quadrant k mod 4 in [0,3]: since k is an integer, k/4-3/8 is never a
+  // tie and rounds to floor(k/4).
+  Packet fl = padd(psub(pmul(k, cst_quarter), cst_3o8), cst_rounding_magic);
+  EIGEN_SINCOS_DONT_OPT(fl)
+  fl = psub(fl, cst_rounding_magic);
+  k = psub(k, pmul(fl, cst_4));
+
+  // The sine polynomial is used in the even quadrants, the cosine in the odd
+  // ones, and the result is negated in quadrants 2 and 3.
+  Packet poly_mask = por(pcmp_eq(k, pzero(k)), pcmp_eq(k, cst_2));
+  Packet sign_mask = pcmp_le(cst_2, k);
+
+  Packet r2 = pmul(r, r);
+
+  // Evaluate the cos(r) polynomial. (-Pi/4 <= r <= Pi/4)
+  Packet y1 =        pset1<Packet>(-1.13585365213876817300E-11);
+  y1 = pmadd(y1, r2, pset1<Packet>( 2.08757008419747316778E-9));
+  y1 = pmadd(y1, r2, pset1<Packet>(-2.75573141792967388112E-7));
+  y1 = pmadd(y1, r2, pset1<Packet>( 2.48015872888517045348E-5));
+  y1 = pmadd(y1, r2, pset1<Packet>(-1.38888888888730564116E-3));
+  y1 = pmadd(y1, r2, pset1<Packet>( 4.16666666666665929218E-2));
+  y1 = pmul(pmul(y1, r2), r2);
+  y1 = padd(psub(cst_1, pmul(r2, cst_half)), y1);
+
+  // Evaluate the sin(r) polynomial. (-Pi/4 <= r <= Pi/4)
+  Packet y2 =        pset1<Packet>( 1.58962301576546568060E-10);
+  y2 = pmadd(y2, r2, pset1<Packet>(-2.50507477628578072866E-8));
+  y2 = pmadd(y2, r2, pset1<Packet>( 2.75573136213857245213E-6));
+  y2 = pmadd(y2, r2, pset1<Packet>(-1.98412698295895385996E-4));
+  y2 = pmadd(y2, r2, pset1<Packet>( 8.33333333332211858878E-3));
+  y2 = pmadd(y2, r2, pset1<Packet>(-1.66666666666666307295E-1));
+  y2 = pmul(y2, r2);
+  y2 = pmadd(y2, r, r);
+
+  Packet y = pselect(poly_mask, y2, y1);
+  y = pselect(sign_mask, pnegate(y), y);
+  // Preserve the sign of zero, sin(-0) = -0.
+  if(ComputeSine)
+    y = pselect(pcmp_eq(_x, pzero(_x)), _x, y);
+
+  if(predux_any(pcmp_le(pset1<Packet>(huge_th),pabs(_x))))
+  {
+    const int PacketSize = unpacket_traits<Packet>::size;
+    EIGEN_ALIGN_TO_BOUNDARY(sizeof(Packet)) double vals[PacketSize];
+    EIGEN_ALIGN_TO_BOUNDARY(sizeof(Packet)) double y_cpy[PacketSize];
+    pstoreu(vals, _x);
+    pstoreu(y_cpy, y);
+    for(int i=0; i<PacketSize; ++i)
+    {
+      double val = vals[i];
+      if(numext::abs(val)>=huge_th && (numext::isfinite)(val))
+        y_cpy[i] = ComputeSine ? std::sin(val) : std::cos(val);
+    }
+    y = ploadu<Packet>(y_cpy);
+  }
+
+  return y;
+
+#undef EIGEN_SINCOS_DONT_OPT
+}
+
+template<typename Packet>
+EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+EIGEN_UNUSED
+Packet psin_double(const Packet& x)
+{
+  return psincos_double<true>(x);
+}
+
+template<typename Packet>
+EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+EIGEN_UNUSED
+Packet pcos_double(const Packet& x)
+{
+  return psincos_double<false>(x);
+}
+
+// Hyperbolic tangent in double precision.
+// For |x| < 0.625, tanh(x) = x + x^3 P(x^2)/Q(x^2) with the rational function
+// of the cephes library. Beyond, tanh(|x|) = 1 - 2/(exp(2|x|)+1) has no
+// cancellation issue, and saturates to 1 for |x| > 22.
+template<typename Packet>
+EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS
+EIGEN_UNUSED
+Packet ptanh_double(const Packet& _x)
+{
+  const Packet cst_1  = pset1<Packet>(1.0);
+  const Packet cst_2  = pset1<Packet>(2.0);
+  const Packet cst_small = pset1<Packet>(0.625);
+  const Packet cst_clamp = pset1<Packet>(22.0);
+
+  const Packet cst_cephes_tanh_p0 = pset1<Packet>(-9.64399179425052238628E-1);
+  const Packet cst_cephes_tanh_p1 = pset1<Packet>(-9.92877231001918586564E1);
+  const Packet cst_cephes_tanh_p2 = pset1<Packet>(-1.61468768441708447952E3);
+  const Packet cst_cephes_tanh_q0 = pset1<Packet>(1.12811678491632931402E2);
+  const Packet cst_cephes_tanh_q1 = pset1<Packet>(2.23548839060100448583E3);
+  const Packet cst_cephes_tanh_q2 = pset1<Packet>(4.84406305325125486048E3);
+
+  Packet x_abs = pabs(_x);
+
+  // Small arguments.
+  Packet z = pmul(_x, _x);
+  Packet pz = cst_cephes_tanh_p0;
+  pz = pmadd(pz, z, cst_cephes_tanh_p1);
+  pz = pmadd(pz, z, cst_cephes_tanh_p2);
+  Packet qz = padd(z, cst_cephes_tanh_q0);
+  qz = pmadd(qz, z, cst_cephes_tanh_q1);
+  qz = pmadd(qz, z, cst_cephes_tanh_q2);
+  Packet y_small = pmadd(pmul(_x, z), pdiv(pz, qz), _x);
+
+  // Large arguments.
+  Packet s = pexp(pmul(cst_2, pmin(x_abs, cst_clamp)));
+  Packet y_large = psub(cst_1, pdiv(cst_2, padd(s, cst_1)));
+  y_large = pselect(pcmp_lt(_x, pzero(_x)), pnegate(y_large), y_large);
+
+  Packet y = pselect(pcmp_lt(x_abs, cst_small), y_small, y_large);
+  // Propagate NaNs.
+  return pselect(pcmp_eq(_x, _x), y, _x);
+}
+
 } // end namespace internal
 } // end namespace Eigen
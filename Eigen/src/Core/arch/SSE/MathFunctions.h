@@ -27,6 +27,12 @@ Packet4f plog<Packet4f>(const Packet4f& _x)
   return plog_float(_x);
 }
 
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet2d plog<Packet2d>(const Packet2d& _x)
+{
+  return plog_double(_x);
+}
+
 template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
 Packet4f pexp<Packet4f>(const Packet4f& _x)
 {
@@ -51,6 +57,18 @@ Packet4f pcos<Packet4f>(const Packet4f& _x)
   return pcos_float(_x);
 }
 
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet2d psin<Packet2d>(const Packet2d& _x)
+{
+  return psin_double(_x);
+}
+
+template<> EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED
+Packet2d pcos<Packet2d>(const Packet2d& _x)
+{
+  return pcos_double(_x);
+}
+
 #if EIGEN_FAST_MATH
 
 // Functions for sqrt.
@@ -140,6 +158,12 @@ ptanh<Packet4f>(const Packet4f& x) {
   return internal::generic_fast_tanh_float(x);
 }
 
+template <>
+EIGEN_DEFINE_FUNCTION_ALLOWING_MULTIPLE_DEFINITIONS EIGEN_UNUSED Packet2d
+ptanh<Packet2d>(const Packet2d& x) {
+  return internal::ptanh_double(x);
+}
+
 } // end namespace internal
 
 namespace numext {
@@ -135,9 +135,13 @@ template<> struct packet_traits<double> : default_packet_traits
     HasHalfPacket = 0,
 
     HasDiv  = 1,
+    HasSin  = EIGEN_FAST_MATH,
+    HasCos  = EIGEN_FAST_MATH,
+    HasLog  = 1,
     HasExp  = 1,
     HasSqrt = 1,
     HasRsqrt = 1,
+    HasTanh = EIGEN_FAST_MATH,
     HasBlend = 1
 
 #ifdef EIGEN_VECTORIZE_SSE4_1
@@ -377,6 +381,9 @@ template<> EIGEN_STRONG_INLINE Packet4f pcmp_eq(const Packet4f& a, const Packet4
 template<> EIGEN_STRONG_INLINE Packet4i pcmp_eq(const Packet4i& a, const Packet4i& b) { return _mm_cmpeq_epi32(a,b); }
 template<> EIGEN_STRONG_INLINE Packet2d pcmp_eq(const Packet2d& a, const Packet2d& b) { return _mm_cmpeq_pd(a,b); }
 template<> EIGEN_STRONG_INLINE Packet4f pcmp_lt_or_nan(const Packet4f& a, const Packet4f& b) { return _mm_cmpnge_ps(a,b); }
+template<> EIGEN_STRONG_INLINE Packet2d pcmp_le(const Packet2d& a, const Packet2d& b) { return _mm_cmple_pd(a,b); }
+template<> EIGEN_STRONG_INLINE Packet2d pcmp_lt(const Packet2d& a, const Packet2d& b) { return _mm_cmplt_pd(a,b); }
+template<> EIGEN_STRONG_INLINE Packet2d pcmp_lt_or_nan(const Packet2d& a, const Packet2d& b) { return _mm_cmpnge_pd(a,b); }
 
 template<> EIGEN_STRONG_INLINE Packet4i ptrue<Packet4i>(const Packet4i& a) { return _mm_cmpeq_epi32(a, a); }
 template<> EIGEN_STRONG_INLINE Packet4f
@@ -614,6 +621,16 @@ template<> EIGEN_STRONG_INLINE Packet4f pldexp<Packet4f>(const Packet4f& a, cons
   return pldexp_float(a,exponent);
 }
 
+template<> EIGEN_STRONG_INLINE Packet2d pfrexp<Packet2d>(const Packet2d& a, Packet2d& exponent) {
+  // Extract the biased exponents and convert them from the low 32 bits of each 64-bit lane.
+  const Packet2d cst_exp_mask = _mm_castsi128_pd(_mm_setr_epi32(0, 0x7ff00000, 0, 0x7ff00000));
+  const Packet2d cst_half = pset1<Packet2d>(0.5);
+  Packet4i emm0 = _mm_srli_epi64(_mm_castpd_si128(pand(a, cst_exp_mask)), 52);
+  emm0 = _mm_shuffle_epi32(emm0, _MM_SHUFFLE(3,1,2,0));
+  exponent = psub(_mm_cvtepi32_pd(emm0), pset1<Packet2d>(1022.0));
+  return por(pandnot(a, cst_exp_mask), cst_half);
+}
+
 template<> EIGEN_STRONG_INLINE Packet2d pldexp<Packet2d>(const Packet2d& a, const Packet2d& exponent) {
   const Packet4i cst_1023_0 = _mm_setr_epi32(1023, 1023, 0, 0);
   Packet4i emm0 = _mm_cvttpd_epi32(exponent);
@@ -835,6 +852,11 @@ template<> EIGEN_STRONG_INLINE bool predux_any(const Packet4f& x)
   return _mm_movemask_ps(x) != 0x0;
 }
 
+template<> EIGEN_STRONG_INLINE bool predux_any(const Packet2d& x)
+{
+  return _mm_movemask_pd(x) != 0x0;
+}
+
 #if EIGEN_COMP_GNUC
 // template <> EIGEN_STRONG_INLINE Packet4f pmadd(const Packet4f&  a, const Packet4f&  b, const Packet4f&  c)
 // {
@@ -13,6 +13,92 @@
 
 namespace Eigen {
 
+/** \class GemmBlockingProvider
+  * \ingroup Core_Module
+  *
+  * \brief Abstract interface to override the blocking sizes of the matrix products
+  *
+  * By default, the blocking sizes kc, mc and nc of the matrix products are derived from the cache sizes
+  * (see setCpuCacheSizes()). Applications can implement this interface and register it with
+  * setGemmBlockingProvider() to use other blocking sizes, for instance sizes measured on the target
+  * machine. The unsupported BlockingTuner module provides such an implementation (see GemmBlockingTable).
+  *
+  * The provider is only consulted for the products of real and complex float and double matrices.
+  * The blocking sizes it returns are clamped to the dimensions of the product and rounded to the
+  * register blocking of the product kernel.
+  *
+  * \sa setGemmBlockingProvider(), gemmBlockingProvider()
+  */
+class GemmBlockingProvider
+{
+  public:
+    /** \brief The scalar types for which the blocking sizes can be provided */
+    enum ScalarType { Float = 1, Double, ComplexFloat, ComplexDouble };
+
+    virtual ~GemmBlockingProvider() {}
+
+    /** Looks up the blocking sizes of a \a m x \a k times \a k x \a n product of \a lhs by \a rhs
+      * matrices evaluated by \a num_threads threads.
+      *
+      * \returns true and sets \a kc, \a mc and \a nc if blocking sizes are available for this
+      * product, and false to fall back to the default heuristic. */
+    virtual bool blockingSizes(ScalarType lhs, ScalarType rhs, Index k, Index m, Index n, Index num_threads,
+                               Index& kc, Index& mc, Index& nc) = 0;
+};
+
+namespace internal {
+
+/** \internal */
+inline void manage_gemm_blocking_provider(Action action, GemmBlockingProvider** provider)
+{
+  static GemmBlockingProvider* m_provider = 0;
+
+  if(action==SetAction)
+  {
+    eigen_internal_assert(provider!=0);
+    m_provider = *provider;
+  }
+  else if(action==GetAction)
+  {
+    eigen_internal_assert(provider!=0);
+    *provider = m_provider;
+  }
+  else
+  {
+    eigen_internal_assert(false);
+  }
+}
+
+/** \internal \returns the GemmBlockingProvider::ScalarType of \a T, or 0 if the blocking sizes of \a T cannot be provided */
+template<typename T> struct gemm_blocking_scalar_type { enum { value = 0 }; };
+template<> struct gemm_blocking_scalar_type<float> { enum { value = GemmBlockingProvider::Float }; };
+template<> struct gemm_blocking_scalar_type<double> { enum { value = GemmBlockingProvider::Double }; };
+template<> struct gemm_blocking_scalar_type<std::complex<float> > { enum { value = GemmBlockingProvider::ComplexFloat }; };
+template<> struct gemm_blocking_scalar_type<std::complex<double> > { enum { value = GemmBlockingProvider::ComplexDouble }; };
+
+} // end namespace internal
+
+/** Registers \a provider to compute the blocking sizes of the matrix products, or restores the default
+  * heuristic if \a provider is null.
+  *
+  * The provider is not owned by Eigen and must outlive all the products evaluated while it is registered.
+  * This function is not thread safe and should be called before any product is evaluated.
+  *
+  * \sa GemmBlockingProvider, gemmBlockingProvider(), setCpuCacheSizes() */
+inline void setGemmBlockingProvider(GemmBlockingProvider* provider)
+{
+  internal::manage_gemm_blocking_provider(SetAction, &provider);
+}
+
+/** \returns the provider registered by setGemmBlockingProvider(), or a null pointer
+  * \sa setGemmBlockingProvider() */
+inline GemmBlockingProvider* gemmBlockingProvider()
+{
+  GemmBlockingProvider* ret;
+  internal::manage_gemm_blocking_provider(GetAction, &ret);
+  return ret;
+}
+
 namespace internal {
 
 enum PacketSizeType {
@@ -293,6 +379,36 @@ inline bool useSpecificBlockingSizes(Index& k, Index& m, Index& n)
   return false;
 }
 
+template<typename LhsScalar, typename RhsScalar, int KcFactor, typename Index>
+inline bool useProvidedBlockingSizes(Index& k, Index& m, Index& n, Index num_threads)
+{
+  enum {
+    LhsType = gemm_blocking_scalar_type<LhsScalar>::value,
+    RhsType = gemm_blocking_scalar_type<RhsScalar>::value
+  };
+  // Only the blockings of the plain products can be provided.
+  if(KcFactor!=1 || LhsType==0 || RhsType==0)
+    return false;
+
+  GemmBlockingProvider* provider;
+  manage_gemm_blocking_provider(GetAction, &provider);
+  if(provider==0)
+    return false;
+
+  Eigen::Index kc, mc, nc;
+  if(!provider->blockingSizes(GemmBlockingProvider::ScalarType(LhsType), GemmBlockingProvider::ScalarType(RhsType),
+                              k, m, n, num_threads, kc, mc, nc))
+    return false;
+
+  typedef gebp_traits<LhsScalar,RhsScalar> Traits;
+  k = numext::mini<Index>(k, numext::maxi<Index>(1, Index(kc)));
+  m = numext::mini<Index>(m, numext::maxi<Index>(1, Index(mc)));
+  n = numext::mini<Index>(n, numext::maxi<Index>(1, Index(nc)));
+  if (m > Traits::mr) m -= m % Traits::mr;
+  if (n > Traits::nr) n -= n % Traits::nr;
+  return true;
+}
+
 /** \brief Computes the blocking parameters for a m x k times k x n matrix product
   *
   * \param[in,out] k Input: the third dimension of the product. Output: the blocking size along the same dimension.
@@ -305,14 +421,15 @@ inline bool useSpecificBlockingSizes(Index& k, Index& m, Index& n)
   *
   * The blocking size parameters may be evaluated:
   *   - either by a heuristic based on cache sizes;
+  *   - or by the GemmBlockingProvider registered with setGemmBlockingProvider();
   *   - or using fixed prescribed values (for testing purposes).
   *
-  * \sa setCpuCacheSizes */
+  * \sa setCpuCacheSizes, setGemmBlockingProvider */
 
 template<typename LhsScalar, typename RhsScalar, int KcFactor, typename Index>
 void computeProductBlockingSizes(Index& k, Index& m, Index& n, Index num_threads = 1)
 {
-  if (!useSpecificBlockingSizes(k, m, n)) {
+  if (!useSpecificBlockingSizes(k, m, n) && !useProvidedBlockingSizes<LhsScalar,RhsScalar,KcFactor>(k, m, n, num_threads)) {
     evaluateProductBlockingSizesHeuristic<LhsScalar, RhsScalar, KcFactor, Index>(k, m, n, num_threads);
   }
 }
@@ -0,0 +1,186 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_GENERAL_MATRIX_MATRIX_BFLOAT16_H
+#define EIGEN_GENERAL_MATRIX_MATRIX_BFLOAT16_H
+
+namespace Eigen {
+
+namespace internal {
+
+/**********************************************************************
+* This file implements the matrix-matrix products of bfloat16 matrices
+* via partial specialization of general_matrix_matrix_product::run(..).
+*
+* With only 8 bits of precision, accumulating the products in bfloat16
+* quickly loses all accuracy. Instead, the blocks of the operands are
+* converted to fp32 when they are packed, and the fp32 kernel accumulates
+* into an fp32 copy of the result, which is rounded back to bfloat16 once
+* the whole depth has been processed. The operands are thus read from
+* memory in bfloat16, while the arithmetic runs at the speed of the float
+* kernel.
+**********************************************************************/
+
+template<
+  typename Index,
+  int LhsStorageOrder, bool ConjugateLhs,
+  int RhsStorageOrder, bool ConjugateRhs>
+struct general_matrix_matrix_product<Index,bfloat16,LhsStorageOrder,ConjugateLhs,bfloat16,RhsStorageOrder,ConjugateRhs,ColMajor>
+{
+typedef gebp_traits<float,float> Traits;
+
+typedef bfloat16 ResScalar;
+typedef Map<const Matrix<bfloat16,Dynamic,Dynamic,LhsStorageOrder>, 0, OuterStride<> > LhsMap;
+typedef Map<const Matrix<bfloat16,Dynamic,Dynamic,RhsStorageOrder>, 0, OuterStride<> > RhsMap;
+typedef Map<Matrix<bfloat16,Dynamic,Dynamic,ColMajor>, 0, OuterStride<> > ResMap;
+typedef Map<Matrix<float,Dynamic,Dynamic,ColMajor> > FloatMap;
+typedef const_blas_data_mapper<float, Index, ColMajor> FloatMapper;
+typedef blas_data_mapper<float, Index, ColMajor> AccMapper;
+
+// Converts the block (i,k,m,kc) of lhs to fp32 into tmp, and packs it into blockA.
+static void pack_lhs(float* blockA, float* tmp, const LhsMap& lhs, Index i, Index k, Index m, Index kc)
+{
+  gemm_pack_lhs<float, Index, FloatMapper, Traits::mr, Traits::LhsProgress, typename Traits::LhsPacket4Packing, ColMajor> pack;
+  FloatMap(tmp, m, kc) = lhs.block(i, k, m, kc).template cast<float>();
+  pack(blockA, FloatMapper(tmp, m), kc, m);
+}
+
+// Converts the block (k,j,kc,n) of rhs to fp32 into tmp, and packs it into blockB.
+static void pack_rhs(float* blockB, float* tmp, const RhsMap& rhs, Index k, Index j, Index kc, Index n)
+{
+  gemm_pack_rhs<float, Index, FloatMapper, Traits::nr, ColMajor> pack;
+  FloatMap(tmp, kc, n) = rhs.block(k, j, kc, n).template cast<float>();
+  pack(blockB, FloatMapper(tmp, kc), kc, n);
+}
+
+static void run(Index rows, Index cols, Index depth,
+  const bfloat16* _lhs, Index lhsStride,
+  const bfloat16* _rhs, Index rhsStride,
+  bfloat16* _res, Index resStride,
+  bfloat16 alpha,
+  level3_blocking<bfloat16,bfloat16>& blocking,
+  GemmParallelInfo<Index>* info = 0)
+{
+  LhsMap lhs(_lhs, rows, depth, OuterStride<>(lhsStride));
+  RhsMap rhs(_rhs, depth, cols, OuterStride<>(rhsStride));
+  ResMap res(_res, rows, cols, OuterStride<>(resStride));
+  gebp_kernel<float, float, Index, AccMapper, Traits::mr, Traits::nr, false, false> gebp;
+  const float actualAlpha = static_cast<float>(alpha);
+
+  // fp32 copy of the result, in which the products are accumulated
+  ei_declare_aligned_stack_constructed_variable(float, acc, rows*cols, 0);
+  FloatMap(acc, rows, cols) = res.template cast<float>();
+  AccMapper accMapper(acc, rows);
+
+#if defined(EIGEN_HAS_OPENMP) || EIGEN_HAS_CXX11_ATOMIC
+  // The shared packed lhs is stored in fp32 within the space reserved for the bfloat16 one,
+  // whence a depth of the blocks twice smaller.
+  const Index sharedKc = blocking.kc()/2;
+  if(info && sharedKc>0)
+  {
+    // Same as the parallel version of the generic product, see GeneralMatrixMatrix.h.
+    int tid = int(info->logical_thread_id);
+    int threads = int(info->num_threads);
+    GemmParallelTaskInfo<Index>* task_info = info->task_info;
+    const Index kc = sharedKc;
+    const Index nc = (std::min)(cols,blocking.nc());
+
+    float* blockA = reinterpret_cast<float*>(blocking.blockA());
+    eigen_internal_assert(blockA!=0);
+
+    ei_declare_aligned_stack_constructed_variable(float, blockB, kc*nc, 0);
+    ei_declare_aligned_stack_constructed_variable(float, rhsTmp, kc*nc, 0);
+    ei_declare_aligned_stack_constructed_variable(float, lhsTmp, task_info[tid].lhs_length*kc, 0);
+
+    for(Index k=0; k<depth; k+=kc)
+    {
+      const Index actual_kc = (std::min)(k+kc,depth)-k;
+
+      pack_rhs(blockB, rhsTmp, rhs, k, 0, actual_kc, nc);
+
+      while(task_info[tid].users!=0) {}
+      task_info[tid].users = threads;
+
+      pack_lhs(blockA+task_info[tid].lhs_start*actual_kc, lhsTmp, lhs, task_info[tid].lhs_start, k, task_info[tid].lhs_length, actual_kc);
+
+      task_info[tid].sync = k;
+
+      for(int shift=0; shift<threads; ++shift)
+      {
+        int i = (tid+shift)%threads;
+        if (shift>0) {
+          while(task_info[i].sync!=k) {
+          }
+        }
+
+        gebp(accMapper.getSubMapper(task_info[i].lhs_start, 0), blockA+task_info[i].lhs_start*actual_kc, blockB,
+             task_info[i].lhs_length, actual_kc, nc, actualAlpha);
+      }
+
+      for(Index j=nc; j<cols; j+=nc)
+      {
+        const Index actual_nc = (std::min)(j+nc,cols)-j;
+        pack_rhs(blockB, rhsTmp, rhs, k, j, actual_kc, actual_nc);
+        gebp(accMapper.getSubMapper(0, j), blockA, blockB, rows, actual_kc, actual_nc, actualAlpha);
+      }
+
+      for(Index i=0; i<threads; ++i)
+#if !EIGEN_HAS_CXX11_ATOMIC
+        #pragma omp atomic
+#endif
+        task_info[i].users -= 1;
+    }
+  }
+  else
+#endif // EIGEN_HAS_OPENMP || EIGEN_HAS_CXX11_ATOMIC
+  {
+    // This thread computes its own block of the result, so that the fp32 blocking is used.
+    EIGEN_UNUSED_VARIABLE(blocking);
+    EIGEN_UNUSED_VARIABLE(info);
+    Index kc = depth, mc = rows, nc = cols;
+    computeProductBlockingSizes<float,float>(kc, mc, nc);
+    mc = (std::min)(rows,mc);
+    nc = (std::min)(cols,nc);
+
+    ei_declare_aligned_stack_constructed_variable(float, lhsTmp, mc*kc, 0);
+    ei_declare_aligned_stack_constructed_variable(float, rhsTmp, kc*nc, 0);
+    ei_declare_aligned_stack_constructed_variable(float, blockA, mc*kc, 0);
+    ei_declare_aligned_stack_constructed_variable(float, blockB, kc*nc, 0);
+
+    // Each block of the rhs is converted and packed once, and the lhs is only converted again
+    // for each of the cols/nc blocks of columns, which are few in practice.
+    const bool pack_lhs_once = mc==rows;
+    for(Index k2=0; k2<depth; k2+=kc)
+    {
+      const Index actual_kc = (std::min)(k2+kc,depth)-k2;
+
+      for(Index j2=0; j2<cols; j2+=nc)
+      {
+        const Index actual_nc = (std::min)(j2+nc,cols)-j2;
+        pack_rhs(blockB, rhsTmp, rhs, k2, j2, actual_kc, actual_nc);
+
+        for(Index i2=0; i2<rows; i2+=mc)
+        {
+          const Index actual_mc = (std::min)(i2+mc,rows)-i2;
+          if((!pack_lhs_once) || j2==0)
+            pack_lhs(blockA, lhsTmp, lhs, i2, k2, actual_mc, actual_kc);
+
+          gebp(accMapper.getSubMapper(i2, j2), blockA, blockB, actual_mc, actual_kc, actual_nc, actualAlpha);
+        }
+      }
+    }
+  }
+
+  res = FloatMap(acc, rows, cols).template cast<bfloat16>();
+}
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_GENERAL_MATRIX_MATRIX_BFLOAT16_H
@@ -398,6 +398,58 @@ EIGEN_DEVICE_FUNC EIGEN_DONT_INLINE void general_matrix_vector_product<Index,Lhs
   }
 }
 
+// Calls the sequential kernel on the horizontal panel [start,start+length) of the lhs.
+template<typename Kernel, typename Index, typename LhsMapper, typename RhsMapper, typename ResScalar, typename AlphaScalar>
+struct general_matrix_vector_product_range_functor
+{
+  general_matrix_vector_product_range_functor(Index cols, const LhsMapper& lhs, const RhsMapper& rhs,
+                                              ResScalar* res, Index resIncr, const AlphaScalar& alpha)
+    : m_cols(cols), m_lhs(lhs), m_rhs(rhs), m_res(res), m_resIncr(resIncr), m_alpha(alpha)
+  {}
+
+  void operator()(Index start, Index length) const
+  {
+    Kernel::run(length, m_cols, m_lhs.getSubMapper(start,0), m_rhs, m_res+start*m_resIncr, m_resIncr, m_alpha);
+  }
+
+  protected:
+    Index m_cols;
+    const LhsMapper& m_lhs;
+    const RhsMapper& m_rhs;
+    ResScalar* m_res;
+    Index m_resIncr;
+    AlphaScalar m_alpha;
+};
+
+/* Multi-threaded matrix * vector product:
+ * The rows of the result are split among the threads reserved for Eigen (see setNbThreads),
+ * each of them running the above sequential kernels on its own horizontal panel of the lhs.
+ * This way the product runs at the memory bandwidth of several cores for large matrices,
+ * while small products are directly forwarded to the sequential kernels.
+ */
+template<typename Index, typename LhsScalar, typename LhsMapper, int LhsStorageOrder, bool ConjugateLhs,
+         typename RhsScalar, typename RhsMapper, bool ConjugateRhs, bool Parallelizable>
+struct parallel_general_matrix_vector_product
+{
+  typedef general_matrix_vector_product<Index,LhsScalar,LhsMapper,LhsStorageOrder,ConjugateLhs,RhsScalar,RhsMapper,ConjugateRhs> Kernel;
+  typedef typename Kernel::ResScalar ResScalar;
+
+  template<typename AlphaScalar>
+  static void run(Index rows, Index cols, const LhsMapper& lhs, const RhsMapper& rhs,
+                  ResScalar* res, Index resIncr, const AlphaScalar& alpha)
+  {
+#ifdef EIGEN_USE_BLAS
+    // as for GEMM, let the BLAS deal with multi-threading
+    Kernel::run(rows, cols, lhs, rhs, res, resIncr, alpha);
+#else
+    typedef general_matrix_vector_product_range_functor<Kernel,Index,LhsMapper,RhsMapper,ResScalar,AlphaScalar> RangeFunctor;
+    double work = static_cast<double>(rows) * static_cast<double>(cols);
+    parallelize_range<Parallelizable>(RangeFunctor(cols, lhs, rhs, res, resIncr, alpha),
+                                      rows, Index(4*packet_traits<ResScalar>::size), work);
+#endif
+  }
+};
+
 } // end namespace internal
 
 } // end namespace Eigen
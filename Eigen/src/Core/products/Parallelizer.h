@@ -16,8 +16,78 @@
 
 namespace Eigen {
 
+/** \class GemmExecutor
+  * \ingroup Core_Module
+  *
+  * \brief Abstract interface to run the multi-threaded matrix products on user managed threads
+  *
+  * By default, large matrix products are only parallelized through OpenMP. Applications managing their own
+  * threads can implement this interface and register it with setGemmExecutor() to get multi-threaded
+  * products without OpenMP. The unsupported CXX11 ThreadPool module provides such an implementation
+  * on top of any ThreadPoolInterface (see ThreadPoolGemmExecutor).
+  *
+  * The tasks of a parallel GEMM wait for each other while packing the shared blocks of the lhs. Therefore
+  * run() must execute all the tasks concurrently, and numThreads() must not exceed the number of tasks which
+  * can be in flight at the same time, including the calling thread.
+  *
+  * Some parallel algorithms evaluate products within their tasks. Such nested products must not call run()
+  * again from a thread of the executor, which could dead-lock or oversubscribe the threads. Therefore
+  * isWorkerThread() must return true on all the threads on which run() may execute the tasks, except the
+  * thread calling run().
+  *
+  * The executor is only used when C++11 atomics are available (see EIGEN_HAS_CXX11_ATOMIC), and it takes
+  * precedence over OpenMP when both are available.
+  *
+  * \sa setGemmExecutor(), gemmExecutor(), setNbThreads()
+  */
+class GemmExecutor
+{
+  public:
+    /** \brief A piece of work submitted to GemmExecutor::run() */
+    class Task
+    {
+      public:
+        virtual ~Task() {}
+        /** Performs the \a i-th part of the work */
+        virtual void operator()(int i) const = 0;
+    };
+
+    virtual ~GemmExecutor() {}
+
+    /** \returns the maximal number of tasks which can run concurrently, including the calling thread */
+    virtual int numThreads() const = 0;
+
+    /** \returns whether the calling thread is one of the threads running the tasks of this executor, in which
+      * case the products are evaluated sequentially to avoid dead-locks. */
+    virtual bool isWorkerThread() const = 0;
+
+    /** Runs \c task(0), ..., \c task(n-1) concurrently, and returns once all of them completed. */
+    virtual void run(int n, const Task& task) = 0;
+};
+
 namespace internal {
 
+/** \internal */
+inline void manage_gemm_executor(Action action, GemmExecutor** executor)
+{
+  static GemmExecutor* m_executor = 0;
+
+  if(action==SetAction)
+  {
+    eigen_internal_assert(executor!=0);
+    m_executor = *executor;
+  }
+  else if(action==GetAction)
+  {
+    eigen_internal_assert(executor!=0);
+    *executor = m_executor;
+  }
+  else
+  {
+    eigen_internal_assert(false);
+  }
+}
+
 /** \internal */
 inline void manage_multi_threading(Action action, int* v)
 {
@@ -32,6 +102,16 @@ inline void manage_multi_threading(Action action, int* v)
   else if(action==GetAction)
   {
     eigen_internal_assert(v!=0);
+    #if EIGEN_HAS_CXX11_ATOMIC
+    GemmExecutor* executor;
+    manage_gemm_executor(GetAction, &executor);
+    if(executor)
+    {
+      // never request more concurrent tasks than what the executor can run
+      *v = m_maxThreads>0 ? (std::min)(m_maxThreads, executor->numThreads()) : executor->numThreads();
+      return;
+    }
+    #endif
     #ifdef EIGEN_HAS_OPENMP
     if(m_maxThreads>0)
       *v = m_maxThreads;
@@ -74,11 +154,32 @@ inline void setNbThreads(int v)
   internal::manage_multi_threading(SetAction, &v);
 }
 
+/** Registers \a executor to run the multi-threaded matrix products, or restores the default
+  * OpenMP based parallelization if \a executor is null.
+  *
+  * The executor is not owned by Eigen and must outlive all the products evaluated while it is registered.
+  * This function is not thread safe and should be called before any parallel product is evaluated.
+  *
+  * \sa GemmExecutor, gemmExecutor(), nbThreads() */
+inline void setGemmExecutor(GemmExecutor* executor)
+{
+  internal::manage_gemm_executor(SetAction, &executor);
+}
+
+/** \returns the executor registered by setGemmExecutor(), or a null pointer
+  * \sa setGemmExecutor() */
+inline GemmExecutor* gemmExecutor()
+{
+  GemmExecutor* ret;
+  internal::manage_gemm_executor(GetAction, &ret);
+  return ret;
+}
+
 namespace internal {
 
-template<typename Index> struct GemmParallelInfo
+template<typename Index> struct GemmParallelTaskInfo
 {
-  GemmParallelInfo() : sync(-1), users(0), lhs_start(0), lhs_length(0) {}
+  GemmParallelTaskInfo() : sync(-1), users(0), lhs_start(0), lhs_length(0) {}
 
   // volatile is not enough on all architectures (see bug 1572)
   // to guarantee that when thread A says to thread B that it is
@@ -96,6 +197,83 @@ template<typename Index> struct GemmParallelInfo
   Index lhs_length;
 };
 
+// Everything a thread of a parallel GEMM needs to know about the other threads.
+template<typename Index> struct GemmParallelInfo
+{
+  GemmParallelInfo(Index logical_thread_id_, Index num_threads_, GemmParallelTaskInfo<Index>* task_info_)
+    : logical_thread_id(logical_thread_id_), num_threads(num_threads_), task_info(task_info_)
+  {}
+
+  Index logical_thread_id;
+  Index num_threads;
+  GemmParallelTaskInfo<Index>* task_info;
+};
+
+/** \internal \returns the executor to use for a parallel region, or null if OpenMP should be used */
+inline GemmExecutor* parallel_executor()
+{
+#if EIGEN_HAS_CXX11_ATOMIC
+  return gemmExecutor();
+#else
+  return 0;
+#endif
+}
+
+/** \internal \returns whether we are already running inside a parallel region */
+inline bool in_parallel_region(GemmExecutor* executor)
+{
+  bool nested = executor && executor->isWorkerThread();
+#ifdef EIGEN_HAS_OPENMP
+  // FIXME omp_get_num_threads()>1 only works for openmp, what if the user does not use openmp?
+  nested = nested || omp_get_num_threads()>1;
+#endif
+  return nested;
+}
+
+// Computes the share of the thread i among the actual_threads threads of a parallel GEMM.
+template<typename Functor, typename Index>
+void parallelize_gemm_task(const Functor& func, Index i, Index actual_threads, Index rows, Index cols, bool transpose,
+                           GemmParallelTaskInfo<Index>* task_info)
+{
+  Index blockCols = (cols / actual_threads) & ~Index(0x3);
+  Index blockRows = (rows / actual_threads);
+  blockRows = (blockRows/Functor::Traits::mr)*Functor::Traits::mr;
+
+  Index r0 = i*blockRows;
+  Index actualBlockRows = (i+1==actual_threads) ? rows-r0 : blockRows;
+
+  Index c0 = i*blockCols;
+  Index actualBlockCols = (i+1==actual_threads) ? cols-c0 : blockCols;
+
+  task_info[i].lhs_start = r0;
+  task_info[i].lhs_length = actualBlockRows;
+
+  GemmParallelInfo<Index> info(i, actual_threads, task_info);
+  if(transpose) func(c0, actualBlockCols, 0, rows, &info);
+  else          func(0, rows, c0, actualBlockCols, &info);
+}
+
+template<typename Functor, typename Index>
+class parallelize_gemm_executor_task : public GemmExecutor::Task
+{
+  public:
+    parallelize_gemm_executor_task(const Functor& func, Index threads, Index rows, Index cols, bool transpose,
+                                   GemmParallelTaskInfo<Index>* task_info)
+      : m_func(func), m_threads(threads), m_rows(rows), m_cols(cols), m_transpose(transpose), m_task_info(task_info)
+    {}
+
+    virtual void operator()(int i) const
+    {
+      parallelize_gemm_task(m_func, Index(i), m_threads, m_rows, m_cols, m_transpose, m_task_info);
+    }
+
+  protected:
+    const Functor& m_func;
+    Index m_threads, m_rows, m_cols;
+    bool m_transpose;
+    GemmParallelTaskInfo<Index>* m_task_info;
+};
+
 template<bool Condition, typename Functor, typename Index>
 void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth, bool transpose)
 {
@@ -104,7 +282,7 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   // Without C++11, we have to disable GEMM's parallelization on
   // non x86 architectures because there volatile is not enough for our purpose.
   // See bug 1572.
-#if (! defined(EIGEN_HAS_OPENMP)) || defined(EIGEN_USE_BLAS) || ((!EIGEN_HAS_CXX11_ATOMIC) && !(EIGEN_ARCH_i386_OR_x86_64))
+#if ((! defined(EIGEN_HAS_OPENMP)) && (!EIGEN_HAS_CXX11_ATOMIC)) || defined(EIGEN_USE_BLAS) || ((!EIGEN_HAS_CXX11_ATOMIC) && !(EIGEN_ARCH_i386_OR_x86_64))
   // FIXME the transpose variable is only needed to properly split
   // the matrix product when multithreading is enabled. This is a temporary
   // fix to support row-major destination matrices. This whole
@@ -114,7 +292,7 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   func(0,rows, 0,cols);
 #else
 
-  // Dynamically check whether we should enable or disable OpenMP.
+  // Dynamically check whether we should enable or disable multi-threading.
   // The conditions are:
   // - the max number of threads we can create is greater than 1
   // - we are not already in a parallel code
@@ -136,8 +314,8 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
 
   // if multi-threading is explicitly disabled, not useful, or if we already are in a parallel session,
   // then abort multi-threading
-  // FIXME omp_get_num_threads()>1 only works for openmp, what if the user does not use openmp?
-  if((!Condition) || (threads==1) || (omp_get_num_threads()>1))
+  GemmExecutor* executor = parallel_executor();
+  if((!Condition) || (threads==1) || in_parallel_region(executor))
     return func(0,rows, 0,cols);
 
   Eigen::initParallel();
@@ -146,30 +324,176 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   if(transpose)
     std::swap(rows,cols);
 
-  ei_declare_aligned_stack_constructed_variable(GemmParallelInfo<Index>,info,threads,0);
+  ei_declare_aligned_stack_constructed_variable(GemmParallelTaskInfo<Index>,task_info,threads,0);
+
+  if(executor)
+  {
+    executor->run(int(threads), parallelize_gemm_executor_task<Functor,Index>(func, threads, rows, cols, transpose, task_info));
+    return;
+  }
 
+#ifdef EIGEN_HAS_OPENMP
   #pragma omp parallel num_threads(threads)
   {
     Index i = omp_get_thread_num();
     // Note that the actual number of threads might be lower than the number of request ones.
     Index actual_threads = omp_get_num_threads();
 
-    Index blockCols = (cols / actual_threads) & ~Index(0x3);
-    Index blockRows = (rows / actual_threads);
-    blockRows = (blockRows/Functor::Traits::mr)*Functor::Traits::mr;
+    parallelize_gemm_task(func, i, actual_threads, rows, cols, transpose, task_info);
+  }
+#endif
+#endif
+}
 
-    Index r0 = i*blockRows;
-    Index actualBlockRows = (i+1==actual_threads) ? rows-r0 : blockRows;
+// Calls func(start,length) on the chunk i out of actual_threads of the range [0,size).
+template<typename Functor, typename Index>
+void parallelize_range_task(const Functor& func, Index i, Index actual_threads, Index size, Index granularity)
+{
+  Index block = ((size / actual_threads) / granularity) * granularity;
+  Index start = i*block;
+  Index length = (i+1==actual_threads) ? size-start : block;
+  if(length>0)
+    func(start, length);
+}
 
-    Index c0 = i*blockCols;
-    Index actualBlockCols = (i+1==actual_threads) ? cols-c0 : blockCols;
+template<typename Functor, typename Index>
+class parallelize_range_executor_task : public GemmExecutor::Task
+{
+  public:
+    parallelize_range_executor_task(const Functor& func, Index threads, Index size, Index granularity)
+      : m_func(func), m_threads(threads), m_size(size), m_granularity(granularity)
+    {}
+
+    virtual void operator()(int i) const
+    {
+      parallelize_range_task(m_func, Index(i), m_threads, m_size, m_granularity);
+    }
+
+  protected:
+    const Functor& m_func;
+    Index m_threads, m_size, m_granularity;
+};
 
-    info[i].lhs_start = r0;
-    info[i].lhs_length = actualBlockRows;
+/** \internal \returns the number of threads among which parallelize_range() splits a range of \a size elements,
+  * 1 meaning that the range is processed at once by the calling thread. */
+template<bool Condition, typename Index>
+Index parallelize_range_threads(Index size, Index granularity, double work)
+{
+#if (! defined(EIGEN_HAS_OPENMP)) && (!EIGEN_HAS_CXX11_ATOMIC)
+  EIGEN_UNUSED_VARIABLE(size);
+  EIGEN_UNUSED_VARIABLE(granularity);
+  EIGEN_UNUSED_VARIABLE(work);
+  return 1;
+#else
+  if((!Condition) || in_parallel_region(parallel_executor()))
+    return 1;
+  double kMinTaskSize = 50000;  // FIXME improve this heuristic.
+  Index pb_max_threads = std::max<Index>(1, std::min<Index>(size / granularity, work / kMinTaskSize));
+  return std::min<Index>(nbThreads(), pb_max_threads);
+#endif
+}
+
+/** \internal Calls \c func(start,length) on a partition of [0,size) into independent chunks, possibly
+  * from several threads. The lengths of the chunks are multiple of \a granularity, except for the last one,
+  * and \a work is an estimate of the total number of flops which is used to limit the number of threads.
+  *
+  * Unlike parallelize_gemm, the chunks must not depend on each other. */
+template<bool Condition, typename Functor, typename Index>
+void parallelize_range(const Functor& func, Index size, Index granularity, double work)
+{
+#if (! defined(EIGEN_HAS_OPENMP)) && (!EIGEN_HAS_CXX11_ATOMIC)
+  EIGEN_UNUSED_VARIABLE(granularity);
+  EIGEN_UNUSED_VARIABLE(work);
+  func(0, size);
+#else
+  Index threads = parallelize_range_threads<Condition>(size, granularity, work);
+  if(threads==1)
+    return func(0, size);
 
-    if(transpose) func(c0, actualBlockCols, 0, rows, info);
-    else          func(0, rows, c0, actualBlockCols, info);
+  Eigen::initParallel();
+
+  GemmExecutor* executor = parallel_executor();
+  if(executor)
+  {
+    executor->run(int(threads), parallelize_range_executor_task<Functor,Index>(func, threads, size, granularity));
+    return;
   }
+
+#ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel num_threads(threads)
+  {
+    parallelize_range_task(func, Index(omp_get_thread_num()), Index(omp_get_num_threads()), size, granularity);
+  }
+#endif
+#endif
+}
+
+/** \internal \returns the number of threads among which parallelize_tasks() distributes its tasks */
+inline Index parallel_tasks_threads()
+{
+  GemmExecutor* executor = parallel_executor();
+  if(in_parallel_region(executor))
+    return 1;
+  return nbThreads();
+}
+
+template<typename Functor, typename Index>
+class parallelize_tasks_executor_task : public GemmExecutor::Task
+{
+  public:
+    parallelize_tasks_executor_task(const Functor& func, Index threads, Index size)
+      : m_func(func), m_threads(threads), m_size(size)
+    {}
+
+    virtual void operator()(int i) const
+    {
+      // No assumption is made on the thread running the task i: the products evaluated by the tasks
+      // running on the threads of the executor are sequential, the other ones may use the executor again.
+      for(Index j = Index(i); j < m_size; j += m_threads)
+        m_func(j);
+    }
+
+  protected:
+    const Functor& m_func;
+    Index m_threads, m_size;
+};
+
+/** \internal Calls \c func(0), ..., \c func(size-1) concurrently, as independent tasks which may differ by their
+  * nature, e.g., a critical path and the work overlapping it. Unlike parallelize_range, the tasks may evaluate
+  * matrix products, which run sequentially within the threads of the executor or of OpenMP, and may only be
+  * parallelized again on the calling thread of an executor (see GemmExecutor).
+  * If no parallelism is available, the tasks are called in order from the calling thread. */
+template<bool Condition, typename Functor, typename Index>
+void parallelize_tasks(const Functor& func, Index size)
+{
+#if (! defined(EIGEN_HAS_OPENMP)) && (!EIGEN_HAS_CXX11_ATOMIC)
+  for(Index i = 0; i < size; ++i)
+    func(i);
+#else
+  Index threads = std::min<Index>(size, parallel_tasks_threads());
+  if((!Condition) || (threads<=1))
+  {
+    for(Index i = 0; i < size; ++i)
+      func(i);
+    return;
+  }
+
+  Eigen::initParallel();
+
+  GemmExecutor* executor = parallel_executor();
+  if(executor)
+  {
+    executor->run(int(threads), parallelize_tasks_executor_task<Functor,Index>(func, threads, size));
+    return;
+  }
+
+#ifdef EIGEN_HAS_OPENMP
+  #pragma omp parallel num_threads(threads)
+  {
+    for(Index i = Index(omp_get_thread_num()); i < size; i += Index(omp_get_num_threads()))
+      func(i);
+  }
+#endif
 #endif
 }
 
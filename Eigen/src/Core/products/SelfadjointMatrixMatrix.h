@@ -481,7 +481,45 @@ EIGEN_DONT_INLINE void product_selfadjoint_matrix<Scalar,Index,LhsStorageOrder,f
 ***************************************************************************/
 
 namespace internal {
-  
+
+// Evaluates a range of columns of the result when the lhs is selfadjoint, or a range of rows otherwise.
+// The ranges are independent, so that they can be evaluated by parallelize_range.
+template<typename Kernel, typename BlockingType, bool LhsIsSelfAdjoint, typename Lhs, typename Rhs, typename Dest, typename Scalar>
+struct selfadjoint_product_range_functor
+{
+  selfadjoint_product_range_functor(const Lhs& lhs, const Rhs& rhs, Dest& dst, const Scalar& alpha)
+    : m_lhs(lhs), m_rhs(rhs), m_dst(dst), m_alpha(alpha)
+  {}
+
+  void operator()(Index start, Index length) const
+  {
+    if(LhsIsSelfAdjoint)
+    {
+      BlockingType blocking(m_lhs.rows(), length, m_lhs.cols(), 1, false);
+      Kernel::run(m_lhs.rows(), length,
+                  &m_lhs.coeffRef(0,0), m_lhs.outerStride(),
+                  &m_rhs.coeffRef(0,start), m_rhs.outerStride(),
+                  &m_dst.coeffRef(0,start), m_dst.outerStride(),
+                  m_alpha, blocking);
+    }
+    else
+    {
+      BlockingType blocking(length, m_rhs.cols(), m_lhs.cols(), 1, false);
+      Kernel::run(length, m_rhs.cols(),
+                  &m_lhs.coeffRef(start,0), m_lhs.outerStride(),
+                  &m_rhs.coeffRef(0,0), m_rhs.outerStride(),
+                  &m_dst.coeffRef(start,0), m_dst.outerStride(),
+                  m_alpha, blocking);
+    }
+  }
+
+  protected:
+    const Lhs& m_lhs;
+    const Rhs& m_rhs;
+    Dest& m_dst;
+    Scalar m_alpha;
+};
+
 template<typename Lhs, int LhsMode, typename Rhs, int RhsMode>
 struct selfadjoint_product_impl<Lhs,LhsMode,false,Rhs,RhsMode,false>
 {
@@ -489,8 +527,10 @@ struct selfadjoint_product_impl<Lhs,LhsMode,false,Rhs,RhsMode,false>
   
   typedef internal::blas_traits<Lhs> LhsBlasTraits;
   typedef typename LhsBlasTraits::DirectLinearAccessType ActualLhsType;
+  typedef typename internal::remove_all<ActualLhsType>::type ActualLhsTypeCleaned;
   typedef internal::blas_traits<Rhs> RhsBlasTraits;
   typedef typename RhsBlasTraits::DirectLinearAccessType ActualRhsType;
+  typedef typename internal::remove_all<ActualRhsType>::type ActualRhsTypeCleaned;
   
   enum {
     LhsIsUpper = (LhsMode&(Upper|Lower))==Upper,
@@ -513,21 +553,23 @@ struct selfadjoint_product_impl<Lhs,LhsMode,false,Rhs,RhsMode,false>
     typedef internal::gemm_blocking_space<(Dest::Flags&RowMajorBit) ? RowMajor : ColMajor,Scalar,Scalar,
               Lhs::MaxRowsAtCompileTime, Rhs::MaxColsAtCompileTime, Lhs::MaxColsAtCompileTime,1> BlockingType;
 
-    BlockingType blocking(lhs.rows(), rhs.cols(), lhs.cols(), 1, false);
-
-    internal::product_selfadjoint_matrix<Scalar, Index,
+    typedef internal::product_selfadjoint_matrix<Scalar, Index,
       EIGEN_LOGICAL_XOR(LhsIsUpper,internal::traits<Lhs>::Flags &RowMajorBit) ? RowMajor : ColMajor, LhsIsSelfAdjoint,
       NumTraits<Scalar>::IsComplex && EIGEN_LOGICAL_XOR(LhsIsUpper,bool(LhsBlasTraits::NeedToConjugate)),
       EIGEN_LOGICAL_XOR(RhsIsUpper,internal::traits<Rhs>::Flags &RowMajorBit) ? RowMajor : ColMajor, RhsIsSelfAdjoint,
       NumTraits<Scalar>::IsComplex && EIGEN_LOGICAL_XOR(RhsIsUpper,bool(RhsBlasTraits::NeedToConjugate)),
-      internal::traits<Dest>::Flags&RowMajorBit  ? RowMajor : ColMajor>
-      ::run(
-        lhs.rows(), rhs.cols(),                 // sizes
-        &lhs.coeffRef(0,0), lhs.outerStride(),  // lhs info
-        &rhs.coeffRef(0,0), rhs.outerStride(),  // rhs info
-        &dst.coeffRef(0,0), dst.outerStride(),  // result info
-        actualAlpha, blocking                   // alpha
-      );
+      internal::traits<Dest>::Flags&RowMajorBit  ? RowMajor : ColMajor> Kernel;
+
+    typedef selfadjoint_product_range_functor<Kernel, BlockingType, bool(LhsIsSelfAdjoint),
+      ActualLhsTypeCleaned, ActualRhsTypeCleaned, Dest, Scalar> RangeFunctor;
+
+    // The product is split along the dimension of the non-selfadjoint factor.
+    typedef gebp_traits<Scalar,Scalar> Traits;
+    double work = static_cast<double>(lhs.rows()) * static_cast<double>(rhs.cols()) * static_cast<double>(lhs.cols());
+    internal::parallelize_range<(Dest::MaxRowsAtCompileTime>32 || Dest::MaxRowsAtCompileTime==Dynamic)>
+        (RangeFunctor(lhs, rhs, dst, actualAlpha),
+         LhsIsSelfAdjoint ? rhs.cols() : lhs.rows(),
+         Index(LhsIsSelfAdjoint ? Traits::nr : Traits::mr), work);
   }
 };
 
@@ -27,13 +27,26 @@ template<typename Scalar, typename Index, int StorageOrder, int UpLo, bool Conju
 struct selfadjoint_matrix_vector_product
 
 {
+static EIGEN_DEVICE_FUNC
+void run(
+  Index size,
+  const Scalar*  lhs, Index lhsStride,
+  const Scalar*  rhs,
+  Scalar* res,
+  Scalar alpha)
+{
+  run(size, lhs, lhsStride, rhs, res, alpha, 0, size);
+}
+
+// Only reads the columns [colStart,colEnd) of the stored triangle, seen in column-major order.
 static EIGEN_DONT_INLINE EIGEN_DEVICE_FUNC
 void run(
   Index size,
   const Scalar*  lhs, Index lhsStride,
   const Scalar*  rhs,
   Scalar* res,
-  Scalar alpha);
+  Scalar alpha,
+  Index colStart, Index colEnd);
 };
 
 template<typename Scalar, typename Index, int StorageOrder, int UpLo, bool ConjugateLhs, bool ConjugateRhs, int Version>
@@ -43,7 +56,8 @@ void selfadjoint_matrix_vector_product<Scalar,Index,StorageOrder,UpLo,ConjugateL
   const Scalar*  lhs, Index lhsStride,
   const Scalar*  rhs,
   Scalar* res,
-  Scalar alpha)
+  Scalar alpha,
+  Index colStart, Index colEnd)
 {
   typedef typename packet_traits<Scalar>::type Packet;
   typedef typename NumTraits<Scalar>::Real RealScalar;
@@ -64,12 +78,13 @@ void selfadjoint_matrix_vector_product<Scalar,Index,StorageOrder,UpLo,ConjugateL
 
   Scalar cjAlpha = ConjugateRhs ? numext::conj(alpha) : alpha;
 
-  Index bound = numext::maxi(Index(0), size-8) & 0xfffffffe;
-  if (FirstTriangular)
-    bound = size - bound;
+  // the columns are processed by pairs, except the ones among the 8 shortest of the triangle (and one more for parity)
+  Index bound = FirstTriangular
+              ? colEnd - ((colEnd - numext::maxi(colStart, numext::mini(colEnd, Index(8)))) & ~Index(1))
+              : colStart + ((numext::maxi(colStart, numext::mini(colEnd, size-8)) - colStart) & ~Index(1));
 
-  for (Index j=FirstTriangular ? bound : 0;
-       j<(FirstTriangular ? size : bound);j+=2)
+  for (Index j=FirstTriangular ? bound : colStart;
+       j<(FirstTriangular ? colEnd : bound);j+=2)
   {
     const Scalar* EIGEN_RESTRICT A0 = lhs + j*lhsStride;
     const Scalar* EIGEN_RESTRICT A1 = lhs + (j+1)*lhsStride;
@@ -136,7 +151,7 @@ void selfadjoint_matrix_vector_product<Scalar,Index,StorageOrder,UpLo,ConjugateL
     res[j]   += alpha * (t2 + predux(ptmp2));
     res[j+1] += alpha * (t3 + predux(ptmp3));
   }
-  for (Index j=FirstTriangular ? 0 : bound;j<(FirstTriangular ? bound : size);j++)
+  for (Index j=FirstTriangular ? colStart : bound;j<(FirstTriangular ? bound : colEnd);j++)
   {
     const Scalar* EIGEN_RESTRICT A0 = lhs + j*lhsStride;
 
@@ -152,6 +167,53 @@ void selfadjoint_matrix_vector_product<Scalar,Index,StorageOrder,UpLo,ConjugateL
   }
 }
 
+/* Computes the contribution of a vertical panel of the stored triangle (read in column-major order)
+ * to a selfadjoint matrix * vector product. Like the above kernel, each coefficient is read once and
+ * used both as A(i,j) and A(j,i), so that the result of a panel spans the whole vector: each of the
+ * \a tasks panels accumulates into its own buffer, and the buffers are summed once all of them are done.
+ * The boundaries of the panels balance the number of coefficients stored within them.
+ * The functor is called by parallelize_range on chunks of [0,tasks), a chunk being handled as a single panel.
+ */
+template<typename Scalar, typename Index, int StorageOrder, int UpLo, bool ConjugateLhs, bool ConjugateRhs>
+struct selfadjoint_matrix_vector_product_panel_functor
+{
+  selfadjoint_matrix_vector_product_panel_functor(Index size, const Scalar* lhs, Index lhsStride,
+                                                  const Scalar* rhs, Scalar* buffers, Index tasks, const Scalar& alpha)
+    : m_size(size), m_lhs(lhs), m_lhsStride(lhsStride), m_rhs(rhs), m_buffers(buffers), m_tasks(tasks), m_alpha(alpha)
+  {}
+
+  // \returns the first column of the panel \a k
+  Index column(Index k) const
+  {
+    enum {
+      // whether the stored triangle is the lower one when reading the data in column-major order
+      ColMajorLower = (StorageOrder==RowMajor) != (UpLo==Lower)
+    };
+    // the columns [0,j) store a fraction 1-(1-j/size)^2 of the coefficients of a lower triangle,
+    // and a fraction (j/size)^2 of the ones of an upper triangle
+    double ratio = double(k)/double(m_tasks);
+    if(ColMajorLower)
+      return m_size - Index(double(m_size)*std::sqrt(1.-ratio) + 0.5);
+    else
+      return Index(double(m_size)*std::sqrt(ratio) + 0.5);
+  }
+
+  void operator()(Index start, Index length) const
+  {
+    selfadjoint_matrix_vector_product<Scalar,Index,StorageOrder,UpLo,ConjugateLhs,ConjugateRhs,BuiltIn>::run(
+      m_size, m_lhs, m_lhsStride, m_rhs, m_buffers+start*m_size, m_alpha, column(start), column(start+length));
+  }
+
+  protected:
+    Index m_size;
+    const Scalar* m_lhs;
+    Index m_lhsStride;
+    const Scalar* m_rhs;
+    Scalar* m_buffers;
+    Index m_tasks;
+    Scalar m_alpha;
+};
+
 } // end namespace internal 
 
 /***************************************************************************
@@ -224,15 +286,43 @@ struct selfadjoint_product_impl<Lhs,LhsMode,false,Rhs,0,true>
     }
       
       
-    internal::selfadjoint_matrix_vector_product<Scalar, Index, (internal::traits<ActualLhsTypeCleaned>::Flags&RowMajorBit) ? RowMajor : ColMajor,
-                                                int(LhsUpLo), bool(LhsBlasTraits::NeedToConjugate), bool(RhsBlasTraits::NeedToConjugate)>::run
-      (
-        lhs.rows(),                             // size
-        &lhs.coeffRef(0,0),  lhs.outerStride(), // lhs info
-        actualRhsPtr,                           // rhs info
-        actualDestPtr,                          // result info
-        actualAlpha                             // scale factor
-      );
+    enum { StorageOrder = (internal::traits<ActualLhsTypeCleaned>::Flags&RowMajorBit) ? RowMajor : ColMajor };
+    const Index size = lhs.rows();
+
+    // large products are split per vertical panel of the stored triangle among the threads reserved for Eigen
+    double work = static_cast<double>(size) * static_cast<double>(size);
+#ifdef EIGEN_USE_BLAS
+    // as for GEMV, let the BLAS deal with multi-threading
+    Index tasks = 1;
+#else
+    Index tasks = internal::parallelize_range_threads<(Lhs::MaxRowsAtCompileTime>32 || Lhs::MaxRowsAtCompileTime==Dynamic)>
+                    (size, Index(4*internal::packet_traits<Scalar>::size), work);
+#endif
+    if(tasks<=1)
+    {
+      internal::selfadjoint_matrix_vector_product<Scalar, Index, StorageOrder,
+                                                  int(LhsUpLo), bool(LhsBlasTraits::NeedToConjugate), bool(RhsBlasTraits::NeedToConjugate)>::run
+        (
+          size,                                   // size
+          &lhs.coeffRef(0,0),  lhs.outerStride(), // lhs info
+          actualRhsPtr,                           // rhs info
+          actualDestPtr,                          // result info
+          actualAlpha                             // scale factor
+        );
+    }
+    else
+    {
+      typedef internal::selfadjoint_matrix_vector_product_panel_functor<Scalar, Index, StorageOrder,
+        int(LhsUpLo), bool(LhsBlasTraits::NeedToConjugate), bool(RhsBlasTraits::NeedToConjugate)> PanelFunctor;
+      typedef Map<Matrix<ResScalar,Dynamic,Dynamic>, Aligned> MappedBuffers;
+
+      ei_declare_aligned_stack_constructed_variable(ResScalar, buffers, size*tasks, 0);
+      MappedBuffers(buffers, size, tasks).setZero();
+      internal::parallelize_range<true>(PanelFunctor(size, &lhs.coeffRef(0,0), lhs.outerStride(), actualRhsPtr,
+                                                     buffers, tasks, actualAlpha),
+                                        tasks, Index(1), work);
+      MappedDest(actualDestPtr, size) += MappedBuffers(buffers, size, tasks).rowwise().sum();
+    }
     
     if(!EvalToDest)
       dest = MappedDest(actualDestPtr, dest.size());
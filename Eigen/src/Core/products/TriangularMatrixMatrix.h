@@ -395,6 +395,48 @@ EIGEN_DONT_INLINE void product_triangular_matrix_matrix<Scalar,Index,Mode,false,
 } // end namespace internal
 
 namespace internal {
+
+// Evaluates a range of columns of the result when the lhs is triangular, or a range of rows otherwise.
+// The ranges are independent, so that they can be evaluated by parallelize_range.
+template<typename Kernel, typename BlockingType, bool LhsIsTriangular, typename Lhs, typename Rhs, typename Dest, typename Scalar>
+struct triangular_product_range_functor
+{
+  triangular_product_range_functor(const Lhs& lhs, const Rhs& rhs, Dest& dst, const Scalar& alpha,
+                                   Index stripedRows, Index stripedCols, Index stripedDepth)
+    : m_lhs(lhs), m_rhs(rhs), m_dst(dst), m_alpha(alpha),
+      m_stripedRows(stripedRows), m_stripedCols(stripedCols), m_stripedDepth(stripedDepth)
+  {}
+
+  void operator()(Index start, Index length) const
+  {
+    if(LhsIsTriangular)
+    {
+      BlockingType blocking(m_stripedRows, length, m_stripedDepth, 1, false);
+      Kernel::run(m_stripedRows, length, m_stripedDepth,
+                  &m_lhs.coeffRef(0,0), m_lhs.outerStride(),
+                  &m_rhs.coeffRef(0,start), m_rhs.outerStride(),
+                  &m_dst.coeffRef(0,start), m_dst.outerStride(),
+                  m_alpha, blocking);
+    }
+    else
+    {
+      BlockingType blocking(length, m_stripedCols, m_stripedDepth, 1, false);
+      Kernel::run(length, m_stripedCols, m_stripedDepth,
+                  &m_lhs.coeffRef(start,0), m_lhs.outerStride(),
+                  &m_rhs.coeffRef(0,0), m_rhs.outerStride(),
+                  &m_dst.coeffRef(start,0), m_dst.outerStride(),
+                  m_alpha, blocking);
+    }
+  }
+
+  protected:
+    const Lhs& m_lhs;
+    const Rhs& m_rhs;
+    Dest& m_dst;
+    Scalar m_alpha;
+    Index m_stripedRows, m_stripedCols, m_stripedDepth;
+};
+
 template<int Mode, bool LhsIsTriangular, typename Lhs, typename Rhs>
 struct triangular_product_impl<Mode,LhsIsTriangular,Lhs,false,Rhs,false>
 {
@@ -427,20 +469,25 @@ struct triangular_product_impl<Mode,LhsIsTriangular,Lhs,false,Rhs,false>
     Index stripedDepth = LhsIsTriangular ? ((!IsLower) ? lhs.cols() : (std::min)(lhs.cols(),lhs.rows()))
                                          : ((IsLower)  ? rhs.rows() : (std::min)(rhs.rows(),rhs.cols()));
 
-    BlockingType blocking(stripedRows, stripedCols, stripedDepth, 1, false);
-
-    internal::product_triangular_matrix_matrix<Scalar, Index,
+    typedef internal::product_triangular_matrix_matrix<Scalar, Index,
       Mode, LhsIsTriangular,
       (internal::traits<ActualLhsTypeCleaned>::Flags&RowMajorBit) ? RowMajor : ColMajor, LhsBlasTraits::NeedToConjugate,
       (internal::traits<ActualRhsTypeCleaned>::Flags&RowMajorBit) ? RowMajor : ColMajor, RhsBlasTraits::NeedToConjugate,
-      (internal::traits<Dest          >::Flags&RowMajorBit) ? RowMajor : ColMajor>
-      ::run(
-        stripedRows, stripedCols, stripedDepth,   // sizes
-        &lhs.coeffRef(0,0), lhs.outerStride(),    // lhs info
-        &rhs.coeffRef(0,0), rhs.outerStride(),    // rhs info
-        &dst.coeffRef(0,0), dst.outerStride(),    // result info
-        actualAlpha, blocking
-      );
+      (internal::traits<Dest          >::Flags&RowMajorBit) ? RowMajor : ColMajor> Kernel;
+
+    typedef triangular_product_range_functor<Kernel, BlockingType, LhsIsTriangular,
+      ActualLhsTypeCleaned, ActualRhsTypeCleaned, Dest, Scalar> RangeFunctor;
+
+    // The product is split along the dimension of the non-triangular factor.
+    if(stripedRows>0 && stripedCols>0)
+    {
+      typedef gebp_traits<Scalar,Scalar> Traits;
+      double work = static_cast<double>(stripedRows) * static_cast<double>(stripedCols) * static_cast<double>(stripedDepth);
+      internal::parallelize_range<(Dest::MaxRowsAtCompileTime>32 || Dest::MaxRowsAtCompileTime==Dynamic)>
+          (RangeFunctor(lhs, rhs, dst, actualAlpha, stripedRows, stripedCols, stripedDepth),
+           LhsIsTriangular ? stripedCols : stripedRows,
+           Index(LhsIsTriangular ? Traits::nr : Traits::mr), work);
+    }
 
     // Apply correction if the diagonal is unit and a scalar factor was nested:
     if ((Mode&UnitDiag)==UnitDiag)
@@ -39,6 +39,11 @@ template<typename Index,
          typename RhsScalar, typename RhsMapper, bool ConjugateRhs, int Version=Specialized>
 struct general_matrix_vector_product;
 
+template<typename Index,
+         typename LhsScalar, typename LhsMapper, int LhsStorageOrder, bool ConjugateLhs,
+         typename RhsScalar, typename RhsMapper, bool ConjugateRhs, bool Parallelizable>
+struct parallel_general_matrix_vector_product;
+
 
 template<bool Conjugate> struct conj_if;
 
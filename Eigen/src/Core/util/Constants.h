@@ -411,7 +411,11 @@ enum DecompositionOptions {
     * solve the generalized eigenproblem \f$ BAx = \lambda x \f$. */
   BAx_lx              = 0x400,
   /** \internal */
-  GenEigMask = Ax_lBx | ABx_lx | BAx_lx
+  GenEigMask = Ax_lBx | ABx_lx | BAx_lx,
+  /** Used in SelfAdjointEigenSolver and GeneralizedSelfAdjointEigenSolver to indicate that the eigenvectors
+    * of the tridiagonal matrix are to be computed by the divide-and-conquer algorithm rather than by the
+    * symmetric QR algorithm. */
+  DivideAndConquer    = 0x800
 };
 
 /** \ingroup enums
@@ -22,6 +22,8 @@ struct traits<HessenbergDecompositionMatrixHReturnType<MatrixType> >
   typedef MatrixType ReturnType;
 };
 
+template<typename MatrixType, bool Blocked = (MatrixType::MaxColsAtCompileTime==Dynamic)>
+struct hessenberg_decomposition_blocking;
 }
 
 /** \eigenvalues_module \ingroup Eigenvalues_Module
@@ -296,7 +298,9 @@ void HessenbergDecomposition<MatrixType>::_compute(MatrixType& matA, CoeffVector
   eigen_assert(matA.rows()==matA.cols());
   Index n = matA.rows();
   temp.resize(n);
-  for (Index i = 0; i<n-1; ++i)
+  // the leading columns of large matrices are reduced by blocks
+  Index start = internal::hessenberg_decomposition_blocking<MatrixType>::run(matA, hCoeffs);
+  for (Index i = start; i<n-1; ++i)
   {
     // let's consider the vector v = i-th column starting at position i+1
     Index remainingSize = n-i-1;
@@ -321,6 +325,116 @@ void HessenbergDecomposition<MatrixType>::_compute(MatrixType& matA, CoeffVector
 
 namespace internal {
 
+/** \internal
+  * Reduces the leading columns of \a matA to Hessenberg form by blocks of \a blockSize columns, as
+  * LAPACK's gehrd/lahr2, and returns the index of the first column which remains to be reduced.
+  *
+  * Within a panel, the updates of the trailing matrix are not applied: the reflectors are accumulated
+  * in a block reflector \f$ I - V T V^* \f$, and the right update is represented by \f$ Y = A V T \f$,
+  * which is only computed for the rows below the panel's diagonal. The current column is updated from
+  * \a Y and the block reflector just before its own reflector is computed. Once the panel is done,
+  * the remaining rows of \a Y and the updates of the rest of the matrix are computed by matrix products.
+  * The output is the same as the one of the unblocked algorithm. The last \a crossover columns are
+  * left to the unblocked algorithm.
+  */
+template<typename MatrixType, typename CoeffVectorType>
+Index hessenberg_decomposition_blocked(MatrixType& matA, CoeffVectorType& hCoeffs, Index blockSize, Index crossover)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+  typedef Matrix<Scalar,Dynamic,1> WorkVectorType;
+  const Index n = matA.rows();
+  crossover = numext::maxi(crossover, blockSize+1);
+  if(n<crossover)
+    return 0;
+
+  WorkMatrixType V(n, blockSize), Y(n, blockSize), T(blockSize, blockSize), W(blockSize, n);
+  WorkVectorType tmp(blockSize);
+
+  Index k = 0;
+  for(; n-k>=crossover; k+=blockSize)
+  {
+    const Index bs = blockSize;
+    // rows k+1,...,n-1 of V, Y, and the trailing matrix are referenced during the panel
+    const Index rs = n-k-1;
+    V.topRows(rs).setZero();
+    T.setZero();
+    for(Index j=0; j<bs; ++j)
+    {
+      const Index c = k+j;
+      const Index remainingSize = n-c-1;
+
+      if(j>0)
+      {
+        // apply the right update: A(:,c) -= Y V(c,:)^*
+        matA.col(c).tail(rs).noalias() -= Y.block(0,0,rs,j) * V.block(j-1,0,1,j).adjoint();
+        // apply the left update: A(:,c) = (I - V T^* V^*) A(:,c)
+        tmp.head(j).noalias() = V.block(0,0,rs,j).adjoint() * matA.col(c).tail(rs);
+        tmp.head(j) = T.topLeftCorner(j,j).template triangularView<Upper>().adjoint() * tmp.head(j);
+        matA.col(c).tail(rs).noalias() -= V.block(0,0,rs,j) * tmp.head(j);
+      }
+
+      RealScalar beta;
+      Scalar h;
+      matA.col(c).tail(remainingSize).makeHouseholderInPlace(h, beta);
+      V.col(j).segment(j+1, remainingSize - 1) = matA.col(c).tail(remainingSize - 1);
+      V.coeffRef(j,j) = Scalar(1);
+      matA.coeffRef(c+1,c) = beta;
+      hCoeffs.coeffRef(c) = h;
+
+      // the right factors are H^* = I - conj(h) v v^*
+      const Scalar tau = numext::conj(h);
+      Y.col(j).head(rs).noalias() = matA.block(k+1, c+1, rs, remainingSize) * V.col(j).segment(j, remainingSize);
+      if(j>0)
+      {
+        T.col(j).head(j).noalias() = V.block(j,0,remainingSize,j).adjoint() * V.col(j).segment(j, remainingSize);
+        Y.col(j).head(rs).noalias() -= Y.block(0,0,rs,j) * T.col(j).head(j);
+        T.col(j).head(j) = T.topLeftCorner(j,j).template triangularView<Upper>() * T.col(j).head(j);
+        T.col(j).head(j) *= -tau;
+      }
+      Y.col(j).head(rs) *= tau;
+      T.coeffRef(j,j) = tau;
+    }
+
+    // the rows 0,...,k of Y = A V T are computed by matrix products, and stored in the last rows of Y
+    Y.bottomRows(k+1).noalias() = matA.block(0, k+1, k+1, rs) * V.topRows(rs);
+    Y.bottomRows(k+1) = Y.bottomRows(k+1) * T.template triangularView<Upper>();
+
+    // right update of the rows 0,...,k of the panel, and of the trailing columns: A -= Y V^*
+    matA.block(0, k+1, k+1, bs-1).noalias() -= Y.bottomRows(k+1) * V.topRows(bs-1).adjoint();
+    const Index cs = n-k-bs;
+    matA.block(0, k+bs, k+1, cs).noalias() -= Y.bottomRows(k+1) * V.block(bs-1, 0, cs, bs).adjoint();
+    matA.block(k+1, k+bs, rs, cs).noalias() -= Y.topRows(rs) * V.block(bs-1, 0, cs, bs).adjoint();
+
+    // left update of the trailing columns: A = (I - V T^* V^*) A
+    W.leftCols(cs).noalias() = V.topRows(rs).adjoint() * matA.block(k+1, k+bs, rs, cs);
+    W.leftCols(cs) = T.template triangularView<Upper>().adjoint() * W.leftCols(cs);
+    matA.block(k+1, k+bs, rs, cs).noalias() -= V.topRows(rs) * W.leftCols(cs);
+  }
+  return k;
+}
+
+/** \internal
+  * Selects the blocked Hessenberg reduction for matrices without fixed maximal size.
+  */
+template<typename MatrixType, bool Blocked>
+struct hessenberg_decomposition_blocking
+{
+  template<typename CoeffVectorType>
+  static Index run(MatrixType&, CoeffVectorType&) { return 0; }
+};
+
+template<typename MatrixType>
+struct hessenberg_decomposition_blocking<MatrixType,true>
+{
+  template<typename CoeffVectorType>
+  static Index run(MatrixType& matA, CoeffVectorType& hCoeffs)
+  {
+    return hessenberg_decomposition_blocked(matA, hCoeffs, 32, 128);
+  }
+};
+
 /** \eigenvalues_module \ingroup Eigenvalues_Module
   *
   *
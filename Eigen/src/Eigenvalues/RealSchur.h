@@ -161,6 +161,11 @@ template<typename _MatrixType> class RealSchur
       * may be taken to be \f$25n^3\f$ flops if \a computeU is true and
       * \f$10n^3\f$ flops if \a computeU is false.
       *
+      * As long as the unreduced part of the matrix is large, the double shift
+      * iterations are replaced by multishift QR sweeps chasing a chain of small
+      * bulges, whose transformations are accumulated and applied by matrix
+      * products, and by aggressive early deflation, as in LAPACK's hseqr.
+      *
       * Example: \include RealSchur_compute.cpp
       * Output: \verbinclude RealSchur_compute.out
       *
@@ -234,6 +239,11 @@ template<typename _MatrixType> class RealSchur
     Index m_maxIters;
 
     typedef Matrix<Scalar,3,1> Vector3s;
+    typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+    typedef Matrix<Scalar,Dynamic,1> WorkVectorType;
+
+    // minimal size of the active window for which multishift QR sweeps and aggressive early deflation are used
+    enum { MultishiftThreshold = 75 };
 
     Scalar computeNormOfT();
     Index findSmallSubdiagEntry(Index iu, const Scalar& considerAsZero);
@@ -241,6 +251,10 @@ template<typename _MatrixType> class RealSchur
     void computeShift(Index iu, Index iter, Scalar& exshift, Vector3s& shiftInfo);
     void initFrancisQRStep(Index il, Index iu, const Vector3s& shiftInfo, Index& im, Vector3s& firstHouseholderVector);
     void performFrancisQRStep(Index il, Index im, Index iu, bool computeU, const Vector3s& firstHouseholderVector, Scalar* workspace);
+    void performMultishiftQRStep(Index il, Index iu, bool computeU, Scalar* workspace);
+    Index aggressiveEarlyDeflation(Index il, Index iu, Index nw, bool computeU, WorkVectorType& shiftsRe, WorkVectorType& shiftsIm);
+    void performMultishiftQRSweep(Index il, Index iu, bool computeU, const WorkVectorType& shiftsRe, const WorkVectorType& shiftsIm, Scalar* workspace);
+    static Index collectShifts(const WorkMatrixType& T, Index size, WorkVectorType& shiftsRe, WorkVectorType& shiftsIm);
 };
 
 
@@ -333,6 +347,13 @@ RealSchur<MatrixType>& RealSchur<MatrixType>::computeFromHessenberg(const HessMa
         iu -= 2;
         iter = 0;
       }
+      else if (iu-il+1 >= Index(MultishiftThreshold) && iter != 10 && iter != 30) // No convergence yet, large window
+      {
+        iter = iter + 1;
+        totalIter = totalIter + 1;
+        if (totalIter > maxIters) break;
+        performMultishiftQRStep(il, iu, computeU, workspace);
+      }
       else // No convergence yet
       {
         // The firstHouseholderVector vector has to be initialized to something to get rid of a silly GCC warning (-O1 -Wall -DNDEBUG )
@@ -553,6 +574,298 @@ inline void RealSchur<MatrixType>::performFrancisQRStep(Index il, Index im, Inde
   }
 }
 
+/** \internal Perform a multishift QR iteration on rows il:iu, preceded by an aggressive early deflation. */
+template<typename MatrixType>
+void RealSchur<MatrixType>::performMultishiftQRStep(Index il, Index iu, bool computeU, Scalar* workspace)
+{
+  const Index n = iu-il+1;
+  // number of shifts, and size of the deflation window
+  Index ns = n<150 ? 10 : n<590 ? 16 : n<3000 ? 32 : 64;
+  Index nw = n<=500 ? ns : 3*ns/2;
+  nw = (std::min)(nw, (n-1)/3);
+
+  WorkVectorType shiftsRe, shiftsIm;
+  Index nd = aggressiveEarlyDeflation(il, iu, nw, computeU, shiftsRe, shiftsIm);
+
+  // skip the sweep if the deflation has been successful enough
+  if (100*nd > 14*nw)
+    return;
+
+  const Index kbot = iu - nd;
+  if (kbot-il+1 < 3)
+    return;
+  if (shiftsRe.size() < 2)
+  {
+    // use the eigenvalues of the trailing block
+    const Index bs = (std::min)(ns, kbot-il+1);
+    WorkMatrixType block = m_matT.block(kbot-bs+1, kbot-bs+1, bs, bs);
+    RealSchur<WorkMatrixType> schur(bs);
+    schur.computeFromHessenberg(block, WorkMatrixType(), false);
+    if (schur.info() != Success || collectShifts(schur.matrixT(), bs, shiftsRe, shiftsIm) < 2)
+      return;
+  }
+  const Index count = (std::min)(ns, Index(shiftsRe.size()));
+  performMultishiftQRSweep(il, kbot, computeU, shiftsRe.tail(count), shiftsIm.tail(count), workspace);
+}
+
+/** \internal Collect the eigenvalues of the first \a size rows of the quasi-triangular matrix \a T as
+  * pairs of shifts, and return their number. The real eigenvalues are paired together, and the last
+  * of them is dropped if their number is odd. */
+template<typename MatrixType>
+Index RealSchur<MatrixType>::collectShifts(const WorkMatrixType& T, Index size, WorkVectorType& shiftsRe, WorkVectorType& shiftsIm)
+{
+  using std::sqrt;
+  using std::abs;
+  shiftsRe.resize(size);
+  shiftsIm.resize(size);
+  Index count = 0;
+  bool pendingReal = false;
+  for (Index i = 0; i < size; )
+  {
+    if (i+1 < size && T.coeff(i+1,i) != Scalar(0))
+    {
+      const Scalar p = Scalar(0.5) * (T.coeff(i,i) - T.coeff(i+1,i+1));
+      const Scalar q = p * p + T.coeff(i+1,i) * T.coeff(i,i+1);
+      const Scalar mean = T.coeff(i+1,i+1) + p;
+      const Scalar z = sqrt(abs(q));
+      Index pos = count;
+      if (pendingReal)
+      {
+        // keep the pending real shift just before this pair
+        shiftsRe.coeffRef(count+1) = shiftsRe.coeff(count-1);
+        shiftsIm.coeffRef(count+1) = Scalar(0);
+        pos = count-1;
+      }
+      if (q < Scalar(0))
+      {
+        shiftsRe.coeffRef(pos) = mean;   shiftsIm.coeffRef(pos) = z;
+        shiftsRe.coeffRef(pos+1) = mean; shiftsIm.coeffRef(pos+1) = -z;
+      }
+      else
+      {
+        shiftsRe.coeffRef(pos) = mean + z;   shiftsIm.coeffRef(pos) = Scalar(0);
+        shiftsRe.coeffRef(pos+1) = mean - z; shiftsIm.coeffRef(pos+1) = Scalar(0);
+      }
+      count += 2;
+      i += 2;
+    }
+    else
+    {
+      shiftsRe.coeffRef(count) = T.coeff(i,i);
+      shiftsIm.coeffRef(count) = Scalar(0);
+      pendingReal = !pendingReal;
+      ++count;
+      ++i;
+    }
+  }
+  if (pendingReal)
+    --count;
+  shiftsRe.conservativeResize(count);
+  shiftsIm.conservativeResize(count);
+  return count;
+}
+
+/** \internal Aggressive early deflation of the last \a nw rows of the active window il:iu.
+  *
+  * The trailing window is reduced to Schur form, and the trailing eigenvalues whose component in the
+  * spike (the transformed subdiagonal entry coupling the window to the rest) is negligible are deflated.
+  * If some of them are deflated, the transformation is applied to T and U, and the rest of the window is
+  * reduced back to Hessenberg form. The eigenvalues of the window which are not deflated are returned as
+  * shifts. Returns the number of deflated eigenvalues.
+  */
+template<typename MatrixType>
+Index RealSchur<MatrixType>::aggressiveEarlyDeflation(Index il, Index iu, Index nw, bool computeU, WorkVectorType& shiftsRe, WorkVectorType& shiftsIm)
+{
+  using std::abs;
+  using std::sqrt;
+  const Index size = m_matT.cols();
+  const Index kw = iu - nw + 1;
+  eigen_assert(kw > il);
+  const Scalar spikeScale = m_matT.coeff(kw, kw-1);
+  const Scalar ulp = NumTraits<Scalar>::epsilon();
+  const Scalar smallNum = (std::numeric_limits<Scalar>::min)() * (Scalar(size) / ulp);
+
+  WorkMatrixType window = m_matT.block(kw, kw, nw, nw);
+  if (nw > 2)
+    window.bottomLeftCorner(nw-2, nw-2).template triangularView<Lower>().setZero();
+  RealSchur<WorkMatrixType> schur(nw);
+  schur.computeFromHessenberg(window, WorkMatrixType::Identity(nw, nw), true);
+  if (schur.info() != Success)
+  {
+    shiftsRe.resize(0);
+    shiftsIm.resize(0);
+    return 0;
+  }
+  const WorkMatrixType& Tw = schur.matrixT();
+  const WorkMatrixType& Uw = schur.matrixU();
+  const WorkVectorType spike = spikeScale * Uw.row(0).transpose();
+
+  // check the trailing eigenvalues
+  Index nd = 0;
+  for (Index i = nw-1; i >= 0; )
+  {
+    if (i > 0 && Tw.coeff(i,i-1) != Scalar(0))
+    {
+      Scalar foo = abs(Tw.coeff(i,i)) + sqrt(abs(Tw.coeff(i,i-1))) * sqrt(abs(Tw.coeff(i-1,i)));
+      if (foo == Scalar(0))
+        foo = abs(spikeScale);
+      if (numext::maxi(abs(spike.coeff(i)), abs(spike.coeff(i-1))) > numext::maxi(smallNum, ulp * foo))
+        break;
+      nd += 2;
+      i -= 2;
+    }
+    else
+    {
+      Scalar foo = abs(Tw.coeff(i,i));
+      if (foo == Scalar(0))
+        foo = abs(spikeScale);
+      if (abs(spike.coeff(i)) > numext::maxi(smallNum, ulp * foo))
+        break;
+      nd += 1;
+      i -= 1;
+    }
+  }
+
+  const Index m = nw - nd;
+  collectShifts(Tw, m, shiftsRe, shiftsIm);
+  if (nd == 0)
+    return 0;
+
+  // apply the transformation of the window
+  m_matT.block(kw, kw, nw, nw) = Tw;
+  m_matT.col(kw-1).segment(kw, m) = spike.head(m);
+  m_matT.col(kw-1).segment(kw+m, nd).setZero();
+  if (iu+1 < size)
+    m_matT.block(kw, iu+1, nw, size-iu-1) = Uw.transpose() * m_matT.block(kw, iu+1, nw, size-iu-1);
+  m_matT.block(0, kw, kw, nw) = m_matT.block(0, kw, kw, nw) * Uw;
+  if (computeU)
+    m_matU.block(0, kw, size, nw) = m_matU.block(0, kw, size, nw) * Uw;
+
+  // reduce the part which is not deflated back to Hessenberg form
+  if (m > 1)
+  {
+    HessenbergDecomposition<WorkMatrixType> hess(m_matT.block(kw-1, kw-1, m+1, m+1));
+    const WorkMatrixType Q = WorkMatrixType(hess.matrixQ()).bottomRightCorner(m, m);
+    m_matT.block(kw-1, kw-1, m+1, m+1) = hess.matrixH();
+    m_matT.block(kw, kw+m, m, size-kw-m) = Q.transpose() * m_matT.block(kw, kw+m, m, size-kw-m);
+    m_matT.block(0, kw, kw-1, m) = m_matT.block(0, kw, kw-1, m) * Q;
+    if (computeU)
+      m_matU.block(0, kw, size, m) = m_matU.block(0, kw, size, m) * Q;
+  }
+  return nd;
+}
+
+/** \internal Perform a multishift QR sweep on rows il:iu.
+  *
+  * The pairs of shifts define a chain of 3x3 bulges, introduced at the top of the active window one after
+  * the other, and chased down together, three rows apart. The chain is chased by steps within a moving
+  * window of rows and columns: the reflectors are applied inside the window and accumulated in an
+  * orthogonal matrix, which is then applied to the rest of T and to U by matrix products.
+  */
+template<typename MatrixType>
+void RealSchur<MatrixType>::performMultishiftQRSweep(Index il, Index iu, bool computeU, const WorkVectorType& shiftsRe, const WorkVectorType& shiftsIm, Scalar* workspace)
+{
+  using std::abs;
+  const Index size = m_matT.cols();
+  const Index nbulges = shiftsRe.size()/2;
+  eigen_assert(nbulges > 0 && iu-il+1 >= 3);
+
+  // at the step t, the bulge j is chased by a reflector acting on the rows k, k+1, k+2 with k = il+t-3j
+  const Index nsteps = iu-1-il + 3*(nbulges-1) + 1;
+  const Index stepsPerWindow = 3*nbulges;
+  WorkMatrixType V;
+  for (Index t0 = 0; t0 < nsteps; t0 += stepsPerWindow)
+  {
+    const Index t1 = (std::min)(t0+stepsPerWindow, nsteps);
+    const Index wlo = (std::max)(il, il+t0-3*(nbulges-1));
+    const Index whi = (std::min)(iu, il+t1-1+3);
+    const Index ws = whi-wlo+1;
+    V.setIdentity(ws, ws);
+
+    for (Index t = t0; t < t1; ++t)
+    {
+      for (Index j = 0; j < nbulges; ++j)
+      {
+        const Index k = il+t-3*j;
+        if (k < il || k > iu-1)
+          continue;
+        const Index len = k == iu-1 ? 2 : 3;
+
+        Vector3s v;
+        if (k == il)
+        {
+          // first column of (H - s1 I) (H - s2 I), scaled to avoid overflows
+          const Scalar sr1 = shiftsRe.coeff(2*j),   si1 = shiftsIm.coeff(2*j);
+          const Scalar sr2 = shiftsRe.coeff(2*j+1), si2 = shiftsIm.coeff(2*j+1);
+          const Scalar h00 = m_matT.coeff(k,k), h10 = m_matT.coeff(k+1,k);
+          const Scalar s = abs(h00-sr2) + abs(si2) + abs(h10);
+          if (s == Scalar(0))
+            continue;
+          const Scalar h10s = h10 / s;
+          v.coeffRef(0) = (h00-sr1) * ((h00-sr2) / s) - si1 * (si2 / s) + m_matT.coeff(k,k+1) * h10s;
+          v.coeffRef(1) = h10s * (h00 + m_matT.coeff(k+1,k+1) - sr1 - sr2);
+          v.coeffRef(2) = h10s * m_matT.coeff(k+2,k+1);
+        }
+        else
+        {
+          v.head(len) = m_matT.col(k-1).segment(k, len);
+          if (len == 2)
+            v.coeffRef(2) = Scalar(0);
+        }
+
+        Scalar tau, beta;
+        Matrix<Scalar, 2, 1> ess;
+        if (len == 3)
+        {
+          v.makeHouseholder(ess, tau, beta);
+        }
+        else
+        {
+          Matrix<Scalar, 1, 1> ess1;
+          v.template head<2>().makeHouseholder(ess1, tau, beta);
+          ess.coeffRef(0) = ess1.coeff(0);
+        }
+        if (beta == Scalar(0) || !(numext::isfinite)(beta))
+          continue;
+
+        if (k > il)
+        {
+          m_matT.coeffRef(k,k-1) = beta;
+          m_matT.col(k-1).segment(k+1, len-1).setZero();
+        }
+        if (len == 3)
+        {
+          m_matT.block(k, k, 3, whi-k+1).applyHouseholderOnTheLeft(ess, tau, workspace);
+          m_matT.block(wlo, k, (std::min)(k+3,iu)-wlo+1, 3).applyHouseholderOnTheRight(ess, tau, workspace);
+          V.block(0, k-wlo, ws, 3).applyHouseholderOnTheRight(ess, tau, workspace);
+        }
+        else
+        {
+          m_matT.block(k, k, 2, whi-k+1).applyHouseholderOnTheLeft(ess.template head<1>(), tau, workspace);
+          m_matT.block(wlo, k, iu-wlo+1, 2).applyHouseholderOnTheRight(ess.template head<1>(), tau, workspace);
+          V.block(0, k-wlo, ws, 2).applyHouseholderOnTheRight(ess.template head<1>(), tau, workspace);
+        }
+      }
+    }
+
+    // apply the accumulated transformations outside of the window
+    if (whi+1 < size)
+      m_matT.block(wlo, whi+1, ws, size-whi-1) = V.transpose() * m_matT.block(wlo, whi+1, ws, size-whi-1);
+    if (wlo > 0)
+      m_matT.block(0, wlo, wlo, ws) = m_matT.block(0, wlo, wlo, ws) * V;
+    if (computeU)
+      m_matU.block(0, wlo, size, ws) = m_matU.block(0, wlo, size, ws) * V;
+  }
+
+  // clean up pollution due to round-off errors
+  for (Index i = il+2; i <= iu; ++i)
+  {
+    m_matT.coeffRef(i,i-2) = Scalar(0);
+    if (i > il+2)
+      m_matT.coeffRef(i,i-3) = Scalar(0);
+  }
+}
+
 } // end namespace Eigen
 
 #endif // EIGEN_REAL_SCHUR_H
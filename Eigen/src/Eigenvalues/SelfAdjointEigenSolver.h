@@ -24,6 +24,9 @@ template<typename SolverType,int Size,bool IsComplex> struct direct_selfadjoint_
 template<typename MatrixType, typename DiagType, typename SubDiagType>
 EIGEN_DEVICE_FUNC
 ComputationInfo computeFromTridiagonal_impl(DiagType& diag, SubDiagType& subdiag, const Index maxIterations, bool computeEigenvectors, MatrixType& eivec);
+
+template<typename MatrixType, typename DiagType, typename SubDiagType>
+ComputationInfo computeFromTridiagonal_dc(DiagType& diag, SubDiagType& subdiag, const Index maxIterations, MatrixType& eivec);
 }
 
 /** \eigenvalues_module \ingroup Eigenvalues_Module
@@ -178,7 +181,8 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       *
       * \param[in]  matrix  Selfadjoint matrix whose eigendecomposition is to
       *    be computed. Only the lower triangular part of the matrix is referenced.
-      * \param[in]  options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly.
+      * \param[in]  options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly, optionally combined
+      *    with #DivideAndConquer.
       * \returns    Reference to \c *this
       *
       * This function computes the eigenvalues of \p matrix.  The eigenvalues()
@@ -195,6 +199,12 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       * The cost of the computation is about \f$ 9n^3 \f$ if the eigenvectors
       * are required and \f$ 4n^3/3 \f$ if they are not required.
       *
+      * If \p options contains #DivideAndConquer and the eigenvectors are required, the
+      * tridiagonal matrix is diagonalized by Cuppen's divide-and-conquer algorithm instead,
+      * and the Householder reflectors of the tridiagonalization are applied by blocks to its
+      * eigenvectors. This is usually several times faster for large matrices, at the cost of
+      * about \f$ 2n^2 \f$ additional memory.
+      *
       * This method reuses the memory in the SelfAdjointEigenSolver object that
       * was allocated when the object was constructed, if the size of the
       * matrix does not change.
@@ -234,7 +244,8 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       *
       * \param[in] diag The vector containing the diagonal of the matrix.
       * \param[in] subdiag The subdiagonal of the matrix.
-      * \param[in] options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly.
+      * \param[in] options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly, optionally combined
+      *    with #DivideAndConquer.
       * \returns Reference to \c *this
       *
       * This function assumes that the matrix has been reduced to tridiagonal form.
@@ -412,10 +423,11 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
   
   EIGEN_USING_STD_MATH(abs);
   eigen_assert(matrix.cols() == matrix.rows());
-  eigen_assert((options&~(EigVecMask|GenEigMask))==0
+  eigen_assert((options&~(EigVecMask|GenEigMask|DivideAndConquer))==0
           && (options&EigVecMask)!=EigVecMask
           && "invalid option parameter");
   bool computeEigenvectors = (options&ComputeEigenvectors)==ComputeEigenvectors;
+  bool divideAndConquer = computeEigenvectors && (options&DivideAndConquer)==DivideAndConquer;
   Index n = matrix.cols();
   m_eivalues.resize(n,1);
 
@@ -441,9 +453,29 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
   if(scale==RealScalar(0)) scale = RealScalar(1);
   mat.template triangularView<Lower>() /= scale;
   m_subdiag.resize(n-1);
-  internal::tridiagonalization_inplace(mat, diag, m_subdiag, computeEigenvectors);
-
-  m_info = internal::computeFromTridiagonal_impl(diag, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
+  if(divideAndConquer)
+  {
+    // the Householder reflectors are applied by blocks to the eigenvectors of the tridiagonal matrix
+    typename TridiagonalizationType::CoeffVectorType hCoeffs(n-1);
+    internal::tridiagonalization_inplace(mat, hCoeffs);
+    diag = mat.diagonal().real();
+    m_subdiag = mat.diagonal(-1).real();
+    EigenvectorsType eivec;
+    m_info = internal::computeFromTridiagonal_dc(diag, m_subdiag, m_maxIterations, eivec);
+    if(m_info==Success)
+    {
+      typename TridiagonalizationType::HouseholderSequenceType(mat, hCoeffs.conjugate())
+        .setLength(n-1)
+        .setShift(1)
+        .applyThisOnTheLeft(eivec);
+      mat = eivec;
+    }
+  }
+  else
+  {
+    internal::tridiagonalization_inplace(mat, diag, m_subdiag, computeEigenvectors);
+    m_info = internal::computeFromTridiagonal_impl(diag, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
+  }
   
   // scale back the eigen values
   m_eivalues *= scale;
@@ -462,11 +494,18 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
 
   m_eivalues = diag;
   m_subdiag = subdiag;
-  if (computeEigenvectors)
+  if (computeEigenvectors && (options&DivideAndConquer)==DivideAndConquer)
+  {
+    m_info = internal::computeFromTridiagonal_dc(m_eivalues, m_subdiag, m_maxIterations, m_eivec);
+  }
+  else
   {
-    m_eivec.setIdentity(diag.size(), diag.size());
+    if (computeEigenvectors)
+    {
+      m_eivec.setIdentity(diag.size(), diag.size());
+    }
+    m_info = internal::computeFromTridiagonal_impl(m_eivalues, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
   }
-  m_info = internal::computeFromTridiagonal_impl(m_eivalues, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
 
   m_isInitialized = true;
   m_eigenvectorsOk = computeEigenvectors;
@@ -0,0 +1,362 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_TRIDIAGONAL_DIVIDE_AND_CONQUER_H
+#define EIGEN_TRIDIAGONAL_DIVIDE_AND_CONQUER_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  *
+  * \eigenvalues_module \ingroup Eigenvalues_Module
+  *
+  * Divide-and-conquer eigensolver for real symmetric tridiagonal matrices (Cuppen's method).
+  *
+  * The tridiagonal matrix is split into two halves by a rank-one tear, the halves are diagonalized
+  * recursively, and the eigendecomposition of the rank-one modification of the resulting diagonal matrix
+  * is obtained by solving its secular equation. Small eigenvector components and close eigenvalues are
+  * deflated as in LAPACK's laed2, the roots are stored as an offset to the nearest pole to keep the
+  * differences to the poles accurate, and the vector \f$ z \f$ is recomputed from the roots following
+  * Gu and Eisenstat such that the eigenvectors are numerically orthogonal. The eigenvectors of the halves
+  * are then updated by a matrix product. The leaves are solved by the symmetric QR algorithm.
+  */
+template<typename RealScalar>
+struct tridiagonal_divide_conquer
+{
+  typedef Matrix<RealScalar,Dynamic,Dynamic> MatrixType;
+  typedef Matrix<RealScalar,Dynamic,1> VectorType;
+  typedef Ref<MatrixType> MatrixRef;
+  typedef Ref<VectorType> VectorRef;
+
+  // size of the subproblems solved by the QR algorithm
+  enum { LeafSize = 25 };
+  // kinds of the eigenvectors of the two halves: the ones of the top (resp. bottom) half are zero in the
+  // bottom (resp. top) rows, unless they get mixed by a deflation
+  enum { TopColumn = 0, DenseColumn = 1, BottomColumn = 2 };
+
+  /* Computes the eigendecomposition of the tridiagonal matrix (diag,subdiag). On output, diag holds the
+   * eigenvalues in increasing order and eivec the eigenvectors. */
+  static ComputationInfo run(VectorRef diag, VectorRef subdiag, Index maxIterations, MatrixType& eivec)
+  {
+    const Index n = diag.size();
+    eivec.setZero(n, n);
+    // workspace shared by all the merges
+    MatrixType work(n, n);
+    return compute(diag, subdiag, maxIterations, eivec, work);
+  }
+
+  /* Recursive step: eivec is a n x n block whose entries are zero on input, and work is a workspace of
+   * at least n x n entries */
+  static ComputationInfo compute(VectorRef diag, VectorRef subdiag, Index maxIterations, MatrixRef eivec, MatrixRef work)
+  {
+    const Index n = diag.size();
+    if(n<=Index(LeafSize))
+    {
+      VectorType d = diag, e = subdiag;
+      MatrixType q = MatrixType::Identity(n, n);
+      ComputationInfo info = computeFromTridiagonal_impl(d, e, maxIterations, true, q);
+      diag = d;
+      eivec = q;
+      return info;
+    }
+
+    // tear the matrix into two halves
+    const Index m = n/2;
+    const RealScalar beta = subdiag.coeff(m-1);
+    const RealScalar rho = numext::abs(beta);
+    diag.coeffRef(m-1) -= rho;
+    diag.coeffRef(m) -= rho;
+
+    ComputationInfo info = compute(diag.head(m), subdiag.head(m-1), maxIterations, eivec.topLeftCorner(m, m), work);
+    if(info!=Success)
+      return info;
+    info = compute(diag.tail(n-m), subdiag.tail(n-m-1), maxIterations, eivec.bottomRightCorner(n-m, n-m), work);
+    if(info!=Success)
+      return info;
+
+    // the eigenvalues of T are those of diag(D1,D2) + rho z z^T with z = diag(Q1,Q2)^T v / sqrt(2), and
+    // v = e_{m-1} + sign(beta) e_m
+    VectorType z(n);
+    z.head(m) = eivec.row(m-1).head(m).transpose();
+    z.tail(n-m) = eivec.row(m).tail(n-m).transpose();
+    if(beta<RealScalar(0))
+      z.tail(n-m) = -z.tail(n-m);
+    z *= RealScalar(1)/numext::sqrt(RealScalar(2));
+    merge(diag, z, RealScalar(2)*rho, m, eivec, work);
+    return Success;
+  }
+
+  /* Replaces (diag,eivec) by the eigendecomposition of eivec (diag(diag) + rho z z^T) eivec^T,
+   * where ||z||=1, rho>=0, and eivec is block diagonal with a m x m top-left block */
+  static void merge(VectorRef diag, VectorType& z, RealScalar rho, Index m, MatrixRef eivec, MatrixRef work)
+  {
+    const Index n = diag.size();
+    const RealScalar eps = NumTraits<RealScalar>::epsilon();
+
+    // sort the poles
+    std::vector<Index> perm(n);
+    for(Index i=0; i<n; ++i)
+      perm[i] = i;
+    std::sort(perm.begin(), perm.end(), index_less(diag.data()));
+
+    // deflation of the small components of z, and of the close poles by Givens rotations
+    const RealScalar tol = RealScalar(8)*eps*numext::maxi(diag.cwiseAbs().maxCoeff(), z.cwiseAbs().maxCoeff());
+    std::vector<Index> kept, deflated;
+    kept.reserve(n);
+    deflated.reserve(n);
+    std::vector<int> kind(n);
+    for(Index i=0; i<n; ++i)
+      kind[i] = i<m ? TopColumn : BottomColumn;
+    Index pj = -1;
+    for(Index idx=0; idx<n; ++idx)
+    {
+      const Index j = perm[idx];
+      if(rho*numext::abs(z.coeff(j))<=tol)
+      {
+        deflated.push_back(j);
+        continue;
+      }
+      if(pj>=0)
+      {
+        RealScalar s = z.coeff(pj), c = z.coeff(j);
+        const RealScalar tau = numext::hypot(c, s);
+        const RealScalar t = diag.coeff(j) - diag.coeff(pj);
+        c /= tau;
+        s = -s/tau;
+        if(numext::abs(t*c*s)<=tol)
+        {
+          z.coeffRef(j) = tau;
+          z.coeffRef(pj) = RealScalar(0);
+          JacobiRotation<RealScalar> rot(c, -s);
+          eivec.applyOnTheRight(pj, j, rot);
+          if(kind[pj]!=kind[j])
+            kind[pj] = kind[j] = DenseColumn;
+          const RealScalar dpj = diag.coeff(pj)*c*c + diag.coeff(j)*s*s;
+          diag.coeffRef(j) = diag.coeff(pj)*s*s + diag.coeff(j)*c*c;
+          diag.coeffRef(pj) = dpj;
+          deflated.push_back(pj);
+        }
+        else
+        {
+          kept.push_back(pj);
+        }
+      }
+      pj = j;
+    }
+    if(pj>=0)
+      kept.push_back(pj);
+    std::sort(kept.begin(), kept.end(), index_less(diag.data()));
+
+    // solve the secular equation of the remaining problem
+    const Index k = Index(kept.size());
+    VectorType dk(k), zk(k), mus(k);
+    std::vector<Index> shifts(k);
+    MatrixType u(k, k);
+    for(Index i=0; i<k; ++i)
+    {
+      dk.coeffRef(i) = diag.coeff(kept[i]);
+      zk.coeffRef(i) = z.coeff(kept[i]);
+    }
+    if(k>0)
+    {
+      computeRoots(dk, zk, rho, shifts, mus);
+      computeVectors(dk, zk, rho, shifts, mus, u);
+    }
+
+    // Group the kept columns of eivec per kind, followed by the deflated ones, such that the update of the
+    // eigenvectors by u only multiplies the nonzero rows of each kind. The rows of u are permuted accordingly.
+    Index offsets[3] = {0, 0, 0};
+    for(Index i=0; i<k; ++i)
+      for(int c=kind[kept[i]]+1; c<3; ++c)
+        offsets[c]++;
+    const Index nTop = offsets[DenseColumn], nDense = offsets[BottomColumn]-offsets[DenseColumn], nBottom = k-offsets[BottomColumn];
+    PermutationMatrix<Dynamic,Dynamic,Index> grouping(n);
+    MatrixType ug(k, k);
+    for(Index i=0; i<k; ++i)
+    {
+      const Index p = offsets[kind[kept[i]]]++;
+      grouping.indices().coeffRef(p) = kept[i];
+      ug.row(p) = u.row(i);
+    }
+    for(Index i=0; i<Index(deflated.size()); ++i)
+      grouping.indices().coeffRef(k+i) = deflated[i];
+    // in place, column p of eivec becomes its column grouping.indices()(p)
+    eivec = eivec * grouping;
+
+    // update the eigenvectors into the workspace, and sort the eigenpairs
+    MatrixRef updated = work.topLeftCorner(n, n);
+    if(k>0)
+    {
+      updated.topLeftCorner(m, k).noalias() = eivec.topLeftCorner(m, nTop+nDense) * ug.topRows(nTop+nDense);
+      updated.bottomLeftCorner(n-m, k).noalias() = eivec.block(m, nTop, n-m, nDense+nBottom) * ug.bottomRows(nDense+nBottom);
+    }
+    updated.rightCols(n-k) = eivec.rightCols(n-k);
+
+    VectorType values(n);
+    for(Index i=0; i<k; ++i)
+      values.coeffRef(i) = dk.coeff(shifts[i]) + mus.coeff(i);
+    for(Index i=0; i<Index(deflated.size()); ++i)
+      values.coeffRef(k+i) = diag.coeff(deflated[i]);
+    for(Index i=0; i<n; ++i)
+      perm[i] = i;
+    std::sort(perm.begin(), perm.end(), index_less(values.data()));
+
+    for(Index i=0; i<n; ++i)
+    {
+      diag.coeffRef(i) = values.coeff(perm[i]);
+      eivec.col(i) = updated.col(perm[i]);
+    }
+  }
+
+  /* Computes the roots of 1 + rho sum_j z_j^2/(d_j-lambda), d being strictly increasing. The i-th root is
+   * stored as d(shifts[i]) + mus(i), d(shifts[i]) being the closest pole. */
+  static void computeRoots(const VectorType& d, const VectorType& z, RealScalar rho, std::vector<Index>& shifts, VectorType& mus)
+  {
+    const Index k = d.size();
+    const RealScalar eps = NumTraits<RealScalar>::epsilon();
+    const RealScalar zNorm2 = z.squaredNorm();
+    VectorType delta(k);
+    for(Index i=0; i<k; ++i)
+    {
+      Index shift = i;
+      RealScalar lo, hi;
+      if(i<k-1)
+      {
+        const RealScalar half = (d.coeff(i+1)-d.coeff(i))/RealScalar(2);
+        delta = d.array() - d.coeff(i);
+        if(secular(delta, z, rho, half)>=RealScalar(0))
+        {
+          lo = RealScalar(0);
+          hi = half;
+        }
+        else
+        {
+          shift = i+1;
+          lo = -half;
+          hi = RealScalar(0);
+        }
+      }
+      else
+      {
+        lo = RealScalar(0);
+        hi = rho*zNorm2;
+      }
+      delta = d.array() - d.coeff(shift);
+
+      // Newton iterations on -mu*f(mu), which has no pole at the shift, safeguarded by bisection
+      RealScalar mu = (lo+hi)/RealScalar(2);
+      for(Index iter=0; iter<200; ++iter)
+      {
+        RealScalar f = RealScalar(1), g = RealScalar(0), dg = RealScalar(-1);
+        for(Index j=0; j<k; ++j)
+        {
+          const RealScalar zj2 = rho*numext::abs2(z.coeff(j));
+          const RealScalar dj = delta.coeff(j) - mu;
+          f += zj2/dj;
+          if(j!=shift)
+          {
+            g -= zj2/dj;
+            dg -= zj2*delta.coeff(j)/numext::abs2(dj);
+          }
+        }
+        if(f==RealScalar(0))
+          break;
+        if(f<RealScalar(0))
+          lo = mu;
+        else
+          hi = mu;
+        // h(mu) = -mu f(mu) = rho z_shift^2 - mu (1 + sum_{j!=shift} rho z_j^2/(delta_j-mu))
+        const RealScalar h = rho*numext::abs2(z.coeff(shift)) - mu*(RealScalar(1) - g);
+        RealScalar next = dg!=RealScalar(0) ? mu - h/dg : lo;
+        if(!(next>lo && next<hi))
+          next = (lo+hi)/RealScalar(2);
+        const bool converged = numext::abs(next-mu) <= RealScalar(2)*eps*numext::abs(next)
+                            || (hi-lo) <= RealScalar(2)*eps*numext::maxi(numext::abs(lo), numext::abs(hi));
+        mu = next;
+        if(converged)
+          break;
+      }
+      shifts[i] = shift;
+      mus.coeffRef(i) = mu;
+    }
+  }
+
+  /* Computes the eigenvectors from the roots, using the vector z recomputed from the roots by the
+   * Gu-Eisenstat formula */
+  static void computeVectors(const VectorType& d, const VectorType& z, RealScalar rho, const std::vector<Index>& shifts,
+                             const VectorType& mus, MatrixType& u)
+  {
+    const Index k = d.size();
+    VectorType zhat(k);
+    for(Index i=0; i<k; ++i)
+    {
+      // lambda_j - d_i, paired with d_j - d_i for j<i and with d_{j+1} - d_i for j>=i
+      RealScalar prod = ((d.coeff(shifts[k-1]) - d.coeff(i)) + mus.coeff(k-1)) / rho;
+      for(Index j=0; j<k-1; ++j)
+      {
+        const RealScalar num = (d.coeff(shifts[j]) - d.coeff(i)) + mus.coeff(j);
+        const RealScalar den = j<i ? d.coeff(j) - d.coeff(i) : d.coeff(j+1) - d.coeff(i);
+        prod *= num/den;
+      }
+      const RealScalar a = numext::sqrt(numext::maxi(prod, RealScalar(0)));
+      zhat.coeffRef(i) = z.coeff(i)<RealScalar(0) ? -a : a;
+    }
+    for(Index i=0; i<k; ++i)
+    {
+      for(Index j=0; j<k; ++j)
+        u.coeffRef(j,i) = zhat.coeff(j) / ((d.coeff(j) - d.coeff(shifts[i])) - mus.coeff(i));
+      u.col(i).normalize();
+    }
+  }
+
+  static RealScalar secular(const VectorType& delta, const VectorType& z, RealScalar rho, RealScalar mu)
+  {
+    RealScalar f = RealScalar(1);
+    for(Index j=0; j<delta.size(); ++j)
+      f += rho*numext::abs2(z.coeff(j)) / (delta.coeff(j) - mu);
+    return f;
+  }
+
+  struct index_less
+  {
+    index_less(const RealScalar* values) : m_values(values) {}
+    bool operator()(Index a, Index b) const { return m_values[a] < m_values[b]; }
+    const RealScalar* m_values;
+  };
+};
+
+/** \internal
+  *
+  * \eigenvalues_module \ingroup Eigenvalues_Module
+  *
+  * Same as computeFromTridiagonal_impl() with eigenvectors, but using the divide-and-conquer algorithm.
+  * On output, \a eivec holds the eigenvectors of the tridiagonal matrix.
+  */
+template<typename MatrixType, typename DiagType, typename SubDiagType>
+ComputationInfo computeFromTridiagonal_dc(DiagType& diag, SubDiagType& subdiag, const Index maxIterations, MatrixType& eivec)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename DiagType::RealScalar RealScalar;
+  typedef tridiagonal_divide_conquer<RealScalar> Impl;
+
+  typename Impl::MatrixType z;
+  typename Impl::VectorType d = diag, e = subdiag;
+  ComputationInfo info = Impl::run(d, e, maxIterations, z);
+  if(info!=Success)
+    return info;
+  diag = d;
+  eivec = z.template cast<Scalar>();
+  return Success;
+}
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_TRIDIAGONAL_DIVIDE_AND_CONQUER_H
@@ -27,6 +27,9 @@ struct traits<TridiagonalizationMatrixTReturnType<MatrixType> >
 template<typename MatrixType, typename CoeffVectorType>
 EIGEN_DEVICE_FUNC
 void tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs);
+
+template<typename MatrixType, bool Blocked = (MatrixType::MaxColsAtCompileTime==Dynamic)>
+struct tridiagonalization_inplace_blocking;
 }
 
 /** \eigenvalues_module \ingroup Eigenvalues_Module
@@ -347,6 +350,17 @@ namespace internal {
 template<typename MatrixType, typename CoeffVectorType>
 EIGEN_DEVICE_FUNC
 void tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs)
+{
+  tridiagonalization_inplace_blocking<MatrixType>::run(matA, hCoeffs);
+}
+
+/** \internal
+  * Unblocked version of tridiagonalization_inplace(MatrixType&, CoeffVectorType&),
+  * applying one symmetric rank-2 update per column.
+  */
+template<typename MatrixType, typename CoeffVectorType>
+EIGEN_DEVICE_FUNC
+void tridiagonalization_inplace_unblocked(MatrixType& matA, CoeffVectorType& hCoeffs)
 {
   using numext::conj;
   typedef typename MatrixType::Scalar Scalar;
@@ -379,6 +393,131 @@ void tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs)
   }
 }
 
+/** \internal
+  * Blocked version of tridiagonalization_inplace(MatrixType&, CoeffVectorType&).
+  *
+  * This is the panel algorithm of LAPACK's sytrd/latrd: the reflectors of a panel of \a blockSize columns are
+  * computed while the updates of the trailing matrix are accumulated in a matrix \f$ W \f$, such that the
+  * trailing matrix is \f$ A - V W^* - W V^* \f$, \f$ V \f$ being the Householder vectors of the panel.
+  * The pending updates are applied to each column of the panel and to the matrix-vector products before
+  * they are needed, and the trailing matrix is updated once per panel by a rank-2k update performed by
+  * the matrix-matrix product kernels. The last columns are processed by the unblocked algorithm.
+  *
+  * The output is the same as the one of the unblocked algorithm.
+  */
+template<typename MatrixType, typename CoeffVectorType>
+void tridiagonalization_inplace_blocked(MatrixType& matA, CoeffVectorType& hCoeffs, Index blockSize, Index crossover)
+{
+  using numext::conj;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+  const Index n = matA.rows();
+  eigen_assert(n==matA.cols());
+  eigen_assert(n==hCoeffs.size()+1 || n==1);
+  crossover = numext::maxi(crossover, blockSize+1);
+
+  Index k = 0;
+  if(n>=crossover)
+  {
+    // W holds the accumulated updates of the current panel, with rows indexed from k
+    WorkMatrixType W(n, blockSize);
+    // [V W] and [W V], such that the trailing update reads A -= [V W] [W V]^*
+    WorkMatrixType VW(n, 2*blockSize), WV(n, 2*blockSize);
+    Matrix<Scalar,Dynamic,1> tmp(blockSize);
+    Matrix<RealScalar,Dynamic,1> betas(blockSize);
+
+    for(; n-k>=crossover; k+=blockSize)
+    {
+      const Index bs = blockSize;
+      for(Index j=0; j<bs; ++j)
+      {
+        const Index i = k+j;
+        const Index remainingSize = n-i-1;
+
+        // apply the pending updates of the panel to the current column
+        if(j>0)
+        {
+          matA.col(i).tail(n-i).noalias() -= matA.block(i,k,n-i,j) * W.block(j,0,1,j).adjoint();
+          matA.col(i).tail(n-i).noalias() -= W.block(j,0,n-i,j) * matA.block(i,k,1,j).adjoint();
+        }
+
+        RealScalar beta;
+        Scalar h;
+        matA.col(i).tail(remainingSize).makeHouseholderInPlace(h, beta);
+        matA.col(i).coeffRef(i+1) = 1;
+
+        // w = conj(h) (A - V W^* - W V^*) v, where A is the trailing matrix as of the beginning of the panel
+        W.col(j).segment(j+1,remainingSize).noalias() = matA.bottomRightCorner(remainingSize,remainingSize).template selfadjointView<Lower>()
+                                               * (conj(h) * matA.col(i).tail(remainingSize));
+        if(j>0)
+        {
+          tmp.head(j).noalias() = conj(h) * (W.block(j+1,0,remainingSize,j).adjoint() * matA.col(i).tail(remainingSize));
+          W.col(j).segment(j+1,remainingSize).noalias() -= matA.block(i+1,k,remainingSize,j) * tmp.head(j);
+          tmp.head(j).noalias() = conj(h) * (matA.block(i+1,k,remainingSize,j).adjoint() * matA.col(i).tail(remainingSize));
+          W.col(j).segment(j+1,remainingSize).noalias() -= W.block(j+1,0,remainingSize,j) * tmp.head(j);
+        }
+
+        W.col(j).segment(j+1,remainingSize) += (conj(h)*RealScalar(-0.5)*(W.col(j).segment(j+1,remainingSize).dot(matA.col(i).tail(remainingSize))))
+                                        * matA.col(i).tail(remainingSize);
+
+        betas.coeffRef(j) = beta;
+        hCoeffs.coeffRef(i) = h;
+      }
+
+      // rank-2k update of the lower triangular part of the trailing matrix, performed by strips of columns such
+      // that the off-diagonal blocks go through the general matrix product, and its multi-threading
+      const Index t = k+bs;
+      const Index s = n-t;
+      VW.block(0,0,s,bs) = matA.block(t,k,s,bs);
+      VW.block(0,bs,s,bs) = W.block(bs,0,s,bs);
+      WV.block(0,0,s,bs) = VW.block(0,bs,s,bs);
+      WV.block(0,bs,s,bs) = VW.block(0,0,s,bs);
+      const Index stripSize = 4*blockSize;
+      for(Index c=0; c<s; c+=stripSize)
+      {
+        const Index cs = numext::mini(stripSize, s-c);
+        const Index rs = s-c-cs;
+        matA.block(t+c,t+c,cs,cs).template triangularView<Lower>() -= VW.block(c,0,cs,2*bs) * WV.block(c,0,cs,2*bs).adjoint();
+        if(rs>0)
+          matA.block(t+c+cs,t+c,rs,cs).noalias() -= VW.block(c+cs,0,rs,2*bs) * WV.block(c,0,cs,2*bs).adjoint();
+      }
+
+      for(Index j=0; j<bs; ++j)
+        matA.coeffRef(k+j+1,k+j) = betas.coeff(j);
+    }
+  }
+
+  const Index remainingSize = n-k;
+  Block<MatrixType> remainingMatrix(matA, k, k, remainingSize, remainingSize);
+  VectorBlock<CoeffVectorType> remainingCoeffs(hCoeffs, k, remainingSize-1);
+  tridiagonalization_inplace_unblocked(remainingMatrix, remainingCoeffs);
+}
+
+/** \internal
+  * Selects the blocked tridiagonalization for matrices without fixed maximal size.
+  */
+template<typename MatrixType, bool Blocked>
+struct tridiagonalization_inplace_blocking
+{
+  template<typename CoeffVectorType>
+  static EIGEN_DEVICE_FUNC
+  void run(MatrixType& matA, CoeffVectorType& hCoeffs)
+  {
+    tridiagonalization_inplace_unblocked(matA, hCoeffs);
+  }
+};
+
+template<typename MatrixType>
+struct tridiagonalization_inplace_blocking<MatrixType,true>
+{
+  template<typename CoeffVectorType>
+  static void run(MatrixType& matA, CoeffVectorType& hCoeffs)
+  {
+    tridiagonalization_inplace_blocked(matA, hCoeffs, 32, 128);
+  }
+};
+
 // forward declaration, implementation at the end of this file
 template<typename MatrixType,
          int Size=MatrixType::ColsAtCompileTime,
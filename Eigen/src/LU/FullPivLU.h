@@ -22,6 +22,29 @@ template<typename _MatrixType> struct traits<FullPivLU<_MatrixType> >
   enum { Flags = 0 };
 };
 
+/** \internal Computes the biggest score of each column of the bottom-right corner of \a mat starting at (k,k).
+  * The columns are independent, so that they can be evaluated by parallelize_range. */
+template<typename MatrixType, typename ScoreVectorType>
+struct full_piv_lu_column_maxima
+{
+  typedef scalar_score_coeff_op<typename MatrixType::Scalar> Scoring;
+
+  full_piv_lu_column_maxima(const MatrixType& mat, Index k, ScoreVectorType& maxima)
+    : m_mat(mat), m_k(k), m_maxima(maxima)
+  {}
+
+  void operator()(Index start, Index length) const
+  {
+    const Index rows = m_mat.rows() - m_k;
+    for(Index j = start; j < start+length; ++j)
+      m_maxima.coeffRef(j) = m_mat.col(m_k+j).tail(rows).unaryExpr(Scoring()).maxCoeff();
+  }
+
+  const MatrixType& m_mat;
+  Index m_k;
+  ScoreVectorType& m_maxima;
+};
+
 } // end namespace internal
 
 /** \ingroup LU_Module
@@ -46,6 +69,11 @@ template<typename _MatrixType> struct traits<FullPivLU<_MatrixType> >
   * working with the SVD allows to select the smallest singular values of the matrix, something that
   * the LU decomposition doesn't see.
   *
+  * Large matrices of dynamic size are factored by panels: the biggest coefficient of the trailing matrix is searched
+  * in parallel at the start of each panel, and the following pivots of the panel are found by rook pivoting, so that
+  * the trailing matrix is updated by matrix products. A rook pivot is only accepted if it is at least half the biggest
+  * coefficient at the start of the panel, which preserves the rank-revealing property of complete pivoting.
+  *
   * The data of the LU decomposition can be directly accessed through the methods matrixLU(),
   * permutationP(), permutationQ().
   *
@@ -423,6 +451,8 @@ template<typename _MatrixType> class FullPivLU
     }
 
     void computeInPlace();
+    template<typename ScoreVectorType>
+    Index computePanel(Index k, Index blockSize, ScoreVectorType& colMaxima, Index& number_of_transpositions);
 
     MatrixType m_lu;
     PermutationPType m_p;
@@ -505,18 +535,39 @@ void FullPivLU<MatrixType>::computeInPlace()
   m_nonzero_pivots = size; // the generic case is that in which all pivots are nonzero (invertible case)
   m_maxpivot = RealScalar(0);
 
+  typedef internal::scalar_score_coeff_op<Scalar> Scoring;
+  typedef typename Scoring::result_type Score;
+
+  // Large matrices are factored by panels of BlockSize pivots, until the trailing matrix
+  // is small enough to be handled by the unblocked algorithm.
+  enum { BlockSize = 32 };
+  const bool blocked = MaxColsAtCompileTime==Dynamic && MaxRowsAtCompileTime==Dynamic;
+  Matrix<Score,Dynamic,1> colMaxima;
+
   for(Index k = 0; k < size; ++k)
   {
+    const bool panel = blocked && (std::min)(rows-k, cols-k) > 2*Index(BlockSize);
+
     // First, we need to find the pivot.
 
     // biggest coefficient in the remaining bottom-right corner (starting at row k, col k)
     Index row_of_biggest_in_corner, col_of_biggest_in_corner;
-    typedef internal::scalar_score_coeff_op<Scalar> Scoring;
-    typedef typename Scoring::result_type Score;
     Score biggest_in_corner;
-    biggest_in_corner = m_lu.bottomRightCorner(rows-k, cols-k)
-                        .unaryExpr(Scoring())
-                        .maxCoeff(&row_of_biggest_in_corner, &col_of_biggest_in_corner);
+    if(panel)
+    {
+      // the maxima of the columns are computed in parallel, and kept to start the search of the next pivots of the panel
+      colMaxima.resize(cols-k);
+      internal::parallelize_range<true>(internal::full_piv_lu_column_maxima<MatrixType,Matrix<Score,Dynamic,1> >(m_lu, k, colMaxima),
+                                        cols-k, Index(8), double(rows-k)*double(cols-k));
+      biggest_in_corner = colMaxima.maxCoeff(&col_of_biggest_in_corner);
+      m_lu.col(k+col_of_biggest_in_corner).tail(rows-k).unaryExpr(Scoring()).maxCoeff(&row_of_biggest_in_corner);
+    }
+    else
+    {
+      biggest_in_corner = m_lu.bottomRightCorner(rows-k, cols-k)
+                          .unaryExpr(Scoring())
+                          .maxCoeff(&row_of_biggest_in_corner, &col_of_biggest_in_corner);
+    }
     row_of_biggest_in_corner += k; // correct the values! since they were computed in the corner,
     col_of_biggest_in_corner += k; // need to add k to them.
 
@@ -533,6 +584,12 @@ void FullPivLU<MatrixType>::computeInPlace()
       break;
     }
 
+    if(panel)
+    {
+      k += computePanel(k, BlockSize, colMaxima, number_of_transpositions) - 1;
+      continue;
+    }
+
     RealScalar abs_pivot = internal::abs_knowing_score<Scalar>()(m_lu(row_of_biggest_in_corner, col_of_biggest_in_corner), biggest_in_corner);
     if(abs_pivot > m_maxpivot) m_maxpivot = abs_pivot;
 
@@ -575,6 +632,104 @@ void FullPivLU<MatrixType>::computeInPlace()
   m_isInitialized = true;
 }
 
+/** \internal Eliminates at most \a blockSize pivots starting at \a k, and updates the trailing matrix.
+  *
+  * The trailing matrix is not updated after each pivot. Instead, only the row and the column of each pivot
+  * are updated within the panel, and the rest of the trailing matrix is then updated by a single matrix product.
+  * Since the trailing matrix is not up to date, the pivots following the first one are found by rook pivoting:
+  * starting from the column whose biggest coefficient was the biggest at the start of the panel, the search
+  * alternates between the current column and the current row, until their common coefficient is the biggest
+  * of both. A pivot is only accepted if it is at least half the biggest coefficient of the trailing matrix at the
+  * start of the panel. Otherwise the panel stops early, so that the next pivot is found by a complete search,
+  * and the pivots keep revealing the rank as reliably as with complete pivoting.
+  *
+  * \a colMaxima holds the biggest scores of the columns of the trailing matrix, as computed at the start of the panel.
+  *
+  * \returns the number of eliminated pivots
+  */
+template<typename MatrixType>
+template<typename ScoreVectorType>
+Index FullPivLU<MatrixType>::computePanel(Index k, Index blockSize, ScoreVectorType& colMaxima, Index& number_of_transpositions)
+{
+  typedef internal::scalar_score_coeff_op<Scalar> Scoring;
+  typedef typename Scoring::result_type Score;
+  const Index rows = m_lu.rows();
+  const Index cols = m_lu.cols();
+
+  Matrix<Scalar,Dynamic,1> column(rows-k);
+  Matrix<Scalar,1,Dynamic> row(cols-k);
+  RealScalar threshold(0);
+  Index kb = 0;
+  for(; kb < blockSize; ++kb)
+  {
+    const Index rk = k+kb;
+    const Index remainingRows = rows-rk;
+    const Index remainingCols = cols-rk;
+
+    Index row_of_pivot = rk, col_of_pivot;
+    colMaxima.segment(kb, remainingCols).maxCoeff(&col_of_pivot);
+    col_of_pivot += rk;
+    Score biggest = Score(0);
+    for(Index i = 0; ; ++i)
+    {
+      Index candidate;
+      Score score;
+      if(i%2==0)
+      {
+        // the current column, with the updates of the previous pivots of the panel
+        column.head(remainingRows) = m_lu.col(col_of_pivot).tail(remainingRows);
+        if(kb>0)
+          column.head(remainingRows).noalias() -= m_lu.block(rk, k, remainingRows, kb) * m_lu.col(col_of_pivot).segment(k, kb);
+        score = column.head(remainingRows).unaryExpr(Scoring()).maxCoeff(&candidate);
+      }
+      else
+      {
+        // the current row, with the updates of the previous pivots of the panel
+        row.head(remainingCols) = m_lu.row(row_of_pivot).tail(remainingCols);
+        if(kb>0)
+          row.head(remainingCols).noalias() -= m_lu.row(row_of_pivot).segment(k, kb) * m_lu.block(k, rk, kb, remainingCols);
+        score = row.head(remainingCols).unaryExpr(Scoring()).maxCoeff(&candidate);
+      }
+      if(i>0 && !(biggest < score))
+        break;
+      biggest = score;
+      if(i%2==0) row_of_pivot = rk+candidate;
+      else       col_of_pivot = rk+candidate;
+    }
+
+    const RealScalar abs_pivot = numext::abs(row.coeff(col_of_pivot-rk));
+    if(kb==0)
+      threshold = RealScalar(0.5) * abs_pivot;
+    else if(!(abs_pivot >= threshold))
+      break;
+    if(abs_pivot > m_maxpivot) m_maxpivot = abs_pivot;
+
+    m_rowsTranspositions.coeffRef(rk) = internal::convert_index<StorageIndex>(row_of_pivot);
+    m_colsTranspositions.coeffRef(rk) = internal::convert_index<StorageIndex>(col_of_pivot);
+    if(rk != row_of_pivot) {
+      m_lu.row(rk).swap(m_lu.row(row_of_pivot));
+      std::swap(column.coeffRef(0), column.coeffRef(row_of_pivot-rk));
+      ++number_of_transpositions;
+    }
+    if(rk != col_of_pivot) {
+      m_lu.col(rk).swap(m_lu.col(col_of_pivot));
+      std::swap(row.coeffRef(0), row.coeffRef(col_of_pivot-rk));
+      std::swap(colMaxima.coeffRef(kb), colMaxima.coeffRef(col_of_pivot-k));
+      ++number_of_transpositions;
+    }
+
+    // store the row of U and the column of L of the pivot
+    m_lu.row(rk).tail(remainingCols) = row.head(remainingCols);
+    m_lu.col(rk).tail(remainingRows-1) = column.segment(1, remainingRows-1) / row.coeff(0);
+  }
+
+  // update the trailing matrix below and right of the panel
+  const Index next = k+kb;
+  m_lu.bottomRightCorner(rows-next, cols-next).noalias() -= m_lu.block(next, k, rows-next, kb)
+                                                          * m_lu.block(k, next, kb, cols-next);
+  return kb;
+}
+
 template<typename MatrixType>
 typename internal::traits<MatrixType>::Scalar FullPivLU<MatrixType>::determinant() const
 {
@@ -69,6 +69,10 @@ struct enable_if_ref<Ref<T>,Derived> {
   *
   * The data of the LU decomposition can be directly accessed through the methods matrixLU(), permutationP().
   *
+  * When several threads are reserved for Eigen (see setNbThreads() and setGemmExecutor()), large matrices are
+  * factored with a look-ahead: each panel is factored on one thread while the previous panel is applied to the
+  * rest of the trailing matrix on the other ones.
+  *
   * This class supports the \link InplaceDecomposition inplace decomposition \endlink mechanism.
   * 
   * \sa MatrixBase::partialPivLu(), MatrixBase::determinant(), MatrixBase::inverse(), MatrixBase::computeInverse(), class FullPivLU
@@ -448,6 +452,15 @@ struct partial_lu_impl
       blockSize = (std::min)((std::max)(blockSize,Index(8)), maxBlockSize);
     }
 
+    // when several threads are available, the factorization of the panels, which is the critical path,
+    // is overlapped with the update of the trailing matrix
+    if(blockSize>=32)
+    {
+      Index threads = parallel_tasks_threads();
+      if(threads>1)
+        return blocked_lu_lookahead(rows, cols, lu_data, luStride, row_transpositions, nb_transpositions, blockSize, threads);
+    }
+
     nb_transpositions = 0;
     Index first_zero_pivot = -1;
     for(Index k = 0; k < size; k+=blockSize)
@@ -497,6 +510,118 @@ struct partial_lu_impl
     }
     return first_zero_pivot;
   }
+
+  /** \internal The tasks of a look-ahead step of blocked_lu_lookahead(): the task 0 factors the next panel,
+    * while the other ones apply the current panel, starting at \a k, to chunks of the columns following the
+    * next panel. The columns of the tasks are disjoint, so that they can run concurrently.
+    */
+  struct lookahead_task
+  {
+    lookahead_task(Index rows, Index cols, Scalar* lu_data, Index luStride, PivIndex* row_transpositions,
+                   Index k, Index bs, Index nbs, Index tsize, Index chunks,
+                   Index* first_zero_pivot_in_panel, PivIndex* nb_transpositions_in_panel)
+      : m_rows(rows), m_cols(cols), m_lu_data(lu_data), m_luStride(luStride), m_row_transpositions(row_transpositions),
+        m_k(k), m_bs(bs), m_nbs(nbs), m_tsize(tsize), m_chunks(chunks),
+        m_first_zero_pivot_in_panel(first_zero_pivot_in_panel), m_nb_transpositions_in_panel(nb_transpositions_in_panel)
+    {}
+
+    void operator()(Index i) const
+    {
+      MatrixTypeRef lu = MatrixType::Map(m_lu_data, m_rows, m_cols, OuterStride<>(m_luStride));
+      const Index k = m_k, bs = m_bs, nbs = m_nbs;
+      const Index trows = m_rows - k - bs;
+      if(i==0)
+      {
+        *m_first_zero_pivot_in_panel = blocked_lu(trows, nbs, &lu.coeffRef(k+bs,k+bs), m_luStride,
+                                                  m_row_transpositions+k+bs, *m_nb_transpositions_in_panel, 16);
+        return;
+      }
+
+      const Index remaining = m_tsize - nbs;
+      Index chunk = (remaining + m_chunks - 1) / m_chunks;
+      chunk = ((chunk+15)/16)*16;
+      const Index start = (i-1) * chunk;
+      if(start >= remaining)
+        return;
+      const Index c = k + bs + nbs + start;
+      const Index len = (std::min)(chunk, remaining - start);
+
+      BlockType A_2 = lu.block(0,c,m_rows,len);
+      for(Index j=k; j<k+bs; ++j)
+        A_2.row(j).swap(A_2.row(m_row_transpositions[j]));
+
+      BlockType A11 = lu.block(k,k,bs,bs);
+      BlockType A12 = lu.block(k,c,bs,len);
+      A11.template triangularView<UnitLower>().solveInPlace(A12);
+      lu.block(k+bs,c,trows,len).noalias() -= lu.block(k+bs,k,trows,bs) * A12;
+    }
+
+    Index m_rows, m_cols;
+    Scalar* m_lu_data;
+    Index m_luStride;
+    PivIndex* m_row_transpositions;
+    Index m_k, m_bs, m_nbs, m_tsize, m_chunks;
+    Index* m_first_zero_pivot_in_panel;
+    PivIndex* m_nb_transpositions_in_panel;
+  };
+
+  /** \internal Same as blocked_lu() with a look-ahead of one panel: once the current panel is applied to the
+    * columns of the next panel, the next panel is factored by one thread while the other \a threads - 1 threads
+    * apply the current panel to the rest of the trailing matrix (see lookahead_task).
+    */
+  static Index blocked_lu_lookahead(Index rows, Index cols, Scalar* lu_data, Index luStride, PivIndex* row_transpositions,
+                                    PivIndex& nb_transpositions, Index blockSize, Index threads)
+  {
+    MatrixTypeRef lu = MatrixType::Map(lu_data,rows, cols, OuterStride<>(luStride));
+
+    const Index size = (std::min)(rows,cols);
+
+    nb_transpositions = 0;
+    Index first_zero_pivot = -1;
+
+    // the first panel has nothing to overlap with
+    PivIndex nb_transpositions_in_panel;
+    Index ret = blocked_lu(rows, (std::min)(size,blockSize), lu_data, luStride,
+                           row_transpositions, nb_transpositions_in_panel, 16);
+    for(Index k = 0; k < size; k+=blockSize)
+    {
+      Index bs = (std::min)(size-k,blockSize); // actual size of the block
+      Index trows = rows - k - bs; // trailing rows
+      Index tsize = size - k - bs; // trailing size
+      Index nbs = (std::min)(tsize,blockSize); // size of the next block
+
+      // the panel [A11^T A21^T]^T has already been factored
+      if(ret>=0 && first_zero_pivot==-1)
+        first_zero_pivot = k+ret;
+
+      nb_transpositions += nb_transpositions_in_panel;
+      // update permutations and apply them to A_0
+      BlockType A_0 = lu.block(0,0,rows,k);
+      for(Index i=k; i<k+bs; ++i)
+      {
+        Index piv = (row_transpositions[i] += internal::convert_index<PivIndex>(k));
+        A_0.row(i).swap(A_0.row(piv));
+      }
+
+      if(tsize==0)
+        break;
+
+      // apply the panel to the columns of the next one
+      BlockType A_1 = lu.block(0,k+bs,rows,nbs);
+      for(Index i=k; i<k+bs; ++i)
+        A_1.row(i).swap(A_1.row(row_transpositions[i]));
+      BlockType A11 = lu.block(k,k,bs,bs);
+      BlockType A12 = lu.block(k,k+bs,bs,nbs);
+      A11.template triangularView<UnitLower>().solveInPlace(A12);
+      lu.block(k+bs,k+bs,trows,nbs).noalias() -= lu.block(k+bs,k,trows,bs) * A12;
+
+      // factor the next panel while the remaining columns are updated
+      lookahead_task task(rows, cols, lu_data, luStride, row_transpositions, k, bs, nbs, tsize, threads-1,
+                          &ret, &nb_transpositions_in_panel);
+      parallelize_tasks<true>(task, tsize>nbs ? threads : Index(1));
+    }
+    return first_zero_pivot;
+  }
 };
 
 /** \internal performs the LU decomposition with partial pivoting in-place.
@@ -0,0 +1,680 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_NESTED_DISSECTION_H
+#define EIGEN_NESTED_DISSECTION_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * The adjacency graph of a symmetric sparse pattern, in compressed format, with weights on the vertices and
+  * on the edges (used by the coarse graphs). */
+template<typename StorageIndex>
+struct nd_graph
+{
+  std::vector<StorageIndex> xadj, adjncy, adjwgt, vwgt;
+  StorageIndex totalWeight;
+
+  nd_graph() : totalWeight(0) {}
+  StorageIndex size() const { return xadj.empty() ? 0 : StorageIndex(xadj.size()-1); }
+  void swap(nd_graph& other)
+  {
+    xadj.swap(other.xadj); adjncy.swap(other.adjncy); adjwgt.swap(other.adjwgt); vwgt.swap(other.vwgt);
+    std::swap(totalWeight, other.totalWeight);
+  }
+};
+
+/** \internal
+  * \ingroup OrderingMethods_Module
+  * Nested dissection of a graph: the graph is split into two parts by a small vertex separator, which is
+  * numbered last, and the parts are recursively ordered in the same way. The separators are computed by a
+  * multilevel bisection: the graph is coarsened by heavy edge matchings, the coarsest graph is bisected by
+  * growing regions, the bisection is projected back and refined by Fiduccia-Mattheyses passes at each level,
+  * and the edge separator is finally turned into a minimal vertex separator. Small subgraphs are ordered
+  * by the approximate minimum degree.
+  */
+template<typename StorageIndex>
+class nested_dissection
+{
+  public:
+    typedef std::vector<StorageIndex> IndexList;
+    typedef nd_graph<StorageIndex> Graph;
+
+    nested_dissection(Index leafSize, Index coarsenTo)
+      : m_leafSize(leafSize), m_coarsenTo(coarsenTo), m_seed(1)
+    {}
+
+    /** Appends to \a order the labels of the vertices of \a g in the nested dissection order */
+    void dissect(const Graph& g, const IndexList& labels, IndexList& order)
+    {
+      const StorageIndex n = g.size();
+      if(n <= m_leafSize)
+      {
+        orderLeaf(g, labels, order);
+        return;
+      }
+
+      IndexList where(n), local(n, StorageIndex(-1));
+      // the connected components are ordered independently, and the small ones are gathered into leaves
+      StorageIndex ncomp = components(g, where);
+      if(ncomp > 1)
+      {
+        IndexList start(ncomp+1, 0), vertices(n);
+        for(StorageIndex v = 0; v < n; ++v) start[where[v]+1]++;
+        for(StorageIndex c = 0; c < ncomp; ++c) start[c+1] += start[c];
+        for(StorageIndex v = 0; v < n; ++v) vertices[start[where[v]]++] = v;
+        for(StorageIndex c = ncomp; c > 0; --c) start[c] = start[c-1];
+        start[0] = 0;
+        IndexList leaf;
+        for(StorageIndex c = 0; c < ncomp; ++c)
+        {
+          Graph sub;
+          IndexList subLabels;
+          if(start[c+1]-start[c] > m_leafSize)
+          {
+            IndexList part(vertices.begin()+start[c], vertices.begin()+start[c+1]);
+            extract(g, labels, part, local, sub, subLabels);
+            dissect(sub, subLabels, order);
+            continue;
+          }
+          leaf.insert(leaf.end(), vertices.begin()+start[c], vertices.begin()+start[c+1]);
+          if(Index(leaf.size()) >= m_leafSize)
+          {
+            extract(g, labels, leaf, local, sub, subLabels);
+            orderLeaf(sub, subLabels, order);
+            leaf.clear();
+          }
+        }
+        if(!leaf.empty())
+        {
+          Graph sub;
+          IndexList subLabels;
+          extract(g, labels, leaf, local, sub, subLabels);
+          orderLeaf(sub, subLabels, order);
+        }
+        return;
+      }
+
+      bisect(g, where);
+      separator(g, where);
+      IndexList parts[3];
+      for(StorageIndex v = 0; v < n; ++v)
+        parts[where[v]].push_back(v);
+      if(parts[0].empty() || parts[1].empty())
+      {
+        orderLeaf(g, labels, order);
+        return;
+      }
+      for(int p = 0; p < 2; ++p)
+      {
+        Graph sub;
+        IndexList subLabels;
+        extract(g, labels, parts[p], local, sub, subLabels);
+        IndexList().swap(parts[p]);
+        dissect(sub, subLabels, order);
+      }
+      for(std::size_t k = 0; k < parts[2].size(); ++k)
+        order.push_back(labels[parts[2][k]]);
+    }
+
+  protected:
+    // a simple linear congruential generator, so that the ordering is deterministic
+    StorageIndex random(StorageIndex n)
+    {
+      m_seed = m_seed * 1103515245u + 12345u;
+      return StorageIndex((m_seed >> 8) % unsigned(n));
+    }
+
+    void orderLeaf(const Graph& g, const IndexList& labels, IndexList& order)
+    {
+      const StorageIndex n = g.size();
+      if(n <= 2)
+      {
+        for(StorageIndex v = 0; v < n; ++v) order.push_back(labels[v]);
+        return;
+      }
+      SparseMatrix<StorageIndex,ColMajor,StorageIndex> C(n,n);
+      C.resizeNonZeros(Index(g.xadj[n]) + n);
+      StorageIndex* outer = C.outerIndexPtr();
+      StorageIndex* inner = C.innerIndexPtr();
+      StorageIndex nnz = 0;
+      for(StorageIndex v = 0; v < n; ++v)
+      {
+        outer[v] = nnz;
+        inner[nnz++] = v;
+        for(StorageIndex e = g.xadj[v]; e < g.xadj[v+1]; ++e)
+          inner[nnz++] = g.adjncy[e];
+      }
+      outer[n] = nnz;
+      PermutationMatrix<Dynamic,Dynamic,StorageIndex> perm;
+      minimum_degree_ordering(C, perm);
+      for(StorageIndex k = 0; k < n; ++k)
+        order.push_back(labels[perm.indices()(k)]);
+    }
+
+    // labels the connected components of g, and returns their number
+    StorageIndex components(const Graph& g, IndexList& comp) const
+    {
+      const StorageIndex n = g.size();
+      std::fill(comp.begin(), comp.end(), StorageIndex(-1));
+      IndexList queue(n);
+      StorageIndex ncomp = 0;
+      for(StorageIndex s = 0; s < n; ++s)
+      {
+        if(comp[s] != -1) continue;
+        StorageIndex head = 0, tail = 0;
+        queue[tail++] = s;
+        comp[s] = ncomp;
+        while(head < tail)
+        {
+          StorageIndex v = queue[head++];
+          for(StorageIndex e = g.xadj[v]; e < g.xadj[v+1]; ++e)
+          {
+            StorageIndex u = g.adjncy[e];
+            if(comp[u] == -1)
+            {
+              comp[u] = ncomp;
+              queue[tail++] = u;
+            }
+          }
+        }
+        ++ncomp;
+      }
+      return ncomp;
+    }
+
+    // the subgraph of g induced by vertices, with unit weights; local is a workspace of size g.size() filled
+    // with -1, which is restored on exit
+    void extract(const Graph& g, const IndexList& labels, const IndexList& vertices, IndexList& local, Graph& sub, IndexList& subLabels) const
+    {
+      const StorageIndex m = StorageIndex(vertices.size());
+      for(StorageIndex k = 0; k < m; ++k)
+        local[vertices[k]] = k;
+      sub.xadj.resize(m+1);
+      sub.xadj[0] = 0;
+      sub.adjncy.clear();
+      subLabels.resize(m);
+      for(StorageIndex k = 0; k < m; ++k)
+      {
+        StorageIndex v = vertices[k];
+        subLabels[k] = labels[v];
+        for(StorageIndex e = g.xadj[v]; e < g.xadj[v+1]; ++e)
+          if(local[g.adjncy[e]] != -1)
+            sub.adjncy.push_back(local[g.adjncy[e]]);
+        sub.xadj[k+1] = StorageIndex(sub.adjncy.size());
+      }
+      for(StorageIndex k = 0; k < m; ++k)
+        local[vertices[k]] = -1;
+      sub.adjwgt.assign(sub.adjncy.size(), 1);
+      sub.vwgt.assign(m, 1);
+      sub.totalWeight = m;
+    }
+
+    // coarsens g into cg by a heavy edge matching, cmap maps the vertices of g to the ones of cg
+    void coarsen(const Graph& g, IndexList& cmap, Graph& cg)
+    {
+      const StorageIndex n = g.size();
+      const StorageIndex maxWeight = (std::max)(StorageIndex(1), StorageIndex(1.5 * double(g.totalWeight) / double(m_coarsenTo)));
+      IndexList perm(n), match(n, -1), rep;
+      for(StorageIndex v = 0; v < n; ++v) perm[v] = v;
+      for(StorageIndex v = n-1; v > 0; --v) std::swap(perm[v], perm[random(v+1)]);
+      cmap.resize(n);
+      for(StorageIndex k = 0; k < n; ++k)
+      {
+        StorageIndex v = perm[k];
+        if(match[v] != -1) continue;
+        StorageIndex best = v, bestWeight = -1;
+        for(StorageIndex e = g.xadj[v]; e < g.xadj[v+1]; ++e)
+        {
+          StorageIndex u = g.adjncy[e];
+          if(match[u] == -1 && u != v && g.adjwgt[e] > bestWeight && g.vwgt[v] + g.vwgt[u] <= maxWeight)
+          {
+            best = u;
+            bestWeight = g.adjwgt[e];
+          }
+        }
+        match[v] = best;
+        match[best] = v;
+        cmap[v] = cmap[best] = StorageIndex(rep.size());
+        rep.push_back(v);
+      }
+
+      const StorageIndex cn = StorageIndex(rep.size());
+      IndexList pos(cn, -1);
+      cg.xadj.resize(cn+1);
+      cg.xadj[0] = 0;
+      cg.adjncy.clear();
+      cg.adjwgt.clear();
+      cg.vwgt.resize(cn);
+      cg.totalWeight = g.totalWeight;
+      for(StorageIndex c = 0; c < cn; ++c)
+      {
+        StorageIndex vs[2] = { rep[c], match[rep[c]] };
+        const int nv = vs[0] == vs[1] ? 1 : 2;
+        cg.vwgt[c] = 0;
+        for(int i = 0; i < nv; ++i)
+        {
+          StorageIndex v = vs[i];
+          cg.vwgt[c] += g.vwgt[v];
+          for(StorageIndex e = g.xadj[v]; e < g.xadj[v+1]; ++e)
+          {
+            StorageIndex cu = cmap[g.adjncy[e]];
+            if(cu == c) continue;
+            if(pos[cu] == -1)
+            {
+              pos[cu] = StorageIndex(cg.adjncy.size());
+              cg.adjncy.push_back(cu);
+              cg.adjwgt.push_back(g.adjwgt[e]);
+            }
+            else
+              cg.adjwgt[pos[cu]] += g.adjwgt[e];
+          }
+        }
+        cg.xadj[c+1] = StorageIndex(cg.adjncy.size());
+        for(StorageIndex e = cg.xadj[c]; e < cg.xadj[c+1]; ++e)
+          pos[cg.adjncy[e]] = -1;
+      }
+    }
+
+    StorageIndex edgeCut(const Graph& g, const IndexList& where) const
+    {
+      StorageIndex cut = 0;
+      for(StorageIndex v = 0; v < g.size(); ++v)
+        for(StorageIndex e = g.xadj[v]; e < g.xadj[v+1]; ++e)
+          if(where[g.adjncy[e]] != where[v])
+            cut += g.adjwgt[e];
+      return cut/2;
+    }
+
+    // bisects the coarsest graph by growing a region from random vertices
+    void initialPartition(const Graph& g, IndexList& where)
+    {
+      const StorageIndex n = g.size();
+      IndexList trial(n), queue(n);
+      std::vector<bool> queued(n);
+      StorageIndex bestCut = -1;
+      for(int t = 0; t < 8; ++t)
+      {
+        std::fill(trial.begin(), trial.end(), StorageIndex(1));
+        std::fill(queued.begin(), queued.end(), false);
+        StorageIndex weight = 0, head = 0, tail = 0;
+        while(2*weight < g.totalWeight)
+        {
+          if(head == tail)
+          {
+            // start from a random vertex of the remaining part
+            StorageIndex s = random(n);
+            while(trial[s] == 0) s = (s+1) % n;
+            queue[tail++] = s;
+            queued[s] = true;
+          }
+          StorageIndex v = queue[head++];
+          trial[v] = 0;
+          weight += g.vwgt[v];
+          for(StorageIndex e = g.xadj[v]; e < g.xadj[v+1]; ++e)
+            if(!queued[g.adjncy[e]])
+            {
+              queued[g.adjncy[e]] = true;
+              queue[tail++] = g.adjncy[e];
+            }
+        }
+        refine(g, trial);
+        StorageIndex cut = edgeCut(g, trial);
+        if(bestCut == -1 || cut < bestCut)
+        {
+          bestCut = cut;
+          where = trial;
+        }
+      }
+    }
+
+    // Fiduccia-Mattheyses refinement of the bisection where, minimizing the edge cut under a balance constraint
+    void refine(const Graph& g, IndexList& where) const
+    {
+      typedef std::pair<StorageIndex,StorageIndex> Entry;
+      const StorageIndex n = g.size();
+      StorageIndex maxVertexWeight = 0;
+      for(StorageIndex v = 0; v < n; ++v) maxVertexWeight = (std::max)(maxVertexWeight, g.vwgt[v]);
+      // the heaviest part can exceed half of the total weight by 3%, or by the heaviest vertex
+      const StorageIndex maxPartWeight = g.totalWeight/2 + (std::max)(maxVertexWeight, StorageIndex(0.03*double(g.totalWeight)));
+
+      IndexList id(n, 0), ed(n, 0);
+      StorageIndex pw[2] = {0, 0};
+      StorageIndex cut = 0;
+      for(StorageIndex v = 0; v < n; ++v)
+      {
+        pw[where[v]] += g.vwgt[v];
+        for(StorageIndex e = g.xadj[v]; e < g.xadj[v+1]; ++e)
+          (where[g.adjncy[e]] == where[v] ? id[v] : ed[v]) += g.adjwgt[e];
+        cut += ed[v];
+      }
+      cut /= 2;
+
+      std::vector<bool> locked(n, false);
+      IndexList moves;
+      const StorageIndex maxUselessMoves = (std::max)(StorageIndex(50), StorageIndex(n/50));
+      for(int pass = 0; pass < 8; ++pass)
+      {
+        // binary heaps of the gains of the boundary vertices of each part, with lazy deletion
+        std::vector<Entry> heaps[2];
+        for(StorageIndex v = 0; v < n; ++v)
+          if(ed[v] > 0)
+            heaps[where[v]].push_back(Entry(ed[v]-id[v], v));
+        std::make_heap(heaps[0].begin(), heaps[0].end());
+        std::make_heap(heaps[1].begin(), heaps[1].end());
+        moves.clear();
+        StorageIndex bestCut = cut, bestMoves = 0;
+        StorageIndex bestImbalance = numext::abs(pw[0]-pw[1]);
+        bool bestBalanced = (std::max)(pw[0],pw[1]) <= maxPartWeight;
+        while(StorageIndex(moves.size()) - bestMoves < maxUselessMoves)
+        {
+          // the best move of each part, whose destination part remains balanced
+          StorageIndex cand[2] = {-1, -1};
+          for(int p = 0; p < 2; ++p)
+          {
+            while(!heaps[p].empty())
+            {
+              Entry top = heaps[p].front();
+              StorageIndex v = top.second;
+              if(!locked[v] && where[v] == p && top.first == ed[v]-id[v])
+                break;
+              std::pop_heap(heaps[p].begin(), heaps[p].end());
+              heaps[p].pop_back();
+            }
+            if(!heaps[p].empty() && pw[1-p] + g.vwgt[heaps[p].front().second] <= maxPartWeight)
+              cand[p] = heaps[p].front().second;
+          }
+          int from;
+          if(cand[0] == -1 && cand[1] == -1) break;
+          else if(cand[0] == -1) from = 1;
+          else if(cand[1] == -1) from = 0;
+          else if(pw[0] > maxPartWeight) from = 0;
+          else if(pw[1] > maxPartWeight) from = 1;
+          else
+          {
+            StorageIndex g0 = ed[cand[0]]-id[cand[0]], g1 = ed[cand[1]]-id[cand[1]];
+            from = (g0 > g1 || (g0 == g1 && pw[0] >= pw[1])) ? 0 : 1;
+          }
+          StorageIndex v = cand[from];
+          std::pop_heap(heaps[from].begin(), heaps[from].end());
+          heaps[from].pop_back();
+          cut -= ed[v]-id[v];
+          move(g, v, where, id, ed, pw);
+          locked[v] = true;
+          moves.push_back(v);
+          for(StorageIndex e = g.xadj[v]; e < g.xadj[v+1]; ++e)
+          {
+            StorageIndex u = g.adjncy[e];
+            if(!locked[u] && ed[u] > 0)
+            {
+              heaps[where[u]].push_back(Entry(ed[u]-id[u], u));
+              std::push_heap(heaps[where[u]].begin(), heaps[where[u]].end());
+            }
+          }
+
+          bool balanced = (std::max)(pw[0],pw[1]) <= maxPartWeight;
+          StorageIndex imbalance = numext::abs(pw[0]-pw[1]);
+          if((balanced && !bestBalanced) || (balanced == bestBalanced && (cut < bestCut || (cut == bestCut && imbalance < bestImbalance))))
+          {
+            bestCut = cut;
+            bestMoves = StorageIndex(moves.size());
+            bestImbalance = imbalance;
+            bestBalanced = balanced;
+          }
+        }
+        // roll back the moves after the best state
+        for(StorageIndex k = StorageIndex(moves.size())-1; k >= bestMoves; --k)
+        {
+          StorageIndex v = moves[k];
+          cut -= ed[v]-id[v];
+          move(g, v, where, id, ed, pw);
+        }
+        for(std::size_t k = 0; k < moves.size(); ++k)
+          locked[moves[k]] = false;
+        if(bestMoves == 0)
+          break;
+      }
+    }
+
+    // moves v to the other part, and updates the internal and external degrees
+    void move(const Graph& g, StorageIndex v, IndexList& where, IndexList& id, IndexList& ed, StorageIndex* pw) const
+    {
+      const StorageIndex to = 1 - where[v];
+      pw[where[v]] -= g.vwgt[v];
+      pw[to] += g.vwgt[v];
+      where[v] = to;
+      std::swap(id[v], ed[v]);
+      for(StorageIndex e = g.xadj[v]; e < g.xadj[v+1]; ++e)
+      {
+        StorageIndex u = g.adjncy[e];
+        if(where[u] == to) { id[u] += g.adjwgt[e]; ed[u] -= g.adjwgt[e]; }
+        else               { id[u] -= g.adjwgt[e]; ed[u] += g.adjwgt[e]; }
+      }
+    }
+
+    // multilevel bisection of g
+    void bisect(const Graph& g, IndexList& where)
+    {
+      std::vector<Graph> levels;
+      std::vector<IndexList> cmaps;
+      while(true)
+      {
+        const Graph& fine = levels.empty() ? g : levels.back();
+        if(fine.size() <= m_coarsenTo) break;
+        Graph coarse;
+        IndexList cmap;
+        coarsen(fine, cmap, coarse);
+        // stop when the matching does not reduce the graph anymore
+        if(double(coarse.size()) > 0.95 * double(fine.size())) break;
+        levels.push_back(Graph());
+        levels.back().swap(coarse);
+        cmaps.push_back(IndexList());
+        cmaps.back().swap(cmap);
+      }
+
+      initialPartition(levels.empty() ? g : levels.back(), where);
+      for(Index l = Index(levels.size())-1; l >= 0; --l)
+      {
+        const Graph& fine = l == 0 ? g : levels[l-1];
+        IndexList fineWhere(fine.size());
+        for(StorageIndex v = 0; v < fine.size(); ++v)
+          fineWhere[v] = where[cmaps[l][v]];
+        where.swap(fineWhere);
+        refine(fine, where);
+      }
+    }
+
+    // turns the edge separator of the bisection where into a minimum vertex cover of the cut edges, whose vertices
+    // are moved to the part 2 (König's theorem)
+    void separator(const Graph& g, IndexList& where) const
+    {
+      const StorageIndex n = g.size();
+      IndexList left, index(n, -1);
+      StorageIndex nright = 0;
+      for(StorageIndex v = 0; v < n; ++v)
+        for(StorageIndex e = g.xadj[v]; e < g.xadj[v+1]; ++e)
+          if(where[g.adjncy[e]] != where[v])
+          {
+            if(where[v] == 0) { index[v] = StorageIndex(left.size()); left.push_back(v); }
+            else              index[v] = nright++;
+            break;
+          }
+      const StorageIndex nleft = StorageIndex(left.size());
+
+      // maximum matching of the bipartite graph of the cut edges, by breadth-first augmenting paths
+      IndexList matchLeft(nleft, -1), matchRight(nright, -1), parent(nright), visited(nright, -1), queue(nleft);
+      for(StorageIndex l = 0; l < nleft; ++l)
+      {
+        StorageIndex v = left[l];
+        for(StorageIndex e = g.xadj[v]; e < g.xadj[v+1] && matchLeft[l] == -1; ++e)
+        {
+          StorageIndex u = g.adjncy[e];
+          if(where[u] == 1 && matchRight[index[u]] == -1)
+          {
+            matchLeft[l] = index[u];
+            matchRight[index[u]] = l;
+          }
+        }
+      }
+      for(StorageIndex l = 0; l < nleft; ++l)
+      {
+        if(matchLeft[l] != -1) continue;
+        StorageIndex head = 0, tail = 0, found = -1;
+        queue[tail++] = l;
+        while(head < tail && found == -1)
+        {
+          StorageIndex x = queue[head++], v = left[x];
+          for(StorageIndex e = g.xadj[v]; e < g.xadj[v+1]; ++e)
+          {
+            StorageIndex u = g.adjncy[e];
+            if(where[u] != 1) continue;
+            StorageIndex r = index[u];
+            if(visited[r] == l) continue;
+            visited[r] = l;
+            parent[r] = x;
+            if(matchRight[r] == -1) { found = r; break; }
+            queue[tail++] = matchRight[r];
+          }
+        }
+        // augment along the path
+        while(found != -1)
+        {
+          StorageIndex x = parent[found], next = matchLeft[x];
+          matchLeft[x] = found;
+          matchRight[found] = x;
+          found = next;
+        }
+      }
+
+      // the vertices reachable from the unmatched left vertices by alternating paths
+      std::vector<bool> reachedLeft(nleft, false), reachedRight(nright, false);
+      StorageIndex head = 0, tail = 0;
+      for(StorageIndex l = 0; l < nleft; ++l)
+        if(matchLeft[l] == -1) { reachedLeft[l] = true; queue[tail++] = l; }
+      while(head < tail)
+      {
+        StorageIndex v = left[queue[head++]];
+        for(StorageIndex e = g.xadj[v]; e < g.xadj[v+1]; ++e)
+        {
+          StorageIndex u = g.adjncy[e];
+          if(where[u] != 1 || reachedRight[index[u]]) continue;
+          reachedRight[index[u]] = true;
+          StorageIndex x = matchRight[index[u]];
+          if(x != -1 && !reachedLeft[x]) { reachedLeft[x] = true; queue[tail++] = x; }
+        }
+      }
+      for(StorageIndex v = 0; v < n; ++v)
+      {
+        if(index[v] == -1) continue;
+        if(where[v] == 0 ? !reachedLeft[index[v]] : bool(reachedRight[index[v]]))
+          where[v] = 2;
+      }
+    }
+
+    Index m_leafSize, m_coarsenTo;
+    unsigned int m_seed;
+};
+
+/** \internal
+  * \ingroup OrderingMethods_Module
+  * Computes the nested dissection ordering \a perm of the symmetric pattern \a C, whose upper and lower parts
+  * must both be stored. */
+template<typename Scalar, typename StorageIndex>
+void nested_dissection_ordering(const SparseMatrix<Scalar,ColMajor,StorageIndex>& C, PermutationMatrix<Dynamic,Dynamic,StorageIndex>& perm,
+                                Index leafSize, Index coarsenTo)
+{
+  typedef nd_graph<StorageIndex> Graph;
+  const StorageIndex n = StorageIndex(C.cols());
+  Graph g;
+  g.xadj.resize(n+1);
+  g.xadj[0] = 0;
+  for(StorageIndex j = 0; j < n; ++j)
+  {
+    for(typename SparseMatrix<Scalar,ColMajor,StorageIndex>::InnerIterator it(C,j); it; ++it)
+      if(it.index() != j)
+        g.adjncy.push_back(StorageIndex(it.index()));
+    g.xadj[j+1] = StorageIndex(g.adjncy.size());
+  }
+  g.adjwgt.assign(g.adjncy.size(), 1);
+  g.vwgt.assign(n, 1);
+  g.totalWeight = n;
+
+  std::vector<StorageIndex> labels(n), order;
+  for(StorageIndex j = 0; j < n; ++j) labels[j] = j;
+  order.reserve(n);
+  nested_dissection<StorageIndex> nd(leafSize, coarsenTo);
+  nd.dissect(g, labels, order);
+
+  perm.resize(n);
+  for(StorageIndex k = 0; k < n; ++k)
+    perm.indices()(k) = order[k];
+}
+
+} // end namespace internal
+
+/** \ingroup OrderingMethods_Module
+  * \class NestedDissectionOrdering
+  *
+  * Functor computing a \em nested \em dissection ordering, without any external dependency
+  *
+  * The graph of the matrix is recursively split by small vertex separators, which are numbered after the two
+  * parts they separate. The separators are computed by a multilevel graph bisection (heavy edge matching,
+  * region growing and Fiduccia-Mattheyses refinement), and the subgraphs with less than leafSize() vertices are
+  * ordered by the approximate minimum degree. For the large matrices coming from 3D meshes, this usually
+  * reduces the number of operations of the factorization compared to AMDOrdering, at the price of a more
+  * expensive ordering.
+  *
+  * If the matrix is not structurally symmetric, an ordering of A^T+A is computed.
+  *
+  * \tparam  StorageIndex The type of indices of the matrix
+  * \sa AMDOrdering, MetisOrdering
+  */
+template <typename StorageIndex>
+class NestedDissectionOrdering
+{
+  public:
+    typedef PermutationMatrix<Dynamic, Dynamic, StorageIndex> PermutationType;
+
+    NestedDissectionOrdering() : m_leafSize(200), m_coarsenTo(100) {}
+
+    /** Sets the size below which the subgraphs are ordered by the approximate minimum degree (default is 200) */
+    void setLeafSize(Index leafSize) { m_leafSize = (std::max)(leafSize, Index(1)); }
+
+    /** \returns the size below which the subgraphs are ordered by the approximate minimum degree */
+    Index leafSize() const { return m_leafSize; }
+
+    /** Compute the permutation vector from a sparse matrix
+     * This routine is much faster if the input matrix is column-major
+     */
+    template <typename MatrixType>
+    void operator()(const MatrixType& mat, PermutationType& perm)
+    {
+      // Compute the symmetric pattern
+      SparseMatrix<typename MatrixType::Scalar, ColMajor, StorageIndex> symm;
+      internal::ordering_helper_at_plus_a(mat,symm);
+
+      internal::nested_dissection_ordering(symm, perm, m_leafSize, m_coarsenTo);
+    }
+
+    /** Compute the permutation with a selfadjoint matrix */
+    template <typename SrcType, unsigned int SrcUpLo>
+    void operator()(const SparseSelfAdjointView<SrcType, SrcUpLo>& mat, PermutationType& perm)
+    {
+      SparseMatrix<typename SrcType::Scalar, ColMajor, StorageIndex> C; C = mat;
+
+      internal::nested_dissection_ordering(C, perm, m_leafSize, m_coarsenTo);
+    }
+
+  protected:
+    Index m_leafSize, m_coarsenTo;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_NESTED_DISSECTION_H
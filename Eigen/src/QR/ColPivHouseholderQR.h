@@ -432,6 +432,10 @@ template<typename _MatrixType> class ColPivHouseholderQR
     }
 
     void computeInPlace();
+    Index pivotColumn(Index k, RealScalar threshold_helper, Index& number_of_transpositions);
+    template<typename WorkMatrixType, typename WorkVectorType>
+    Index computePanel(Index k, Index blockSize, WorkMatrixType& F, WorkVectorType& aux, RealScalar threshold_helper,
+                       RealScalar norm_downdate_threshold, Index& number_of_transpositions);
 
     MatrixType m_qr;
     HCoeffsType m_hCoeffs;
@@ -514,27 +518,24 @@ void ColPivHouseholderQR<MatrixType>::computeInPlace()
   m_nonzero_pivots = size; // the generic case is that in which all pivots are nonzero (invertible case)
   m_maxpivot = RealScalar(0);
 
+  // Large matrices are factored by panels of BlockSize columns, until the trailing matrix
+  // is small enough to be handled by the unblocked algorithm.
+  enum { BlockSize = 32 };
+  const bool blocked = MaxColsAtCompileTime==Dynamic && MaxRowsAtCompileTime==Dynamic;
+  Matrix<Scalar,Dynamic,Dynamic> F;
+  Matrix<Scalar,Dynamic,1> aux;
+
   for(Index k = 0; k < size; ++k)
   {
-    // first, we look up in our table m_colNormsUpdated which column has the biggest norm
-    Index biggest_col_index;
-    RealScalar biggest_col_sq_norm = numext::abs2(m_colNormsUpdated.tail(cols-k).maxCoeff(&biggest_col_index));
-    biggest_col_index += k;
-
-    // Track the number of meaningful pivots but do not stop the decomposition to make
-    // sure that the initial matrix is properly reproduced. See bug 941.
-    if(m_nonzero_pivots==size && biggest_col_sq_norm < threshold_helper * RealScalar(rows-k))
-      m_nonzero_pivots = k;
-
-    // apply the transposition to the columns
-    m_colsTranspositions.coeffRef(k) = biggest_col_index;
-    if(k != biggest_col_index) {
-      m_qr.col(k).swap(m_qr.col(biggest_col_index));
-      std::swap(m_colNormsUpdated.coeffRef(k), m_colNormsUpdated.coeffRef(biggest_col_index));
-      std::swap(m_colNormsDirect.coeffRef(k), m_colNormsDirect.coeffRef(biggest_col_index));
-      ++number_of_transpositions;
+    if(blocked && (std::min)(rows-k, cols-k) > 2*Index(BlockSize))
+    {
+      k += computePanel(k, BlockSize, F, aux, threshold_helper, norm_downdate_threshold, number_of_transpositions) - 1;
+      continue;
     }
 
+    // first, we look up in our table m_colNormsUpdated which column has the biggest norm
+    pivotColumn(k, threshold_helper, number_of_transpositions);
+
     // generate the householder vector, store it below the diagonal
     RealScalar beta;
     m_qr.col(k).tail(rows-k).makeHouseholderInPlace(m_hCoeffs.coeffRef(k), beta);
@@ -581,6 +582,140 @@ void ColPivHouseholderQR<MatrixType>::computeInPlace()
   m_isInitialized = true;
 }
 
+/** \internal Looks up the column of biggest norm among the columns k,...,cols-1, and swaps it with the column \a k.
+  * \returns the index of the selected column */
+template<typename MatrixType>
+Index ColPivHouseholderQR<MatrixType>::pivotColumn(Index k, RealScalar threshold_helper, Index& number_of_transpositions)
+{
+  Index rows = m_qr.rows();
+  Index cols = m_qr.cols();
+  Index size = m_qr.diagonalSize();
+
+  Index biggest_col_index;
+  RealScalar biggest_col_sq_norm = numext::abs2(m_colNormsUpdated.tail(cols-k).maxCoeff(&biggest_col_index));
+  biggest_col_index += k;
+
+  // Track the number of meaningful pivots but do not stop the decomposition to make
+  // sure that the initial matrix is properly reproduced. See bug 941.
+  if(m_nonzero_pivots==size && biggest_col_sq_norm < threshold_helper * RealScalar(rows-k))
+    m_nonzero_pivots = k;
+
+  // apply the transposition to the columns
+  m_colsTranspositions.coeffRef(k) = biggest_col_index;
+  if(k != biggest_col_index) {
+    m_qr.col(k).swap(m_qr.col(biggest_col_index));
+    std::swap(m_colNormsUpdated.coeffRef(k), m_colNormsUpdated.coeffRef(biggest_col_index));
+    std::swap(m_colNormsDirect.coeffRef(k), m_colNormsDirect.coeffRef(biggest_col_index));
+    ++number_of_transpositions;
+  }
+  return biggest_col_index;
+}
+
+/** \internal Factors at most \a blockSize columns starting at \a k, as LAPACK's laqps, and updates the trailing matrix.
+  *
+  * The trailing matrix is not updated after each reflector. Instead, the updates are accumulated as
+  * \f$ A - V F^* \f$, where \a V holds the reflectors of the panel and \a F is built column by column.
+  * Only the current column, and the row of the trailing matrix needed to downdate the column norms, are
+  * updated within the panel. The rest of the trailing matrix is then updated by a single matrix product.
+  * The panel stops early when a column norm has to be recomputed, since the columns are not up to date.
+  *
+  * \returns the number of factored columns
+  */
+template<typename MatrixType>
+template<typename WorkMatrixType, typename WorkVectorType>
+Index ColPivHouseholderQR<MatrixType>::computePanel(Index k, Index blockSize, WorkMatrixType& F, WorkVectorType& aux,
+                                                    RealScalar threshold_helper, RealScalar norm_downdate_threshold,
+                                                    Index& number_of_transpositions)
+{
+  using std::abs;
+  Index rows = m_qr.rows();
+  Index cols = m_qr.cols();
+
+  // the row i of F corresponds to the column k+i
+  F.setZero(cols-k, blockSize);
+  aux.resize(blockSize);
+  Index kb = 0;
+  bool recompute_norms = false;
+  while(kb < blockSize && !recompute_norms)
+  {
+    const Index j = kb;
+    const Index rk = k+j;
+    const Index remainingRows = rows-rk;
+    const Index remainingCols = cols-rk-1;
+
+    Index biggest_col_index = pivotColumn(rk, threshold_helper, number_of_transpositions);
+    if(biggest_col_index != rk)
+      F.row(j).head(j).swap(F.row(biggest_col_index-k).head(j));
+
+    // apply the previous reflectors of the panel to the current column
+    if(j>0)
+      m_qr.col(rk).tail(remainingRows).noalias() -= m_qr.block(rk, k, remainingRows, j) * F.row(j).head(j).adjoint();
+
+    // generate the householder vector, store it below the diagonal
+    RealScalar beta;
+    m_qr.col(rk).tail(remainingRows).makeHouseholderInPlace(m_hCoeffs.coeffRef(rk), beta);
+
+    // remember the maximum absolute value of diagonal coefficients
+    if(abs(beta) > m_maxpivot) m_maxpivot = abs(beta);
+
+    m_qr.coeffRef(rk,rk) = Scalar(1);
+    if(remainingCols>0)
+    {
+      // F(:,j) = conj(tau) (A^* v - F V^* v)
+      F.col(j).tail(remainingCols).noalias() = m_qr.block(rk, rk+1, remainingRows, remainingCols).adjoint()
+                                             * m_qr.col(rk).tail(remainingRows);
+      if(j>0)
+      {
+        aux.head(j).noalias() = m_qr.block(rk, k, remainingRows, j).adjoint() * m_qr.col(rk).tail(remainingRows);
+        F.col(j).tail(remainingCols).noalias() -= F.block(j+1, 0, remainingCols, j) * aux.head(j);
+      }
+      F.col(j).tail(remainingCols) *= numext::conj(m_hCoeffs.coeff(rk));
+
+      // update the current row of the trailing matrix
+      m_qr.row(rk).tail(remainingCols).noalias() -= m_qr.row(rk).segment(k, j+1)
+                                                  * F.block(j+1, 0, remainingCols, j+1).adjoint();
+    }
+    m_qr.coeffRef(rk,rk) = beta;
+    ++kb;
+
+    // update our table of norms of the columns, see computeInPlace()
+    for (Index c = rk + 1; c < cols; ++c) {
+      if (m_colNormsUpdated.coeffRef(c) > RealScalar(0)) {
+        RealScalar temp = abs(m_qr.coeffRef(rk, c)) / m_colNormsUpdated.coeffRef(c);
+        temp = (RealScalar(1) + temp) * (RealScalar(1) - temp);
+        temp = temp <  RealScalar(0) ? RealScalar(0) : temp;
+        RealScalar temp2 = temp * numext::abs2<RealScalar>(m_colNormsUpdated.coeffRef(c) /
+                                                           m_colNormsDirect.coeffRef(c));
+        if (temp2 <= norm_downdate_threshold) {
+          // The column is not up to date yet: flag its norm to be recomputed after the update
+          // of the trailing matrix, and stop the panel here.
+          m_colNormsUpdated.coeffRef(c) = RealScalar(-1);
+          recompute_norms = true;
+        } else {
+          m_colNormsUpdated.coeffRef(c) *= numext::sqrt(temp);
+        }
+      }
+    }
+  }
+
+  // update the trailing matrix below the rows of the panel
+  const Index next = k+kb;
+  if(next<rows && next<cols)
+    m_qr.bottomRightCorner(rows-next, cols-next).noalias() -= m_qr.block(next, k, rows-next, kb)
+                                                            * F.block(kb, 0, cols-next, kb).adjoint();
+
+  if(recompute_norms)
+  {
+    for (Index c = next; c < cols; ++c) {
+      if (m_colNormsUpdated.coeffRef(c) < RealScalar(0)) {
+        m_colNormsDirect.coeffRef(c) = m_qr.col(c).tail(rows - next).norm();
+        m_colNormsUpdated.coeffRef(c) = m_colNormsDirect.coeffRef(c);
+      }
+    }
+  }
+  return kb;
+}
+
 #ifndef EIGEN_PARSED_BY_DOXYGEN
 template<typename _MatrixType>
 template<typename RhsType, typename DstType>
@@ -423,6 +423,97 @@ struct svd_precondition_2x2_block_to_be_real<MatrixType, QRPreconditioner, true>
   }
 };
 
+/*** One-sided Jacobi iteration
+ ***
+ *** The columns of a square matrix X are made orthogonal by rotating pairs of columns, X A = B S, which only
+ *** touches contiguous columns and lets the disjoint pairs of a round-robin ordering be rotated concurrently.
+ ***/
+
+// Rotates the pairs (m_pairs[2k], m_pairs[2k+1]) for k in [start,start+length) to make them orthogonal, which can be done
+// from several threads since the pairs are disjoint. Indices out of range denote the dummy player of odd sizes.
+// The norms of the columns are cached in m_norms. Like in LAPACK's xGESVJ, the rotations are computed from the cosine
+// of the angle between the two columns and the ratio of their norms, which avoids the underflow of the squared norms.
+template<typename WorkMatrixType>
+struct jacobi_svd_one_sided_rotations
+{
+  typedef typename WorkMatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<RealScalar,Dynamic,1> RealVectorType;
+
+  jacobi_svd_one_sided_rotations(WorkMatrixType& work, WorkMatrixType& accumulator, RealVectorType& norms,
+                                 const std::vector<Index>& pairs, std::vector<unsigned char>& rotated,
+                                 const RealScalar& tolerance, const RealScalar& considerAsZero)
+    : m_work(work), m_accumulator(accumulator), m_norms(norms), m_pairs(pairs), m_rotated(rotated),
+      m_tolerance(tolerance), m_considerAsZero(considerAsZero)
+  {}
+
+  void operator()(Index start, Index length) const
+  {
+    using std::abs;
+    using std::sqrt;
+    const Index n = m_work.cols();
+    for(Index k = start; k < start+length; ++k)
+    {
+      const Index p = m_pairs[2*k], q = m_pairs[2*k+1];
+      m_rotated[k] = 0;
+      if(p>=n || q>=n)
+        continue;
+      const RealScalar np = m_norms.coeff(p);
+      const RealScalar nq = m_norms.coeff(q);
+      if(!(np>m_considerAsZero && nq>m_considerAsZero))
+        continue;
+      // the cosine of the angle between the two columns, whose dot product would underflow when their norms are tiny
+      const Scalar gamma = (np*nq > m_considerAsZero/NumTraits<RealScalar>::epsilon())
+                         ? Scalar((m_work.col(p).dot(m_work.col(q)) / np) / nq)
+                         : Scalar((m_work.col(p)/np).dot(m_work.col(q)/nq));
+      const RealScalar cosine = abs(gamma);
+      // the test is relative to the norms of the columns, so that small singular values are computed to high
+      // relative accuracy, and evaluates to false if any NaN is involved
+      if(cosine > m_tolerance)
+      {
+        // diagonalize the Gram matrix [np^2 g; conj(g) nq^2], g = np nq gamma, of the two columns, whose rotation
+        // angle theta satisfies cot(2 theta) = (np/nq - nq/np) / (2 cosine), see JacobiRotation::makeJacobi
+        RealScalar tau = (np/nq - nq/np) / (RealScalar(2)*cosine);
+        RealScalar t;
+        if(abs(tau) > RealScalar(1)/NumTraits<RealScalar>::epsilon())
+          t = RealScalar(0.5) / tau;
+        else
+          t = tau>RealScalar(0) ? RealScalar(1)/(tau+sqrt(numext::abs2(tau)+RealScalar(1)))
+                                : RealScalar(1)/(tau-sqrt(numext::abs2(tau)+RealScalar(1)));
+        RealScalar c = RealScalar(1) / sqrt(numext::abs2(t)+RealScalar(1));
+        JacobiRotation<Scalar> j(c, -numext::conj(gamma)/cosine * t * c);
+        m_work.applyOnTheRight(p, q, j);
+        if(m_accumulator.size()>0) m_accumulator.applyOnTheRight(p, q, j);
+        m_rotated[k] = 1;
+
+        // the new squared norms are the diagonal entries np^2 + t|gamma| and nq^2 - t|gamma| of the rotated Gram matrix,
+        // unless the cancellation makes them inaccurate
+        RealScalar fp = RealScalar(1) + t * cosine * (nq/np);
+        RealScalar fq = RealScalar(1) - t * cosine * (np/nq);
+        m_norms.coeffRef(p) = fp > RealScalar(0.5) ? np * sqrt(fp) : m_work.col(p).blueNorm();
+        m_norms.coeffRef(q) = fq > RealScalar(0.5) ? nq * sqrt(fq) : m_work.col(q).blueNorm();
+      }
+    }
+  }
+
+  WorkMatrixType& m_work;
+  WorkMatrixType& m_accumulator;
+  RealVectorType& m_norms;
+  const std::vector<Index>& m_pairs;
+  std::vector<unsigned char>& m_rotated;
+  RealScalar m_tolerance, m_considerAsZero;
+};
+
+// Orders column indices by decreasing norms, with NaN's last so that the ordering remains valid for std::sort
+template<typename RealScalar>
+struct jacobi_svd_decreasing_norms
+{
+  jacobi_svd_decreasing_norms(const RealScalar* norms) : m_norms(norms) {}
+  bool operator()(Index a, Index b) const { return key(m_norms[a]) > key(m_norms[b]); }
+  static RealScalar key(const RealScalar& x) { return (numext::isnan)(x) ? RealScalar(-1) : x; }
+  const RealScalar* m_norms;
+};
+
 template<typename _MatrixType, int QRPreconditioner> 
 struct traits<JacobiSVD<_MatrixType,QRPreconditioner> >
         : traits<_MatrixType>
@@ -467,6 +558,15 @@ struct traits<JacobiSVD<_MatrixType,QRPreconditioner> >
   * \a p is the greater dimension, meaning that it is still of the same order of complexity as the faster bidiagonalizing R-SVD algorithms.
   * In particular, like any R-SVD, it takes advantage of non-squareness in that its complexity is only linear in the greater dimension.
   *
+  * For matrices with a dynamic size whose smaller dimension is at least OneSidedThreshold, one-sided (Hestenes) Jacobi iterations
+  * are used instead, following Drmac and Veselic: the columns of the adjoint of the triangular factor \a R of the QR preconditioner
+  * (square matrices are first decomposed by ColPivHouseholderQR) are made orthogonal by rotations on the right only, and the
+  * singular values are the norms of the final columns. The rows of \a R being graded when the QR decomposition is pivoting, this is
+  * as accurate as the two-sided iteration, but each rotation updates two contiguous columns with vectorized code, and the
+  * pairs are visited in a round-robin order whose rounds consist of disjoint pairs that are rotated in parallel when multithreading
+  * is enabled (see \ref TopicMultiThreading). Before each sweep, the columns are sorted by decreasing norms (de Rijk's pivoting),
+  * which speeds up the convergence. Unlike the two-sided iteration, this path allocates its workspace at each call to compute().
+  *
   * If the input matrix has inf or nan coefficients, the result of the computation is undefined, but the computation is guaranteed to
   * terminate in finite (and reasonable) time.
   *
@@ -501,7 +601,9 @@ template<typename _MatrixType, int QRPreconditioner> class JacobiSVD
       MaxRowsAtCompileTime = MatrixType::MaxRowsAtCompileTime,
       MaxColsAtCompileTime = MatrixType::MaxColsAtCompileTime,
       MaxDiagSizeAtCompileTime = EIGEN_SIZE_MIN_PREFER_FIXED(MaxRowsAtCompileTime,MaxColsAtCompileTime),
-      MatrixOptions = MatrixType::Options
+      MatrixOptions = MatrixType::Options,
+      /** Smallest size of the square work matrix which is diagonalized by one-sided Jacobi iterations */
+      OneSidedThreshold = 48
     };
 
     typedef typename Base::MatrixUType MatrixUType;
@@ -580,6 +682,7 @@ template<typename _MatrixType, int QRPreconditioner> class JacobiSVD
 
   private:
     void allocate(Index rows, Index cols, unsigned int computationOptions);
+    void computeOneSided(const RealScalar& considerAsZero);
 
   protected:
     using Base::m_matrixU;
@@ -694,71 +797,80 @@ JacobiSVD<MatrixType, QRPreconditioner>::compute(const MatrixType& matrix, unsig
     if(m_computeThinV) m_matrixV.setIdentity(m_cols, m_diagSize);
   }
 
-  /*** step 2. The main Jacobi SVD iteration. ***/
-  RealScalar maxDiagEntry = m_workMatrix.cwiseAbs().diagonal().maxCoeff();
-
-  bool finished = false;
-  while(!finished)
+  if(MaxDiagSizeAtCompileTime==Dynamic && m_diagSize>=OneSidedThreshold)
   {
-    finished = true;
-
-    // do a sweep: for all index pairs (p,q), perform SVD of the corresponding 2x2 sub-matrix
+    /*** step 2'. The one-sided Jacobi SVD iteration, which directly yields positive singular values. ***/
+    computeOneSided(considerAsZero);
+  }
+  else
+  {
+    /*** step 2. The main Jacobi SVD iteration. ***/
+    RealScalar maxDiagEntry = m_workMatrix.cwiseAbs().diagonal().maxCoeff();
 
-    for(Index p = 1; p < m_diagSize; ++p)
+    bool finished = false;
+    while(!finished)
     {
-      for(Index q = 0; q < p; ++q)
+      finished = true;
+
+      // do a sweep: for all index pairs (p,q), perform SVD of the corresponding 2x2 sub-matrix
+
+      for(Index p = 1; p < m_diagSize; ++p)
       {
-        // if this 2x2 sub-matrix is not diagonal already...
-        // notice that this comparison will evaluate to false if any NaN is involved, ensuring that NaN's don't
-        // keep us iterating forever. Similarly, small denormal numbers are considered zero.
-        RealScalar threshold = numext::maxi<RealScalar>(considerAsZero, precision * maxDiagEntry);
-        if(abs(m_workMatrix.coeff(p,q))>threshold || abs(m_workMatrix.coeff(q,p)) > threshold)
+        for(Index q = 0; q < p; ++q)
         {
-          finished = false;
-          // perform SVD decomposition of 2x2 sub-matrix corresponding to indices p,q to make it diagonal
-          // the complex to real operation returns true if the updated 2x2 block is not already diagonal
-          if(internal::svd_precondition_2x2_block_to_be_real<MatrixType, QRPreconditioner>::run(m_workMatrix, *this, p, q, maxDiagEntry))
+          // if this 2x2 sub-matrix is not diagonal already...
+          // notice that this comparison will evaluate to false if any NaN is involved, ensuring that NaN's don't
+          // keep us iterating forever. Similarly, small denormal numbers are considered zero.
+          RealScalar threshold = numext::maxi<RealScalar>(considerAsZero, precision * maxDiagEntry);
+          if(abs(m_workMatrix.coeff(p,q))>threshold || abs(m_workMatrix.coeff(q,p)) > threshold)
           {
-            JacobiRotation<RealScalar> j_left, j_right;
-            internal::real_2x2_jacobi_svd(m_workMatrix, p, q, &j_left, &j_right);
-
-            // accumulate resulting Jacobi rotations
-            m_workMatrix.applyOnTheLeft(p,q,j_left);
-            if(computeU()) m_matrixU.applyOnTheRight(p,q,j_left.transpose());
-
-            m_workMatrix.applyOnTheRight(p,q,j_right);
-            if(computeV()) m_matrixV.applyOnTheRight(p,q,j_right);
-
-            // keep track of the largest diagonal coefficient
-            maxDiagEntry = numext::maxi<RealScalar>(maxDiagEntry,numext::maxi<RealScalar>(abs(m_workMatrix.coeff(p,p)), abs(m_workMatrix.coeff(q,q))));
+            finished = false;
+            // perform SVD decomposition of 2x2 sub-matrix corresponding to indices p,q to make it diagonal
+            // the complex to real operation returns true if the updated 2x2 block is not already diagonal
+            if(internal::svd_precondition_2x2_block_to_be_real<MatrixType, QRPreconditioner>::run(m_workMatrix, *this, p, q, maxDiagEntry))
+            {
+              JacobiRotation<RealScalar> j_left, j_right;
+              internal::real_2x2_jacobi_svd(m_workMatrix, p, q, &j_left, &j_right);
+
+              // accumulate resulting Jacobi rotations
+              m_workMatrix.applyOnTheLeft(p,q,j_left);
+              if(computeU()) m_matrixU.applyOnTheRight(p,q,j_left.transpose());
+
+              m_workMatrix.applyOnTheRight(p,q,j_right);
+              if(computeV()) m_matrixV.applyOnTheRight(p,q,j_right);
+
+              // keep track of the largest diagonal coefficient
+              maxDiagEntry = numext::maxi<RealScalar>(maxDiagEntry,numext::maxi<RealScalar>(abs(m_workMatrix.coeff(p,p)), abs(m_workMatrix.coeff(q,q))));
+            }
           }
         }
       }
     }
-  }
 
-  /*** step 3. The work matrix is now diagonal, so ensure it's positive so its diagonal entries are the singular values ***/
+    /*** step 3. The work matrix is now diagonal, so ensure it's positive so its diagonal entries are the singular values ***/
 
-  for(Index i = 0; i < m_diagSize; ++i)
-  {
-    // For a complex matrix, some diagonal coefficients might note have been
-    // treated by svd_precondition_2x2_block_to_be_real, and the imaginary part
-    // of some diagonal entry might not be null.
-    if(NumTraits<Scalar>::IsComplex && abs(numext::imag(m_workMatrix.coeff(i,i)))>considerAsZero)
+    for(Index i = 0; i < m_diagSize; ++i)
     {
-      RealScalar a = abs(m_workMatrix.coeff(i,i));
-      m_singularValues.coeffRef(i) = abs(a);
-      if(computeU()) m_matrixU.col(i) *= m_workMatrix.coeff(i,i)/a;
-    }
-    else
-    {
-      // m_workMatrix.coeff(i,i) is already real, no difficulty:
-      RealScalar a = numext::real(m_workMatrix.coeff(i,i));
-      m_singularValues.coeffRef(i) = abs(a);
-      if(computeU() && (a<RealScalar(0))) m_matrixU.col(i) = -m_matrixU.col(i);
+      // For a complex matrix, some diagonal coefficients might note have been
+      // treated by svd_precondition_2x2_block_to_be_real, and the imaginary part
+      // of some diagonal entry might not be null.
+      if(NumTraits<Scalar>::IsComplex && abs(numext::imag(m_workMatrix.coeff(i,i)))>considerAsZero)
+      {
+        RealScalar a = abs(m_workMatrix.coeff(i,i));
+        m_singularValues.coeffRef(i) = abs(a);
+        if(computeU()) m_matrixU.col(i) *= m_workMatrix.coeff(i,i)/a;
+      }
+      else
+      {
+        // m_workMatrix.coeff(i,i) is already real, no difficulty:
+        RealScalar a = numext::real(m_workMatrix.coeff(i,i));
+        m_singularValues.coeffRef(i) = abs(a);
+        if(computeU() && (a<RealScalar(0))) m_matrixU.col(i) = -m_matrixU.col(i);
+      }
     }
-  }
   
+  }
+
   m_singularValues *= scale;
 
   /*** step 4. Sort singular values in descending order and compute the number of nonzero singular values ***/
@@ -786,6 +898,129 @@ JacobiSVD<MatrixType, QRPreconditioner>::compute(const MatrixType& matrix, unsig
   return *this;
 }
 
+template<typename MatrixType, int QRPreconditioner>
+void JacobiSVD<MatrixType, QRPreconditioner>::computeOneSided(const RealScalar& considerAsZero)
+{
+  using std::sqrt;
+  typedef Matrix<Scalar,Dynamic,Dynamic> ColMajorMatrixType;
+  const Index n = m_diagSize;
+
+  // the rounding errors of the dot products prevent a better orthogonality than about sqrt(n)*epsilon
+  const RealScalar tolerance = sqrt(RealScalar(n)) * NumTraits<Scalar>::epsilon();
+
+  // Like in the algorithm of Drmac and Veselic, the iteration is applied to the columns of R^*, where R is the
+  // triangular factor of a QR decomposition, because the rows of R are graded when the QR decomposition is pivoting,
+  // which makes the iteration converge fast and accurately. When there are more columns than rows, the R-SVD step
+  // already made the work matrix W = R^*. Otherwise, W = Q R, where square matrices did not go through the R-SVD
+  // step and are decomposed here by ColPivHouseholderQR, W P = Q R, and the columns of R^* are used.
+  // In both cases, the iteration computes X A = B S, where X is the matrix whose columns are orthogonalized,
+  // A is the product of the rotations, and the columns of B are normalized.
+  const bool adjointWork = m_rows>=m_cols;
+  const bool accumulate = adjointWork ? computeU() : computeV();
+  const bool normalize = adjointWork ? computeV() : computeU();
+  ColMajorMatrixType work, q, accumulator;
+  typename ColPivHouseholderQR<ColMajorMatrixType>::PermutationType qrPerm;
+  if(m_rows==m_cols)
+  {
+    ColPivHouseholderQR<ColMajorMatrixType> qr(m_workMatrix);
+    work = qr.matrixR().template triangularView<Upper>().adjoint();
+    if(computeU()) q = qr.householderQ();
+    if(computeV()) qrPerm = qr.colsPermutation();
+  }
+  else if(adjointWork)
+  {
+    work = m_workMatrix.adjoint();
+  }
+  else
+  {
+    work = m_workMatrix;
+  }
+  if(accumulate) accumulator.setIdentity(n, n);
+
+  // in the round-robin ordering, the m players are paired in m/2 disjoint pairs at each of the m-1 rounds of a sweep,
+  // and player n is a dummy when n is odd
+  const Index m = n + (n%2);
+  std::vector<Index> players(m), pairs(m);
+  std::vector<unsigned char> rotated(m/2);
+  Matrix<RealScalar,Dynamic,1> norms(n);
+  PermutationMatrix<Dynamic,Dynamic,Index> perm(n);
+  internal::jacobi_svd_one_sided_rotations<ColMajorMatrixType> rotations(work, accumulator, norms, pairs, rotated,
+                                                                         tolerance, considerAsZero);
+  const double work_per_round = double(m/2) * double(n) * (accumulate ? 16 : 10);
+
+  // the convergence is quadratic, so that the bound on the number of sweeps, which is the one of LAPACK's xGESVJ,
+  // is only reached when rounding errors keep some cosines slightly above the tolerance
+  const Index maxSweeps = 30;
+  bool finished = false;
+  for(Index sweep = 0; !finished && sweep < maxSweeps; ++sweep)
+  {
+    finished = true;
+
+    // de Rijk's pivoting: sort the columns by decreasing norms, whose cached values are refreshed at each sweep
+    for(Index i = 0; i < n; ++i)
+      norms.coeffRef(i) = work.col(i).blueNorm();
+    perm.setIdentity();
+    std::sort(perm.indices().data(), perm.indices().data()+n,
+              internal::jacobi_svd_decreasing_norms<RealScalar>(norms.data()));
+    work = work * perm;
+    if(accumulate) accumulator = accumulator * perm;
+    norms = perm.transpose() * norms;
+
+    for(Index i = 0; i < m; ++i)
+      players[i] = i;
+    for(Index round = 0; round < m-1; ++round)
+    {
+      for(Index k = 0; k < m/2; ++k)
+      {
+        pairs[2*k]   = players[k];
+        pairs[2*k+1] = players[m-1-k];
+      }
+      internal::parallelize_range<true>(rotations, m/2, Index(1), work_per_round);
+      for(Index k = 0; k < m/2; ++k)
+        if(rotated[k]) finished = false;
+      // keep the first player and rotate the others
+      std::rotate(players.begin()+1, players.end()-1, players.end());
+    }
+  }
+
+  // the singular values are the norms of the columns of X, which are the columns of B once normalized
+  Index zeros = 0;
+  for(Index i = 0; i < n; ++i)
+  {
+    RealScalar a = work.col(i).blueNorm();
+    m_singularValues.coeffRef(i) = a;
+    if(a>considerAsZero) work.col(i) /= a;
+    else                 ++zeros;
+  }
+
+  if(normalize && zeros>0)
+  {
+    // complete the columns of B of the null singular values by an orthonormal basis of the orthogonal
+    // complement of the other ones
+    ColMajorMatrixType basis(n, n-zeros);
+    for(Index i = 0, j = 0; i < n; ++i)
+      if(m_singularValues.coeff(i)>considerAsZero) basis.col(j++) = work.col(i);
+    HouseholderQR<ColMajorMatrixType> qr(basis);
+    ColMajorMatrixType complement = qr.householderQ() * ColMajorMatrixType::Identity(n, n);
+    for(Index i = 0, j = n-zeros; i < n; ++i)
+      if(!(m_singularValues.coeff(i)>considerAsZero)) work.col(i) = complement.col(j++);
+  }
+
+  // W = (Q A) S (P B)^* when adjointWork is true, and W = B S A^* otherwise
+  const ColMajorMatrixType& unitaryU = adjointWork ? accumulator : work;
+  const ColMajorMatrixType& unitaryV = adjointWork ? work : accumulator;
+  if(computeU())
+  {
+    if(m_rows==m_cols) m_matrixU.leftCols(n) = q * unitaryU;
+    else               m_matrixU.leftCols(n) = m_matrixU.leftCols(n) * unitaryU;
+  }
+  if(computeV())
+  {
+    if(m_rows==m_cols) m_matrixV.leftCols(n) = qrPerm * unitaryV;
+    else               m_matrixV.leftCols(n) = m_matrixV.leftCols(n) * unitaryV;
+  }
+}
+
 /** \svd_module
   *
   * \return the singular value decomposition of \c *this computed by two-sided
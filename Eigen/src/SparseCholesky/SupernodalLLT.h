@@ -0,0 +1,549 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SUPERNODAL_LLT_H
+#define EIGEN_SUPERNODAL_LLT_H
+
+namespace Eigen {
+
+template<typename _MatrixType, int _UpLo = Lower, typename _Ordering = AMDOrdering<typename _MatrixType::StorageIndex> > class SupernodalLLT;
+
+namespace internal {
+
+template<typename _MatrixType, int _UpLo, typename _Ordering> struct traits<SupernodalLLT<_MatrixType,_UpLo,_Ordering> >
+{
+  typedef _MatrixType MatrixType;
+  typedef _Ordering OrderingType;
+  enum { UpLo = _UpLo };
+};
+
+} // end namespace internal
+
+/** \ingroup SparseCholesky_Module
+  * \class SupernodalLLT
+  * \brief A direct sparse LLT Cholesky factorization working on dense supernodes
+  *
+  * This class provides a LL^T Cholesky factorization of sparse matrices that are selfadjoint and positive
+  * definite. The factorization allows for solving A.X = B where X and B can be either dense or sparse.
+  *
+  * In order to reduce the fill-in, a symmetric permutation P is applied prior to the factorization
+  * such that the factorized matrix is P A P^-1. The fill-reducing ordering is followed by a postorder
+  * of the elimination tree, so that the columns of L sharing the same structure are contiguous.
+  *
+  * Unlike SimplicialLLT, the columns of L are grouped into supernodes, which are stored as dense column-major
+  * panels. Small supernodes are merged with their parents at the price of a few explicit zeros, as in CHOLMOD.
+  * The numerical factorization is left-looking: the updates of each supernode by its descendants are computed
+  * by dense matrix products, and its diagonal block is then factorized by the dense LLT, followed by a
+  * triangular solve for the rest of the panel. This is much faster than SimplicialLLT when the factor
+  * has a lot of fill-in, e.g., for 3D finite element problems.
+  *
+  * \tparam _MatrixType the type of the sparse matrix A, it must be a SparseMatrix<>
+  * \tparam _UpLo the triangular part that will be used for the computations. It can be Lower
+  *               or Upper. Default is Lower.
+  * \tparam _Ordering The ordering method to use, either AMDOrdering<> or NaturalOrdering<>. Default is AMDOrdering<>
+  *
+  * \implsparsesolverconcept
+  *
+  * \sa class SimplicialLLT, class AMDOrdering, class NaturalOrdering
+  */
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+class SupernodalLLT : public SparseSolverBase<SupernodalLLT<_MatrixType,_UpLo,_Ordering> >
+{
+  protected:
+    typedef SparseSolverBase<SupernodalLLT> Base;
+    using Base::m_isInitialized;
+  public:
+    using Base::_solve_impl;
+    typedef _MatrixType MatrixType;
+    typedef _Ordering OrderingType;
+    enum { UpLo = _UpLo };
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::StorageIndex StorageIndex;
+    typedef SparseMatrix<Scalar,ColMajor,StorageIndex> CholMatrixType;
+    typedef Matrix<StorageIndex,Dynamic,1> VectorI;
+    typedef PermutationMatrix<Dynamic,Dynamic,StorageIndex> PermutationType;
+
+    enum {
+      ColsAtCompileTime = MatrixType::ColsAtCompileTime,
+      MaxColsAtCompileTime = MatrixType::MaxColsAtCompileTime
+    };
+
+  protected:
+    typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+    typedef Map<DenseMatrix> PanelType;
+    typedef Map<const DenseMatrix> ConstPanelType;
+
+  public:
+
+    /** Default constructor */
+    SupernodalLLT()
+      : m_info(Success), m_analysisIsOk(false), m_factorizationIsOk(false), m_maxPanelSize(0)
+    {}
+
+    /** Constructs and performs the LLT factorization of \a matrix */
+    explicit SupernodalLLT(const MatrixType& matrix)
+      : m_info(Success), m_analysisIsOk(false), m_factorizationIsOk(false), m_maxPanelSize(0)
+    {
+      compute(matrix);
+    }
+
+    inline Index rows() const { return m_P.size(); }
+    inline Index cols() const { return m_P.size(); }
+
+    /** \brief Reports whether previous computation was successful.
+      *
+      * \returns \c Success if computation was successful,
+      *          \c NumericalIssue if the matrix appears not to be positive definite.
+      */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "Decomposition is not initialized.");
+      return m_info;
+    }
+
+    /** \returns the permutation P, including the postorder of the elimination tree
+      * \sa permutationPinv() */
+    const PermutationType& permutationP() const
+    { return m_P; }
+
+    /** \returns the inverse P^-1 of the permutation P
+      * \sa permutationP() */
+    const PermutationType& permutationPinv() const
+    { return m_Pinv; }
+
+    /** \returns the number of supernodes */
+    Index supernodes() const
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      return m_super.size()-1;
+    }
+
+    /** Computes the sparse Cholesky decomposition of \a matrix */
+    SupernodalLLT& compute(const MatrixType& matrix)
+    {
+      analyzePattern(matrix);
+      factorize(matrix);
+      return *this;
+    }
+
+    /** Performs a symbolic decomposition on the sparsity of \a matrix: computes the ordering, the supernodes,
+      * and the structure of L.
+      *
+      * This function is particularly useful when solving for several problems having the same structure.
+      *
+      * \sa factorize()
+      */
+    void analyzePattern(const MatrixType& matrix);
+
+    /** Performs a numeric decomposition of \a matrix
+      *
+      * The given matrix must have the same sparsity as the matrix on which the symbolic decomposition has been performed.
+      *
+      * \sa analyzePattern()
+      */
+    void factorize(const MatrixType& matrix);
+
+    /** \returns the factor L as a sparse matrix, including the explicit zeros of the supernodes
+      *
+      * The supernodes are copied, so that this function is mostly useful for debugging purposes.
+      */
+    CholMatrixType matrixL() const;
+
+    /** \returns the determinant of the underlying matrix from the current factorization */
+    Scalar determinant() const
+    {
+      eigen_assert(m_factorizationIsOk && "The decomposition is not in a valid state, you must first call either compute() or analyzePattern()/factorize()");
+      Scalar detL(1);
+      const Index nsuper = m_super.size()-1;
+      for(Index s = 0; s < nsuper; ++s)
+        detL *= panel(s).diagonal().prod();
+      return numext::abs2(detL);
+    }
+
+    #ifndef EIGEN_PARSED_BY_DOXYGEN
+    /** \internal */
+    template<typename Rhs,typename Dest>
+    void _solve_impl(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const;
+    #endif // EIGEN_PARSED_BY_DOXYGEN
+
+  protected:
+    // the rows of the supernode s, and its dense panel
+    Index panelRows(Index s) const { return m_rowPtr.coeff(s+1) - m_rowPtr.coeff(s); }
+    Index panelCols(Index s) const { return m_super.coeff(s+1) - m_super.coeff(s); }
+    PanelType panel(Index s) { return PanelType(m_values.data()+m_valuePtr.coeff(s), panelRows(s), panelCols(s)); }
+    ConstPanelType panel(Index s) const { return ConstPanelType(m_values.data()+m_valuePtr.coeff(s), panelRows(s), panelCols(s)); }
+
+    void permuteLower(const MatrixType& a, CholMatrixType& ap) const
+    {
+      ap.resize(a.rows(), a.cols());
+      ap.template selfadjointView<Lower>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+    }
+
+    mutable ComputationInfo m_info;
+    bool m_analysisIsOk;
+    bool m_factorizationIsOk;
+    PermutationType m_P;                  // the permutation
+    PermutationType m_Pinv;               // the inverse permutation
+    VectorI m_super;                      // first column of each supernode, followed by the size of the matrix
+    VectorI m_colToSuper;                 // supernode of each column
+    VectorI m_rowPtr;                     // start of the rows of each supernode in m_rowIndices
+    VectorI m_rowIndices;                 // rows of the supernodes: their own columns followed by the sorted rows below
+    Matrix<Index,Dynamic,1> m_valuePtr;   // start of the panel of each supernode in m_values
+    Matrix<Scalar,Dynamic,1> m_values;    // the dense panels
+    Index m_maxPanelSize;
+};
+
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+void SupernodalLLT<_MatrixType,_UpLo,_Ordering>::analyzePattern(const MatrixType& a)
+{
+  eigen_assert(a.rows()==a.cols());
+  const StorageIndex size = StorageIndex(a.rows());
+
+  // fill-reducing ordering, note that ordering methods compute the inverse permutation
+  {
+    CholMatrixType C;
+    C = a.template selfadjointView<UpLo>();
+    OrderingType ordering;
+    ordering(C,m_Pinv);
+  }
+  if(m_Pinv.size()>0) m_P = m_Pinv.inverse();
+  else                m_P.setIdentity(size);
+
+  // elimination tree and column counts of L, without the diagonal, as in SimplicialCholeskyBase
+  VectorI parent(size), counts(size);
+  {
+    CholMatrixType ap(size,size);
+    ap.template selfadjointView<Upper>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+    VectorI tags(size);
+    for(StorageIndex k = 0; k < size; ++k)
+    {
+      parent[k] = size;
+      tags[k] = k;
+      counts[k] = 0;
+      for(typename CholMatrixType::InnerIterator it(ap,k); it; ++it)
+      {
+        StorageIndex i = it.index();
+        if(i < k)
+        {
+          for(; tags[i] != k; i = parent[i])
+          {
+            if(parent[i] == size)
+              parent[i] = k;
+            counts[i]++;
+            tags[i] = k;
+          }
+        }
+      }
+    }
+  }
+
+  // postorder the elimination tree, so that the supernodes are made of contiguous columns
+  {
+    VectorI post;
+    internal::treePostorder(size, parent, post);
+    PermutationType postPerm(size);
+    postPerm.indices() = post.head(size);
+    m_P = postPerm * m_P;
+    VectorI oldParent = parent, oldCounts = counts;
+    for(StorageIndex j = 0; j < size; ++j)
+    {
+      parent[post[j]] = oldParent[j]==size ? size : post[oldParent[j]];
+      counts[post[j]] = oldCounts[j];
+    }
+  }
+  m_Pinv = m_P.inverse();
+
+  // fundamental supernodes: the column j joins the supernode of the column j-1 if j is the only child of j-1,
+  // and if their structures are the same
+  VectorI children = VectorI::Zero(size);
+  for(StorageIndex j = 0; j < size; ++j)
+    if(parent[j] != size)
+      children[parent[j]]++;
+  std::vector<StorageIndex> fsuper;
+  for(StorageIndex j = 0; j < size; ++j)
+    if(j==0 || !(parent[j-1]==j && counts[j-1]==counts[j]+1 && children[j]==1))
+      fsuper.push_back(j);
+  const StorageIndex nfsuper = StorageIndex(fsuper.size());
+  fsuper.push_back(size);
+
+  // relaxed amalgamation: a supernode is merged with its parent, when the parent immediately follows it,
+  // if the merged supernode is small enough or has few explicit zeros (CHOLMOD's default parameters)
+  {
+    VectorI colToFsuper(size);
+    for(StorageIndex s = 0; s < nfsuper; ++s)
+      for(StorageIndex j = fsuper[s]; j < fsuper[s+1]; ++j)
+        colToFsuper[j] = s;
+    // columns, rows, and nonzeros of the merged supernodes, stored at their first fundamental supernode
+    Matrix<double,Dynamic,1> ncols(nfsuper), nrows(nfsuper), nnz(nfsuper);
+    std::vector<bool> merged(nfsuper, false);
+    for(StorageIndex s = 0; s < nfsuper; ++s)
+    {
+      ncols[s] = double(fsuper[s+1] - fsuper[s]);
+      nrows[s] = double(counts[fsuper[s]] + 1);
+      nnz[s] = 0;
+      for(StorageIndex j = fsuper[s]; j < fsuper[s+1]; ++j)
+        nnz[s] += double(counts[j] + 1);
+    }
+    for(StorageIndex s = nfsuper-2; s >= 0; --s)
+    {
+      const StorageIndex p = s+1;
+      const StorageIndex lastParent = parent[fsuper[p]-1];
+      if(lastParent==size || colToFsuper[lastParent]!=p)
+        continue;
+      // the rows of s below its columns are included in the rows of its parent
+      double c = ncols[s] + ncols[p];
+      double r = ncols[s] + nrows[p];
+      double entries = c*r - c*(c-1)/2;
+      double zeros = entries - (nnz[s] + nnz[p]);
+      if(c <= 4 || (c <= 16 && zeros < 0.8*entries) || (c <= 48 && zeros < 0.1*entries) || zeros < 0.05*entries)
+      {
+        ncols[s] = c;
+        nrows[s] = r;
+        nnz[s] += nnz[p];
+        merged[p] = true;
+      }
+    }
+    std::vector<StorageIndex> super;
+    for(StorageIndex s = 0; s < nfsuper; ++s)
+      if(!merged[s])
+        super.push_back(fsuper[s]);
+    super.push_back(size);
+    m_super = Map<VectorI>(super.data(), StorageIndex(super.size()));
+  }
+  const StorageIndex nsuper = StorageIndex(m_super.size()-1);
+  m_colToSuper.resize(size);
+  for(StorageIndex s = 0; s < nsuper; ++s)
+    m_colToSuper.segment(m_super[s], m_super[s+1]-m_super[s]).setConstant(s);
+
+  // structure of the supernodes: the rows of a supernode are the union of the rows of its columns in A, and of
+  // the rows of its children below its columns
+  CholMatrixType ap;
+  permuteLower(a, ap);
+  VectorI firstChild = VectorI::Constant(nsuper,-1), nextChild(nsuper);
+  for(StorageIndex s = nsuper-1; s >= 0; --s)
+  {
+    StorageIndex p = parent[m_super[s+1]-1];
+    if(p != size)
+    {
+      p = m_colToSuper[p];
+      nextChild[s] = firstChild[p];
+      firstChild[p] = s;
+    }
+  }
+  std::vector<StorageIndex> rowIndices;
+  VectorI marker = VectorI::Constant(size,-1);
+  m_rowPtr.resize(nsuper+1);
+  m_valuePtr.resize(nsuper+1);
+  m_rowPtr[0] = 0;
+  m_valuePtr[0] = 0;
+  m_maxPanelSize = 0;
+  for(StorageIndex s = 0; s < nsuper; ++s)
+  {
+    const StorageIndex first = m_super[s], last = m_super[s+1];
+    for(StorageIndex j = first; j < last; ++j)
+    {
+      rowIndices.push_back(j);
+      marker[j] = s;
+    }
+    const std::size_t below = rowIndices.size();
+    for(StorageIndex j = first; j < last; ++j)
+      for(typename CholMatrixType::InnerIterator it(ap,j); it; ++it)
+      {
+        StorageIndex i = it.index();
+        if(marker[i] != s)
+        {
+          rowIndices.push_back(i);
+          marker[i] = s;
+        }
+      }
+    for(StorageIndex c = firstChild[s]; c != -1; c = nextChild[c])
+      for(StorageIndex k = m_rowPtr[c] + (m_super[c+1]-m_super[c]); k < m_rowPtr[c+1]; ++k)
+      {
+        StorageIndex i = rowIndices[k];
+        if(marker[i] != s)
+        {
+          rowIndices.push_back(i);
+          marker[i] = s;
+        }
+      }
+    std::sort(rowIndices.begin()+below, rowIndices.end());
+    m_rowPtr[s+1] = StorageIndex(rowIndices.size());
+    const Index panelSize = panelRows(s) * panelCols(s);
+    m_valuePtr[s+1] = m_valuePtr[s] + panelSize;
+    m_maxPanelSize = (std::max)(m_maxPanelSize, panelSize);
+  }
+  m_rowIndices = Map<VectorI>(rowIndices.data(), StorageIndex(rowIndices.size()));
+
+  m_isInitialized = true;
+  m_info = Success;
+  m_analysisIsOk = true;
+  m_factorizationIsOk = false;
+}
+
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+void SupernodalLLT<_MatrixType,_UpLo,_Ordering>::factorize(const MatrixType& a)
+{
+  eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+  eigen_assert(a.rows()==a.cols() && a.rows()==rows());
+  const Index size = rows();
+  const Index nsuper = m_super.size()-1;
+
+  CholMatrixType ap;
+  permuteLower(a, ap);
+
+  m_values.setZero(m_valuePtr[nsuper]);
+  Matrix<Scalar,Dynamic,1> work(m_maxPanelSize);
+  // position in its supernode of each row of the current supernode
+  VectorI map(size);
+  // linked lists of the supernodes which update the supernode of their next row, and position of these rows
+  VectorI head = VectorI::Constant(nsuper,-1), next(nsuper), nextRow(nsuper);
+
+  m_info = Success;
+  for(Index s = 0; s < nsuper; ++s)
+  {
+    const StorageIndex first = m_super[s], last = m_super[s+1];
+    const Index ncols = last - first;
+    const Index nrows = panelRows(s);
+    const StorageIndex* srows = m_rowIndices.data() + m_rowPtr[s];
+    PanelType L = panel(s);
+    for(Index k = 0; k < nrows; ++k)
+      map[srows[k]] = StorageIndex(k);
+
+    // scatter the columns of A
+    for(StorageIndex j = first; j < last; ++j)
+      for(typename CholMatrixType::InnerIterator it(ap,j); it; ++it)
+        L.coeffRef(map[it.index()], j-first) += it.value();
+
+    // apply the updates of the descendants whose next rows are in the columns of s
+    for(StorageIndex d = head[s]; d != -1; )
+    {
+      const StorageIndex nextD = next[d];
+      const Index dn = panelRows(d);
+      const StorageIndex* drows = m_rowIndices.data() + m_rowPtr[d];
+      const Index p1 = nextRow[d];
+      Index p2 = p1;
+      while(p2 < dn && drows[p2] < last)
+        ++p2;
+      const Index m = dn - p1, k = p2 - p1;
+      PanelType Ld = panel(d);
+      PanelType C(work.data(), m, k);
+      C.noalias() = Ld.bottomRows(m) * Ld.middleRows(p1, k).adjoint();
+      for(Index jj = 0; jj < k; ++jj)
+      {
+        const Index col = drows[p1+jj] - first;
+        for(Index ii = jj; ii < m; ++ii)
+          L.coeffRef(map[drows[p1+ii]], col) -= C.coeff(ii,jj);
+      }
+      nextRow[d] = StorageIndex(p2);
+      if(p2 < dn)
+      {
+        const StorageIndex t = m_colToSuper[drows[p2]];
+        next[d] = head[t];
+        head[t] = d;
+      }
+      d = nextD;
+    }
+
+    // factorize the diagonal block, and compute the rest of the panel
+    Block<PanelType> L11 = L.topRows(ncols);
+    if(internal::llt_inplace<Scalar,Lower>::blocked(L11) >= 0)
+    {
+      m_info = NumericalIssue;
+      break;
+    }
+    if(nrows > ncols)
+    {
+      Block<PanelType> L21 = L.bottomRows(nrows-ncols);
+      L11.template triangularView<Lower>().adjoint().template solveInPlace<OnTheRight>(L21);
+      nextRow[s] = StorageIndex(ncols);
+      const StorageIndex t = m_colToSuper[srows[ncols]];
+      next[s] = head[t];
+      head[t] = StorageIndex(s);
+    }
+  }
+
+  m_factorizationIsOk = true;
+}
+
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+typename SupernodalLLT<_MatrixType,_UpLo,_Ordering>::CholMatrixType
+SupernodalLLT<_MatrixType,_UpLo,_Ordering>::matrixL() const
+{
+  eigen_assert(m_factorizationIsOk && "The decomposition is not in a valid state, you must first call either compute() or analyzePattern()/factorize()");
+  const Index nsuper = m_super.size()-1;
+  CholMatrixType L(rows(), cols());
+  L.reserve(m_valuePtr[nsuper]);
+  for(Index s = 0; s < nsuper; ++s)
+  {
+    ConstPanelType Ls = panel(s);
+    const StorageIndex* srows = m_rowIndices.data() + m_rowPtr[s];
+    for(Index j = 0; j < Ls.cols(); ++j)
+    {
+      L.startVec(m_super[s]+j);
+      for(Index i = j; i < Ls.rows(); ++i)
+        L.insertBack(srows[i], m_super[s]+j) = Ls.coeff(i,j);
+    }
+  }
+  L.finalize();
+  return L;
+}
+
+#ifndef EIGEN_PARSED_BY_DOXYGEN
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+template<typename Rhs,typename Dest>
+void SupernodalLLT<_MatrixType,_UpLo,_Ordering>::_solve_impl(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const
+{
+  eigen_assert(m_factorizationIsOk && "The decomposition is not in a valid state for solving, you must first call either compute() or analyzePattern()/factorize()");
+  eigen_assert(rows()==b.rows());
+  if(m_info!=Success)
+    return;
+
+  const Index nsuper = m_super.size()-1;
+  DenseMatrix x = m_P * b;
+  DenseMatrix tmp;
+
+  // solve L y = P b
+  for(Index s = 0; s < nsuper; ++s)
+  {
+    ConstPanelType L = panel(s);
+    const Index ncols = L.cols(), below = L.rows() - ncols;
+    const StorageIndex* srows = m_rowIndices.data() + m_rowPtr[s] + ncols;
+    Block<DenseMatrix> xs = x.middleRows(m_super[s], ncols);
+    L.topRows(ncols).template triangularView<Lower>().solveInPlace(xs);
+    if(below > 0)
+    {
+      tmp.noalias() = L.bottomRows(below) * xs;
+      for(Index k = 0; k < below; ++k)
+        x.row(srows[k]) -= tmp.row(k);
+    }
+  }
+
+  // solve L^* z = y
+  for(Index s = nsuper-1; s >= 0; --s)
+  {
+    ConstPanelType L = panel(s);
+    const Index ncols = L.cols(), below = L.rows() - ncols;
+    const StorageIndex* srows = m_rowIndices.data() + m_rowPtr[s] + ncols;
+    Block<DenseMatrix> xs = x.middleRows(m_super[s], ncols);
+    if(below > 0)
+    {
+      tmp.resize(below, x.cols());
+      for(Index k = 0; k < below; ++k)
+        tmp.row(k) = x.row(srows[k]);
+      xs.noalias() -= L.bottomRows(below).adjoint() * tmp;
+    }
+    L.topRows(ncols).template triangularView<Lower>().adjoint().solveInPlace(xs);
+  }
+
+  dest = m_Pinv * x;
+}
+#endif // EIGEN_PARSED_BY_DOXYGEN
+
+} // end namespace Eigen
+
+#endif // EIGEN_SUPERNODAL_LLT_H
@@ -14,9 +14,205 @@ namespace Eigen {
 
 namespace internal {
 
+// Computes the number of non zeros of the outer vectors [start,start+length) of lhs*rhs into outerIndex[j+1],
+// or, when innerIndices is not null and outerIndex is complete, their sorted inner indices.
+template<typename Lhs, typename Rhs, typename StorageIndex>
+struct sparse_sparse_product_symbolic
+{
+  sparse_sparse_product_symbolic(const evaluator<Lhs>& lhsEval, const evaluator<Rhs>& rhsEval, Index innerSize,
+                                 StorageIndex* outerIndex, StorageIndex* innerIndices)
+    : m_lhsEval(lhsEval), m_rhsEval(rhsEval), m_innerSize(innerSize), m_outerIndex(outerIndex), m_innerIndices(innerIndices)
+  {}
+
+  void operator()(Index start, Index length) const
+  {
+    Matrix<Index,Dynamic,1> marker = Matrix<Index,Dynamic,1>::Constant(m_innerSize, -1);
+    Index* mark = marker.data();
+    for(Index j=start; j<start+length; ++j)
+    {
+      StorageIndex* indices = m_innerIndices ? m_innerIndices + m_outerIndex[j] : 0;
+      Index nnz = 0;
+      for (typename evaluator<Rhs>::InnerIterator rhsIt(m_rhsEval, j); rhsIt; ++rhsIt)
+      {
+        for (typename evaluator<Lhs>::InnerIterator lhsIt(m_lhsEval, rhsIt.index()); lhsIt; ++lhsIt)
+        {
+          Index i = lhsIt.index();
+          if(mark[i]!=j)
+          {
+            mark[i] = j;
+            if(indices) indices[nnz] = StorageIndex(i);
+            ++nnz;
+          }
+        }
+      }
+      if(indices) std::sort(indices, indices+nnz);
+      else        m_outerIndex[j+1] = StorageIndex(nnz);
+    }
+  }
+
+  const evaluator<Lhs>& m_lhsEval;
+  const evaluator<Rhs>& m_rhsEval;
+  Index m_innerSize;
+  StorageIndex* m_outerIndex;
+  StorageIndex* m_innerIndices;
+};
+
+// Computes the values of the outer vectors [start,start+length) of lhs*rhs. If hasPattern is true, their inner
+// indices are given and the values are gathered from a dense accumulator, otherwise the inner indices are
+// computed along, and sorted if required, within the space reserved by outerIndex.
+template<typename Lhs, typename Rhs, typename ResScalar, typename StorageIndex>
+struct sparse_sparse_product_numeric
+{
+  sparse_sparse_product_numeric(const evaluator<Lhs>& lhsEval, const evaluator<Rhs>& rhsEval, Index innerSize,
+                                const StorageIndex* outerIndex, StorageIndex* innerIndices, ResScalar* values,
+                                bool hasPattern, bool sorted)
+    : m_lhsEval(lhsEval), m_rhsEval(rhsEval), m_innerSize(innerSize), m_outerIndex(outerIndex),
+      m_innerIndices(innerIndices), m_values(values), m_hasPattern(hasPattern), m_sorted(sorted)
+  {}
+
+  void operator()(Index start, Index length) const
+  {
+    typedef typename evaluator<Lhs>::InnerIterator LhsIterator;
+    typedef typename evaluator<Rhs>::InnerIterator RhsIterator;
+    Matrix<ResScalar,Dynamic,1> accumulator = Matrix<ResScalar,Dynamic,1>::Zero(m_innerSize);
+    ResScalar* dense = accumulator.data();
+    if(m_hasPattern)
+    {
+      for(Index j=start; j<start+length; ++j)
+      {
+        for (RhsIterator rhsIt(m_rhsEval, j); rhsIt; ++rhsIt)
+        {
+          typename Rhs::Scalar y = rhsIt.value();
+          for (LhsIterator lhsIt(m_lhsEval, rhsIt.index()); lhsIt; ++lhsIt)
+            dense[lhsIt.index()] += lhsIt.value() * y;
+        }
+        for(Index p=m_outerIndex[j]; p<m_outerIndex[j+1]; ++p)
+        {
+          m_values[p] = dense[m_innerIndices[p]];
+          dense[m_innerIndices[p]] = ResScalar(0);
+        }
+#ifndef EIGEN_NO_DEBUG
+        // the products outside of the pattern are not gathered, and would be added to the next columns
+        for (RhsIterator rhsIt(m_rhsEval, j); rhsIt; ++rhsIt)
+          for (LhsIterator lhsIt(m_lhsEval, rhsIt.index()); lhsIt; ++lhsIt)
+            eigen_assert(dense[lhsIt.index()]==ResScalar(0) && "the operands have entries outside of the pattern of the result");
+#endif
+      }
+      return;
+    }
+
+    Matrix<Index,Dynamic,1> marker = Matrix<Index,Dynamic,1>::Constant(m_innerSize, -1);
+    Index* mark = marker.data();
+    for(Index j=start; j<start+length; ++j)
+    {
+      StorageIndex* indices = m_innerIndices + m_outerIndex[j];
+      Index nnz = 0;
+      for (RhsIterator rhsIt(m_rhsEval, j); rhsIt; ++rhsIt)
+      {
+        typename Rhs::Scalar y = rhsIt.value();
+        for (LhsIterator lhsIt(m_lhsEval, rhsIt.index()); lhsIt; ++lhsIt)
+        {
+          Index i = lhsIt.index();
+          if(mark[i]!=j)
+          {
+            mark[i] = j;
+            dense[i] = lhsIt.value() * y;
+            indices[nnz] = StorageIndex(i);
+            ++nnz;
+          }
+          else
+            dense[i] += lhsIt.value() * y;
+        }
+      }
+      if(m_sorted && nnz>1) std::sort(indices, indices+nnz);
+      for(Index k=0; k<nnz; ++k)
+        m_values[m_outerIndex[j]+k] = dense[indices[k]];
+    }
+  }
+
+  const evaluator<Lhs>& m_lhsEval;
+  const evaluator<Rhs>& m_rhsEval;
+  Index m_innerSize;
+  const StorageIndex* m_outerIndex;
+  StorageIndex* m_innerIndices;
+  ResScalar* m_values;
+  bool m_hasPattern, m_sorted;
+};
+
+// Rough estimate of the number of multiply-adds of lhs*rhs.
+template<typename Lhs, typename Rhs>
+double sparse_sparse_product_work(const evaluator<Lhs>& lhsEval, const evaluator<Rhs>& rhsEval, Index depth)
+{
+  return double(lhsEval.nonZerosEstimate()) * double(rhsEval.nonZerosEstimate()) / double((std::max)(depth,Index(1)));
+}
+
+// Returns whether the product of lhs by rhs is worth being split among the threads available to Eigen.
+template<typename Lhs, typename Rhs>
+bool sparse_sparse_product_use_threads(const Lhs& lhs, const Rhs& rhs)
+{
+#if (! defined(EIGEN_HAS_OPENMP)) && (!EIGEN_HAS_CXX11_ATOMIC)
+  EIGEN_UNUSED_VARIABLE(lhs);
+  EIGEN_UNUSED_VARIABLE(rhs);
+  return false;
+#else
+  if(nbThreads()<2 || rhs.outerSize()<2 || in_parallel_region(parallel_executor()))
+    return false;
+  evaluator<Lhs> lhsEval(lhs);
+  evaluator<Rhs> rhsEval(rhs);
+  double kMinTaskSize = 50000;  // same threshold as parallelize_range
+  return sparse_sparse_product_work(lhsEval, rhsEval, lhs.outerSize()) >= 2*kMinTaskSize;
+#endif
+}
+
+// Multi-threaded version of conservative_sparse_sparse_product_impl: an exact symbolic pass counts the non zeros
+// of each outer vector of the result, which is then allocated once and filled in parallel by the numeric pass.
+template<typename Lhs, typename Rhs, typename ResultType>
+struct conservative_sparse_sparse_product_parallel
+{
+  static bool run(const Lhs&, const Rhs&, ResultType&, bool) { return false; }
+};
+
+template<typename Lhs, typename Rhs, typename ResScalar, int ResOptions, typename StorageIndex>
+struct conservative_sparse_sparse_product_parallel<Lhs,Rhs,SparseMatrix<ResScalar,ResOptions,StorageIndex> >
+{
+  typedef SparseMatrix<ResScalar,ResOptions,StorageIndex> ResultType;
+
+  static bool run(const Lhs& lhs, const Rhs& rhs, ResultType& res, bool sortedInsertion)
+  {
+    if(!sparse_sparse_product_use_threads(lhs, rhs))
+      return false;
+
+    // make sure to call innerSize/outerSize since we fake the storage order.
+    Index rows = lhs.innerSize();
+    Index cols = rhs.outerSize();
+    eigen_assert(lhs.outerSize() == rhs.innerSize());
+    eigen_assert(res.innerSize() == rows && res.outerSize() == cols);
+
+    evaluator<Lhs> lhsEval(lhs);
+    evaluator<Rhs> rhsEval(rhs);
+    double work = sparse_sparse_product_work(lhsEval, rhsEval, lhs.outerSize());
+
+    res.resize(res.rows(), res.cols());
+    StorageIndex* outerIndex = res.outerIndexPtr();
+    parallelize_range<true>(sparse_sparse_product_symbolic<Lhs,Rhs,StorageIndex>(lhsEval, rhsEval, rows, outerIndex, 0),
+                            cols, Index(1), work);
+    for(Index j=0; j<cols; ++j)
+      outerIndex[j+1] += outerIndex[j];
+
+    res.resizeNonZeros(outerIndex[cols]);
+    parallelize_range<true>(sparse_sparse_product_numeric<Lhs,Rhs,ResScalar,StorageIndex>(lhsEval, rhsEval, rows, outerIndex,
+                              res.innerIndexPtr(), res.valuePtr(), false, sortedInsertion),
+                            cols, Index(1), work);
+    return true;
+  }
+};
+
 template<typename Lhs, typename Rhs, typename ResultType>
 static void conservative_sparse_sparse_product_impl(const Lhs& lhs, const Rhs& rhs, ResultType& res, bool sortedInsertion = false)
 {
+  if(conservative_sparse_sparse_product_parallel<Lhs,Rhs,ResultType>::run(lhs, rhs, res, sortedInsertion))
+    return;
+
   typedef typename remove_all<Lhs>::type::Scalar LhsScalar;
   typedef typename remove_all<Rhs>::type::Scalar RhsScalar;
   typedef typename remove_all<ResultType>::type::Scalar ResScalar;
@@ -144,8 +340,9 @@ struct conservative_sparse_sparse_product_selector<Lhs,Rhs,ResultType,ColMajor,C
     
     // If the result is tall and thin (in the extreme case a column vector)
     // then it is faster to sort the coefficients inplace instead of transposing twice.
+    // This is also the case when the columns are sorted by several threads.
     // FIXME, the following heuristic is probably not very good.
-    if(lhs.rows()>rhs.cols())
+    if(lhs.rows()>rhs.cols() || sparse_sparse_product_use_threads(lhs, rhs))
     {
       ColMajorMatrix resCol(lhs.rows(),rhs.cols());
       // perform sorted insertion
@@ -22,6 +22,9 @@ namespace Eigen {
   * C = (A*B).pruned(ref,epsilon);
   * \endcode
   * where \c ref is a meaningful non zero reference value.
+  *
+  * Large conservative products are split among the threads available to Eigen. The products of matrices
+  * sharing the same sparsity patterns can skip the computation of the structure of the result through a SparseProductPlan.
   * */
 template<typename Derived>
 template<typename OtherDerived>
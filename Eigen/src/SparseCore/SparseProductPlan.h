@@ -0,0 +1,168 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SPARSEPRODUCTPLAN_H
+#define EIGEN_SPARSEPRODUCTPLAN_H
+
+namespace Eigen {
+
+/** \ingroup SparseCore_Module
+  *
+  * \class SparseProductPlan
+  *
+  * \brief Computes repeated products of sparse matrices sharing the same structure
+  *
+  * \tparam _MatrixType the type of the result, a SparseMatrix
+  *
+  * The evaluation of a sparse product \c A*B is split into a symbolic pass, computing the sparsity pattern of the
+  * result, and a numeric pass, computing its values. This class stores the result of the symbolic pass, so
+  * that the products of matrices having the same sparsity patterns as \c A and \c B only perform the numeric pass:
+  * \code
+  * SparseProductPlan<SparseMatrix<double> > plan;
+  * plan.analyzePattern(A, B);
+  * for(...)
+  * {
+  *   // update the values of A and B
+  *   plan.evaluate(A, B, C);   // same as C = A*B
+  * }
+  * \endcode
+  * This is typically useful for the Galerkin products R*A*P of algebraic multigrid methods, with one plan for
+  * each of the two products.
+  *
+  * Like the conservative product, the explicit zeros of the operands are kept in the pattern of the result, whose
+  * inner indices are sorted. Both passes are split among the threads available to Eigen, see nbThreads().
+  *
+  * \sa SparseMatrixBase::operator*()
+  */
+template<typename _MatrixType>
+class SparseProductPlan
+{
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::StorageIndex StorageIndex;
+    enum {
+      IsRowMajor = MatrixType::IsRowMajor,
+      StorageOrder = IsRowMajor ? RowMajor : ColMajor
+    };
+
+    SparseProductPlan() : m_rows(0), m_cols(0), m_depth(0), m_isInitialized(false) {}
+
+    /** Constructs a plan for the products having the structure of \a lhs * \a rhs, see analyzePattern(). */
+    template<typename Lhs, typename Rhs>
+    SparseProductPlan(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs)
+      : m_rows(0), m_cols(0), m_depth(0), m_isInitialized(false)
+    {
+      analyzePattern(lhs, rhs);
+    }
+
+    /** Computes and stores the sparsity pattern of \a lhs * \a rhs. */
+    template<typename Lhs, typename Rhs>
+    SparseProductPlan& analyzePattern(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs)
+    {
+      eigen_assert(lhs.cols() == rhs.rows() && "invalid sparse matrix product");
+      typename Operand<Lhs>::type lhsNested(lhs.derived());
+      typename Operand<Rhs>::type rhsNested(rhs.derived());
+      m_rows = lhs.rows();
+      m_cols = rhs.cols();
+      m_depth = lhs.cols();
+      // the outer vectors of a row major result are the products of the rows of lhs by rhs
+      if(IsRowMajor) symbolic(rhsNested, lhsNested);
+      else           symbolic(lhsNested, rhsNested);
+      m_isInitialized = true;
+      return *this;
+    }
+
+    /** Computes \a res = \a lhs * \a rhs, where \a lhs and \a rhs must have the same sizes and sparsity patterns
+      * as the matrices given to analyzePattern(). Their entries outside of these patterns are not supported.
+      *
+      * \warning \a res is resized before the operands are read, so it must not alias them. */
+    template<typename Lhs, typename Rhs>
+    void evaluate(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs, MatrixType& res) const
+    {
+      eigen_assert(m_isInitialized && "SparseProductPlan is not initialized.");
+      eigen_assert(lhs.rows() == m_rows && lhs.cols() == m_depth && rhs.cols() == m_cols
+                   && "the sizes of the operands do not match the ones given to analyzePattern()");
+      eigen_assert(static_cast<const void*>(&lhs.derived()) != static_cast<const void*>(&res)
+                   && static_cast<const void*>(&rhs.derived()) != static_cast<const void*>(&res)
+                   && "the result of SparseProductPlan::evaluate() must not alias its operands");
+      typename Operand<Lhs>::type lhsNested(lhs.derived());
+      typename Operand<Rhs>::type rhsNested(rhs.derived());
+      res.resize(m_rows, m_cols);
+      res.resizeNonZeros(nonZeros());
+      std::copy(m_outerIndex.begin(), m_outerIndex.end(), res.outerIndexPtr());
+      std::copy(m_innerIndices.begin(), m_innerIndices.end(), res.innerIndexPtr());
+      if(IsRowMajor) numeric(rhsNested, lhsNested, res);
+      else           numeric(lhsNested, rhsNested, res);
+    }
+
+    /** \returns the number of rows of the product */
+    Index rows() const { return m_rows; }
+    /** \returns the number of columns of the product */
+    Index cols() const { return m_cols; }
+    /** \returns the number of non zeros of the product */
+    Index nonZeros() const { return Index(m_innerIndices.size()); }
+
+  protected:
+    // The operands are copied if their storage order differs from the one of the result.
+    template<typename Xpr> struct Operand
+    {
+      typedef typename internal::conditional<(int(internal::traits<Xpr>::Flags)&RowMajorBit) == (IsRowMajor ? int(RowMajorBit) : 0),
+                                             const Xpr&,
+                                             const SparseMatrix<typename Xpr::Scalar,StorageOrder,StorageIndex> >::type type;
+    };
+
+    template<typename Lhs, typename Rhs>
+    void symbolic(const Lhs& lhs, const Rhs& rhs)
+    {
+      typedef typename internal::remove_all<Lhs>::type LhsCleaned;
+      typedef typename internal::remove_all<Rhs>::type RhsCleaned;
+      Index innerSize = lhs.innerSize();
+      Index outerSize = rhs.outerSize();
+      internal::evaluator<LhsCleaned> lhsEval(lhs);
+      internal::evaluator<RhsCleaned> rhsEval(rhs);
+      double work = internal::sparse_sparse_product_work(lhsEval, rhsEval, lhs.outerSize());
+
+      m_outerIndex.assign(outerSize+1, StorageIndex(0));
+      internal::parallelize_range<true>(internal::sparse_sparse_product_symbolic<LhsCleaned,RhsCleaned,StorageIndex>(
+                                          lhsEval, rhsEval, innerSize, &m_outerIndex[0], 0),
+                                        outerSize, Index(1), work);
+      for(Index j=0; j<outerSize; ++j)
+        m_outerIndex[j+1] += m_outerIndex[j];
+
+      m_innerIndices.resize(m_outerIndex[outerSize]);
+      if(!m_innerIndices.empty())
+        internal::parallelize_range<true>(internal::sparse_sparse_product_symbolic<LhsCleaned,RhsCleaned,StorageIndex>(
+                                            lhsEval, rhsEval, innerSize, &m_outerIndex[0], &m_innerIndices[0]),
+                                          outerSize, Index(1), work);
+    }
+
+    template<typename Lhs, typename Rhs>
+    void numeric(const Lhs& lhs, const Rhs& rhs, MatrixType& res) const
+    {
+      typedef typename internal::remove_all<Lhs>::type LhsCleaned;
+      typedef typename internal::remove_all<Rhs>::type RhsCleaned;
+      if(nonZeros()==0)
+        return;
+      internal::evaluator<LhsCleaned> lhsEval(lhs);
+      internal::evaluator<RhsCleaned> rhsEval(rhs);
+      double work = internal::sparse_sparse_product_work(lhsEval, rhsEval, lhs.outerSize());
+      internal::parallelize_range<true>(internal::sparse_sparse_product_numeric<LhsCleaned,RhsCleaned,Scalar,StorageIndex>(
+                                          lhsEval, rhsEval, lhs.innerSize(), res.outerIndexPtr(), res.innerIndexPtr(),
+                                          res.valuePtr(), true, true),
+                                        rhs.outerSize(), Index(1), work);
+    }
+
+    Index m_rows, m_cols, m_depth;
+    std::vector<StorageIndex> m_outerIndex;
+    std::vector<StorageIndex> m_innerIndices;
+    bool m_isInitialized;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_SPARSEPRODUCTPLAN_H
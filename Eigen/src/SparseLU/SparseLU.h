@@ -18,6 +18,13 @@ template <typename _MatrixType, typename _OrderingType = COLAMDOrdering<typename
 template <typename MappedSparseMatrixType> struct SparseLUMatrixLReturnType;
 template <typename MatrixLType, typename MatrixUType> struct SparseLUMatrixUReturnType;
 
+namespace internal {
+template <typename StorageIndex, typename Scalar> struct sparselu_less_row
+{
+  bool operator()(const std::pair<StorageIndex,Scalar>& a, const std::pair<StorageIndex,Scalar>& b) const { return a.first < b.first; }
+};
+} // end namespace internal
+
 /** \ingroup SparseLU_Module
   * \class SparseLU
   * 
@@ -57,6 +64,11 @@ template <typename MatrixLType, typename MatrixUType> struct SparseLUMatrixURetu
   * \warning The input matrix A should be in a \b compressed and \b column-major form.
   * Otherwise an expensive copy will be made. You can call the inexpensive makeCompressed() to get a compressed matrix.
   * 
+  * \note When enabled by setParallelUpdates(), and Eigen is allowed to use several threads (see Eigen::setNbThreads()
+  * and Eigen::setGemmExecutor()), the dense products of the supernode-panel updates are split by rows among the
+  * threads. The factors are exactly the same as with a single thread. The columns themselves are still factored
+  * one panel after the other: the independent subtrees of the column elimination tree are not scheduled concurrently.
+  *
   * \note Unlike the initial SuperLU implementation, there is no step to equilibrate the matrix. 
   * For badly scaled matrices, this step can be useful to reduce the pivoting during factorization. 
   * If this is the case for your matrices, you can try the basic scaling method at
@@ -97,12 +109,12 @@ class SparseLU : public SparseSolverBase<SparseLU<_MatrixType,_OrderingType> >,
     };
     
   public:
-    SparseLU():m_lastError(""),m_Ustore(0,0,0,0,0,0),m_symmetricmode(false),m_diagpivotthresh(1.0),m_detPermR(1)
+    SparseLU():m_lastError(""),m_Ustore(0,0,0,0,0,0),m_symmetricmode(false),m_parallelupdates(false),m_diagpivotthresh(1.0),m_refactorpivotthresh(1e-3),m_detPermR(1),m_sortedU(false),m_structureReused(false)
     {
       initperfvalues(); 
     }
     explicit SparseLU(const MatrixType& matrix)
-      : m_lastError(""),m_Ustore(0,0,0,0,0,0),m_symmetricmode(false),m_diagpivotthresh(1.0),m_detPermR(1)
+      : m_lastError(""),m_Ustore(0,0,0,0,0,0),m_symmetricmode(false),m_parallelupdates(false),m_diagpivotthresh(1.0),m_refactorpivotthresh(1e-3),m_detPermR(1),m_sortedU(false),m_structureReused(false)
     {
       initperfvalues(); 
       compute(matrix);
@@ -115,6 +127,7 @@ class SparseLU : public SparseSolverBase<SparseLU<_MatrixType,_OrderingType> >,
     
     void analyzePattern (const MatrixType& matrix);
     void factorize (const MatrixType& matrix);
+    void refactorize (const MatrixType& matrix);
     void simplicialfactorize(const MatrixType& matrix);
     
     /**
@@ -136,6 +149,12 @@ class SparseLU : public SparseSolverBase<SparseLU<_MatrixType,_OrderingType> >,
     {
       m_symmetricmode = sym;
     }
+    /** Indicate whether the dense products of the supernode-panel updates may be split among the threads
+      * available to Eigen. This is disabled by default. The factors do not depend on this option. */
+    void setParallelUpdates(bool enable)
+    {
+      m_parallelupdates = enable;
+    }
     
     /** \returns an expression of the matrix L, internally stored as supernodes
       * The only operation available with this expression is the triangular solve
@@ -174,11 +193,25 @@ class SparseLU : public SparseSolverBase<SparseLU<_MatrixType,_OrderingType> >,
     {
       return m_perm_c;
     }
+    /** \returns true if the last factorization was computed by refactorize() reusing the structure of the
+      * previous one, and false if it was computed by factorize(), including when refactorize() falls back to it.
+      * \sa refactorize() */
+    bool structureReused() const
+    {
+      return m_structureReused;
+    }
     /** Set the threshold used for a diagonal entry to be an acceptable pivot. */
     void setPivotThreshold(const RealScalar& thresh)
     {
       m_diagpivotthresh = thresh; 
     }
+    /** Set the threshold used by refactorize() to keep a previous pivot, relatively to the largest entry
+      * of its column in L. It is much smaller than the pivot threshold of factorize(), the default is 1e-3.
+      * \sa refactorize() */
+    void setRefactorizationThreshold(const RealScalar& thresh)
+    {
+      m_refactorpivotthresh = thresh;
+    }
 
 #ifdef EIGEN_PARSED_BY_DOXYGEN
     /** \returns the solution X of \f$ A X = B \f$ using the current decomposition of A.
@@ -366,6 +399,21 @@ class SparseLU : public SparseSolverBase<SparseLU<_MatrixType,_OrderingType> >,
       m_perfv.colblk = 8; 
       m_perfv.fillfactor = 20;  
     }
+
+    // Applies the segment [kfnz,krep] of the column of U in the supernode starting at fsupc to dense, as in column_bmod()
+    void refactorizeUpdate(ScalarVector& dense, ScalarVector& tempv, Index fsupc, Index kfnz, Index krep)
+    {
+      Index segsize = krep - kfnz + 1;
+      Index lptr = m_glu.xlsub(fsupc);
+      Index nrow = m_glu.xlsub(fsupc+1) - lptr - (krep - fsupc + 1);
+      Index lda = m_glu.xlusup(fsupc+1) - m_glu.xlusup(fsupc);
+      Index luptr = m_glu.xlusup(fsupc);
+      Index no_zeros = kfnz - fsupc;
+            if(segsize==1)  internal::LU_kernel_bmod<1>::run(segsize, dense, tempv, m_glu.lusup, luptr, lda, nrow, m_glu.lsub, lptr, no_zeros);
+      else  if(segsize==2)  internal::LU_kernel_bmod<2>::run(segsize, dense, tempv, m_glu.lusup, luptr, lda, nrow, m_glu.lsub, lptr, no_zeros);
+      else  if(segsize==3)  internal::LU_kernel_bmod<3>::run(segsize, dense, tempv, m_glu.lusup, luptr, lda, nrow, m_glu.lsub, lptr, no_zeros);
+      else                  internal::LU_kernel_bmod<Dynamic>::run(segsize, dense, tempv, m_glu.lusup, luptr, lda, nrow, m_glu.lsub, lptr, no_zeros);
+    }
       
     // Variables 
     mutable ComputationInfo m_info;
@@ -383,11 +431,15 @@ class SparseLU : public SparseSolverBase<SparseLU<_MatrixType,_OrderingType> >,
                                
     // SparseLU options 
     bool m_symmetricmode;
+    bool m_parallelupdates; // Whether the supernode-panel updates are split among the threads
     // values for performance 
     internal::perfvalues m_perfv;
     RealScalar m_diagpivotthresh; // Specifies the threshold used for a diagonal entry to be an acceptable pivot
+    RealScalar m_refactorpivotthresh; // Specifies the threshold used by refactorize() to keep a previous pivot
     Index m_nnzL, m_nnzU; // Nonzeros in L and U factors
     Index m_detPermR, m_detPermC; // Determinants of the permutation matrices
+    bool m_sortedU; // Whether the row indices of the columns of U are sorted, as required by refactorize()
+    bool m_structureReused; // Whether the last factorization has been computed by refactorize() without falling back to factorize()
   private:
     // Disable copy constructor 
     SparseLU (const SparseLU& );
@@ -469,6 +521,8 @@ void SparseLU<MatrixType, OrderingType>::analyzePattern(const MatrixType& mat)
   } // end postordering 
   
   m_analysisIsOk = true; 
+  // The permutations have changed, the structure of the previous factors cannot be reused
+  m_factorizationIsOk = false;
 }
 
 // Functions needed by the numerical factorization phase
@@ -500,6 +554,7 @@ void SparseLU<MatrixType, OrderingType>::factorize(const MatrixType& matrix)
   eigen_assert((matrix.rows() == matrix.cols()) && "Only for squared matrices");
   
   m_isInitialized = true;
+  m_structureReused = false;
   
   // Apply the column permutation computed in analyzepattern()
   //   m_mat = matrix * m_perm_c.inverse(); 
@@ -609,7 +664,7 @@ void SparseLU<MatrixType, OrderingType>::factorize(const MatrixType& matrix)
     Base::panel_dfs(m, panel_size, jcol, m_mat, m_perm_r.indices(), nseg1, dense, panel_lsub, segrep, repfnz, xprune, marker, parent, xplore, m_glu); 
     
     // Numeric sup-panel updates in topological order 
-    Base::panel_bmod(m, panel_size, jcol, nseg1, dense, tempv, segrep, repfnz, m_glu); 
+    Base::panel_bmod(m, panel_size, jcol, nseg1, dense, tempv, segrep, repfnz, m_glu, m_parallelupdates); 
     
     // Sparse LU within the panel, and below the panel diagonal 
     for ( jj = jcol; jj< jcol + panel_size; jj++) 
@@ -695,6 +750,124 @@ void SparseLU<MatrixType, OrderingType>::factorize(const MatrixType& matrix)
   
   m_info = Success;
   m_factorizationIsOk = true;
+  m_sortedU = false;
+}
+
+/**
+  * Recomputes the numerical factorization of \a matrix, keeping the row and column permutations and the
+  * structure of L and U computed by the last call to factorize(). The matrix must have the same sparsity
+  * pattern as the previously factorized one.
+  *
+  * This skips the depth-first searches, the pruning and the memory expansions of factorize(), which makes
+  * it much faster when many matrices with the same pattern are factorized, e.g., in a Newton solver.
+  * A previous pivot is kept as long as it is not smaller than the refactorization threshold times the largest
+  * entry of its column in L (see setRefactorizationThreshold()). Otherwise, or if analyzePattern() has been
+  * called since the last factorization, the function falls back to factorize(), which structureReused() reports.
+  *
+  * \sa factorize(), setRefactorizationThreshold(), structureReused()
+  */
+template <typename MatrixType, typename OrderingType>
+void SparseLU<MatrixType, OrderingType>::refactorize(const MatrixType& matrix)
+{
+  eigen_assert(m_analysisIsOk && "analyzePattern() should be called first");
+  eigen_assert((matrix.rows() == matrix.cols()) && "Only for squared matrices");
+  if (!m_factorizationIsOk || matrix.cols() != cols())
+  {
+    factorize(matrix);
+    return;
+  }
+
+  Index n = cols();
+  IndexVector iperm_c(n);
+  for (Index i = 0; i < n; i++) iperm_c(m_perm_c.indices()(i)) = StorageIndex(i);
+
+  // The rows of each column of U are processed in increasing order, which is a topological order of the updates
+  if (!m_sortedU)
+  {
+    std::vector<std::pair<StorageIndex,Scalar> > entries;
+    for (Index j = 0; j < n; j++)
+    {
+      Index start = m_glu.xusub(j), end = m_glu.xusub(j+1);
+      entries.resize(end-start);
+      for (Index k = start; k < end; k++) entries[k-start] = std::make_pair(m_glu.usub(k), m_glu.ucol(k));
+      std::sort(entries.begin(), entries.end(), internal::sparselu_less_row<StorageIndex,Scalar>());
+      for (Index k = start; k < end; k++)
+      {
+        m_glu.usub(k) = entries[k-start].first;
+        m_glu.ucol(k) = entries[k-start].second;
+      }
+    }
+    m_sortedU = true;
+  }
+
+  // Scatter/gather the current column of P_r A P_c^T, in the permuted row order
+  ScalarVector dense, tempv;
+  dense.setZero(n);
+  tempv.setZero(internal::LUnumTempV(n, m_perfv.panel_size, m_perfv.maxsuper, n));
+  const StorageIndex* perm_r = m_perm_r.indices().data();
+#ifndef EIGEN_NO_DEBUG
+  IndexVector marker;
+  marker.setConstant(n, -1);
+#endif
+  for (Index jj = 0; jj < n; jj++)
+  {
+    Index fsupc = m_glu.xsup(m_glu.supno(jj));
+    Index lptr = m_glu.xlsub(fsupc), nsupr = m_glu.xlsub(fsupc+1) - lptr;
+#ifndef EIGEN_NO_DEBUG
+    // the entries outside of the stored pattern are not gathered, and would be added to the next columns
+    for (Index k = m_glu.xusub(jj); k < m_glu.xusub(jj+1); k++) marker(m_glu.usub(k)) = StorageIndex(jj);
+    for (Index i = 0; i < nsupr; i++) marker(m_glu.lsub(lptr+i)) = StorageIndex(jj);
+    for (typename MatrixType::InnerIterator it(matrix, iperm_c(jj)); it; ++it)
+      eigen_assert(marker(perm_r[it.index()]) == jj && "The matrix must have the pattern of the previously factorized one");
+#endif
+    for (typename MatrixType::InnerIterator it(matrix, iperm_c(jj)); it; ++it)
+      dense(perm_r[it.index()]) += it.value();
+
+    // Updates by the segments of the other supernodes, i.e., the runs of consecutive rows of U in a supernode
+    for (Index k = m_glu.xusub(jj); k < m_glu.xusub(jj+1); )
+    {
+      Index kfnz = m_glu.usub(k);
+      Index ksupno = m_glu.supno(kfnz);
+      Index kend = k + 1;
+      while (kend < m_glu.xusub(jj+1) && m_glu.usub(kend) == m_glu.usub(kend-1) + 1 && m_glu.supno(m_glu.usub(kend)) == ksupno)
+        kend++;
+      refactorizeUpdate(dense, tempv, m_glu.xsup(ksupno), kfnz, m_glu.usub(kend-1));
+      for (; k < kend; k++)
+      {
+        Index irow = m_glu.usub(k);
+        m_glu.ucol(k) = dense(irow);
+        dense(irow) = Scalar(0);
+      }
+    }
+
+    // Updates by the previous columns of the supernode of jj
+    if (jj > fsupc)
+      refactorizeUpdate(dense, tempv, fsupc, fsupc, jj-1);
+
+    // Gather the column of the supernode, and check the pivot
+    Index luptr = m_glu.xlusup(jj);
+    Index diag = jj - fsupc;
+    RealScalar maxabs(0);
+    for (Index i = 0; i < nsupr; i++)
+    {
+      Index irow = m_glu.lsub(lptr+i);
+      m_glu.lusup(luptr+i) = dense(irow);
+      dense(irow) = Scalar(0);
+      if (i >= diag) maxabs = (std::max)(maxabs, numext::abs(m_glu.lusup(luptr+i)));
+    }
+    Scalar pivot = m_glu.lusup(luptr+diag);
+    RealScalar pivotabs = numext::abs(pivot);
+    if (pivotabs == RealScalar(0) || pivotabs < m_refactorpivotthresh * maxabs)
+    {
+      factorize(matrix);
+      return;
+    }
+    for (Index i = diag + 1; i < nsupr; i++)
+      m_glu.lusup(luptr+i) /= pivot;
+  }
+
+  m_info = Success;
+  m_structureReused = true;
 }
 
 template<typename MappedSupernodalType>
@@ -273,6 +273,43 @@ void sparselu_gemm(Index m, Index n, Index d, const Scalar* A, Index lda, const
 }
 #undef KMADD
 
+template<typename Scalar>
+struct sparselu_gemm_rows
+{
+  sparselu_gemm_rows(Index n, Index d, const Scalar* A, Index lda, const Scalar* B, Index ldb, Scalar* C, Index ldc, Index i0)
+    : m_n(n), m_d(d), m_A(A), m_lda(lda), m_B(B), m_ldb(ldb), m_C(C), m_ldc(ldc), m_i0(i0)
+  {}
+
+  // evaluates the rows [i0+start, i0+start+length) of C, and the first i0 non aligned rows with the first chunk
+  void operator()(Index start, Index length) const
+  {
+    Index i = start==0 ? 0 : m_i0+start;
+    if(start==0) length += m_i0;
+    sparselu_gemm<Scalar>(length, m_n, m_d, m_A+i, m_lda, m_B, m_ldb, m_C+i, m_ldc);
+  }
+
+  Index m_n, m_d;
+  const Scalar* m_A;
+  Index m_lda;
+  const Scalar* m_B;
+  Index m_ldb;
+  Scalar* m_C;
+  Index m_ldc, m_i0;
+};
+
+/** \internal
+  * Same as sparselu_gemm, but the rows of C are split among the threads available to Eigen.
+  * The rows are split at the boundaries of the chunks of sparselu_gemm, so that the result is
+  * exactly the same as the sequential one.
+  */
+template<typename Scalar>
+void sparselu_parallel_gemm(Index m, Index n, Index d, const Scalar* A, Index lda, const Scalar* B, Index ldb, Scalar* C, Index ldc)
+{
+  enum { BM = 4096/sizeof(Scalar) }; // must match the chunks of sparselu_gemm
+  Index i0 = internal::first_default_aligned(A,m);
+  parallelize_range<true>(sparselu_gemm_rows<Scalar>(n, d, A, lda, B, ldb, C, ldc, i0), m-i0, Index(BM), 2.*double(m)*double(n)*double(d));
+}
+
 } // namespace internal
 
 } // namespace Eigen
@@ -49,13 +49,14 @@ namespace internal {
  * \param segrep segment representative... first row in the segment
  * \param repfnz First nonzero rows
  * \param glu Global LU data. 
+ * \param parallel Whether the dense updates may be split among the threads
  * 
  * 
  */
 template <typename Scalar, typename StorageIndex>
 void SparseLUImpl<Scalar,StorageIndex>::panel_bmod(const Index m, const Index w, const Index jcol, 
                                             const Index nseg, ScalarVector& dense, ScalarVector& tempv,
-                                            IndexVector& segrep, IndexVector& repfnz, GlobalLU_t& glu)
+                                            IndexVector& segrep, IndexVector& repfnz, GlobalLU_t& glu, bool parallel)
 {
   
   Index ksub,jj,nextl_col; 
@@ -149,7 +150,10 @@ void SparseLUImpl<Scalar,StorageIndex>::panel_bmod(const Index m, const Index w,
       MappedMatrixBlock L(tempv.data()+w*ldu+offset, nrow, u_cols, OuterStride<>(ldl));
       
       L.setZero();
-      internal::sparselu_gemm<Scalar>(L.rows(), L.cols(), B.cols(), B.data(), B.outerStride(), U.data(), U.outerStride(), L.data(), L.outerStride());
+      if (parallel)
+        internal::sparselu_parallel_gemm<Scalar>(L.rows(), L.cols(), B.cols(), B.data(), B.outerStride(), U.data(), U.outerStride(), L.data(), L.outerStride());
+      else
+        internal::sparselu_gemm<Scalar>(L.rows(), L.cols(), B.cols(), B.data(), B.outerStride(), U.data(), U.outerStride(), L.data(), L.outerStride());
       
       // scatter U and L
       u_col = 0;
@@ -0,0 +1,253 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <sstream>
+
+#include "main.h"
+
+#if defined __GNUC__ && __GNUC__>=6
+  #pragma GCC diagnostic ignored "-Wignored-attributes"
+#endif
+
+// Make sure it's possible to forward declare Eigen::bfloat16
+namespace Eigen {
+struct bfloat16;
+}
+
+using Eigen::bfloat16;
+
+void test_conversion()
+{
+  using Eigen::bfloat16_impl::__bfloat16_raw;
+
+  // Conversion from float.
+  VERIFY_IS_EQUAL(bfloat16(1.0f).value, 0x3f80);
+  VERIFY_IS_EQUAL(bfloat16(0.5f).value, 0x3f00);
+  VERIFY_IS_EQUAL(bfloat16(0.33333f).value, 0x3eab);
+  VERIFY_IS_EQUAL(bfloat16(0.0f).value, 0x0000);
+  VERIFY_IS_EQUAL(bfloat16(-0.0f).value, 0x8000);
+  VERIFY_IS_EQUAL(bfloat16(3.38953139e38f).value, 0x7f7f);
+  VERIFY_IS_EQUAL(bfloat16((std::numeric_limits<float>::max)()).value, 0x7f80);  // Becomes infinity.
+
+  // Denormals.
+  VERIFY_IS_EQUAL(bfloat16(9.18354962e-41f).value, 0x0001);
+  VERIFY_IS_EQUAL(bfloat16(-9.18354962e-41f).value, 0x8001);
+
+  // Verify round-to-nearest-even behavior.
+  float val1 = float(bfloat16(__bfloat16_raw(0x3f80)));
+  float val2 = float(bfloat16(__bfloat16_raw(0x3f81)));
+  float val3 = float(bfloat16(__bfloat16_raw(0x3f82)));
+  VERIFY_IS_EQUAL(bfloat16(0.5f * (val1 + val2)).value, 0x3f80);
+  VERIFY_IS_EQUAL(bfloat16(0.5f * (val2 + val3)).value, 0x3f82);
+
+  // Conversion from int.
+  VERIFY_IS_EQUAL(bfloat16(-1).value, 0xbf80);
+  VERIFY_IS_EQUAL(bfloat16(0).value, 0x0000);
+  VERIFY_IS_EQUAL(bfloat16(1).value, 0x3f80);
+  VERIFY_IS_EQUAL(bfloat16(2).value, 0x4000);
+  VERIFY_IS_EQUAL(bfloat16(3).value, 0x4040);
+
+  // Conversion from bool.
+  VERIFY_IS_EQUAL(bfloat16(false).value, 0x0000);
+  VERIFY_IS_EQUAL(bfloat16(true).value, 0x3f80);
+
+  // Conversion to float is exact.
+  VERIFY_IS_EQUAL(float(bfloat16(__bfloat16_raw(0x0000))), 0.0f);
+  VERIFY_IS_EQUAL(float(bfloat16(__bfloat16_raw(0x3f80))), 1.0f);
+  VERIFY_IS_EQUAL(float(bfloat16(__bfloat16_raw(0xc0a0))), -5.0f);
+
+  // NaNs and infinities.
+  VERIFY(!(numext::isinf)(float(bfloat16(3.38953139e38f))));  // Largest finite number.
+  VERIFY(!(numext::isnan)(float(bfloat16(0.0f))));
+  VERIFY((numext::isinf)(float(bfloat16(__bfloat16_raw(0xff80)))));
+  VERIFY((numext::isnan)(float(bfloat16(__bfloat16_raw(0xffc0)))));
+  VERIFY((numext::isinf)(float(bfloat16(__bfloat16_raw(0x7f80)))));
+  VERIFY((numext::isnan)(float(bfloat16(__bfloat16_raw(0x7fc0)))));
+
+  // Signaling NaNs become quiet NaNs.
+  VERIFY((numext::isnan)(bfloat16(std::numeric_limits<float>::signaling_NaN())));
+
+#if !EIGEN_COMP_MSVC
+  // Visual Studio errors out on divisions by 0
+  VERIFY((numext::isnan)(float(bfloat16(0.0 / 0.0))));
+  VERIFY((numext::isinf)(float(bfloat16(1.0 / 0.0))));
+  VERIFY((numext::isinf)(float(bfloat16(-1.0 / 0.0))));
+#endif
+
+  // Exactly same checks as above, just directly on the bfloat16 representation.
+  VERIFY(!(numext::isinf)(bfloat16(__bfloat16_raw(0x7f7f))));
+  VERIFY(!(numext::isnan)(bfloat16(__bfloat16_raw(0x0000))));
+  VERIFY((numext::isinf)(bfloat16(__bfloat16_raw(0xff80))));
+  VERIFY((numext::isnan)(bfloat16(__bfloat16_raw(0xffc0))));
+  VERIFY((numext::isinf)(bfloat16(__bfloat16_raw(0x7f80))));
+  VERIFY((numext::isnan)(bfloat16(__bfloat16_raw(0x7fc0))));
+}
+
+void test_numtraits()
+{
+  VERIFY(NumTraits<bfloat16>::IsSigned);
+
+  VERIFY_IS_EQUAL( float(NumTraits<bfloat16>::epsilon()), 0.0078125f );
+  VERIFY_IS_EQUAL( std::numeric_limits<bfloat16>::infinity().value, bfloat16(std::numeric_limits<float>::infinity()).value );
+  VERIFY_IS_EQUAL( std::numeric_limits<bfloat16>::quiet_NaN().value, bfloat16(std::numeric_limits<float>::quiet_NaN()).value );
+  VERIFY_IS_EQUAL( float((std::numeric_limits<bfloat16>::min)()), (std::numeric_limits<float>::min)() );
+  VERIFY( (std::numeric_limits<bfloat16>::denorm_min)() > bfloat16(0.f) );
+  VERIFY( (std::numeric_limits<bfloat16>::min)()/bfloat16(2) > bfloat16(0.f) );
+  VERIFY_IS_EQUAL( (std::numeric_limits<bfloat16>::denorm_min)()/bfloat16(2), bfloat16(0.f) );
+  VERIFY( bfloat16(1.f) + NumTraits<bfloat16>::epsilon() > bfloat16(1.f) );
+}
+
+void test_arithmetic()
+{
+  VERIFY_IS_EQUAL(float(bfloat16(2) + bfloat16(2)), 4);
+  VERIFY_IS_EQUAL(float(bfloat16(2) + bfloat16(-2)), 0);
+  VERIFY_IS_APPROX(bfloat16(0.33333f) + bfloat16(0.66667f), bfloat16(1.0f));
+  VERIFY_IS_EQUAL(float(bfloat16(2.0f) * bfloat16(-5.5f)), -11.0f);
+  VERIFY_IS_APPROX(bfloat16(1.0f) / bfloat16(3.0f), bfloat16(0.33333f));
+  VERIFY_IS_EQUAL(float(-bfloat16(4096.0f)), -4096.0f);
+  VERIFY_IS_EQUAL(float(-bfloat16(-4096.0f)), 4096.0f);
+  // Same range as float.
+  VERIFY_IS_APPROX(bfloat16(1e30f) * bfloat16(1e-30f), bfloat16(1.0f));
+}
+
+void test_comparison()
+{
+  VERIFY(bfloat16(1.0f) > bfloat16(0.5f));
+  VERIFY(bfloat16(0.5f) < bfloat16(1.0f));
+  VERIFY(!(bfloat16(1.0f) < bfloat16(0.5f)));
+  VERIFY(!(bfloat16(0.5f) > bfloat16(1.0f)));
+
+  VERIFY(!(bfloat16(4.0f) > bfloat16(4.0f)));
+  VERIFY(!(bfloat16(4.0f) < bfloat16(4.0f)));
+
+  VERIFY(!(bfloat16(0.0f) < bfloat16(-0.0f)));
+  VERIFY(!(bfloat16(-0.0f) < bfloat16(0.0f)));
+
+  VERIFY(bfloat16(-16.0f) < bfloat16(-15.0f));
+  VERIFY(bfloat16(1.0f) == bfloat16(1.0f));
+  VERIFY(bfloat16(1.0f) != bfloat16(2.0f));
+
+#if !EIGEN_COMP_MSVC
+  // Visual Studio errors out on divisions by 0
+  VERIFY(!(bfloat16(0.0 / 0.0) == bfloat16(0.0 / 0.0)));
+  VERIFY(bfloat16(0.0 / 0.0) != bfloat16(0.0 / 0.0));
+  VERIFY(!(bfloat16(1.0) < bfloat16(0.0 / 0.0)));
+  VERIFY(bfloat16(1.0) < bfloat16(1.0 / 0.0));
+  VERIFY(bfloat16(1.0) > bfloat16(-1.0 / 0.0));
+#endif
+}
+
+void test_basic_functions()
+{
+  VERIFY_IS_EQUAL(float(numext::abs(bfloat16(3.5f))), 3.5f);
+  VERIFY_IS_EQUAL(float(abs(bfloat16(-3.5f))), 3.5f);
+  VERIFY_IS_EQUAL(float(numext::floor(bfloat16(-3.5f))), -4.0f);
+  VERIFY_IS_EQUAL(float(numext::ceil(bfloat16(3.5f))), 4.0f);
+  VERIFY_IS_APPROX(numext::sqrt(bfloat16(4.0f)), bfloat16(2.0f));
+  VERIFY_IS_APPROX(numext::pow(bfloat16(2.0f), bfloat16(2.0f)), bfloat16(4.0f));
+  VERIFY_IS_EQUAL(float(numext::exp(bfloat16(0.0f))), 1.0f);
+  VERIFY_IS_APPROX(numext::exp(bfloat16(EIGEN_PI)), bfloat16(20.f + float(EIGEN_PI)));
+  VERIFY_IS_EQUAL(float(numext::log(bfloat16(1.0f))), 0.0f);
+  VERIFY_IS_APPROX(numext::log(bfloat16(10.0f)), bfloat16(2.30273f));
+  VERIFY_IS_APPROX(numext::cos(bfloat16(3.5f)), bfloat16(cosf(3.5f)));
+  VERIFY_IS_APPROX(numext::sin(bfloat16(3.5f)), bfloat16(sinf(3.5f)));
+  VERIFY_IS_APPROX(numext::tanh(bfloat16(0.5f)), bfloat16(tanhf(0.5f)));
+}
+
+void test_packet_conversion()
+{
+#ifdef EIGEN_VECTORIZE_AVX
+  typedef internal::packet_traits<bfloat16>::type PacketBf16;
+  typedef internal::packet_traits<float>::type PacketF32;
+  enum { PacketSize = internal::unpacket_traits<PacketBf16>::size };
+  VERIFY_IS_EQUAL(int(PacketSize), int(internal::unpacket_traits<PacketF32>::size));
+
+  EIGEN_ALIGN_MAX float f[PacketSize];
+  EIGEN_ALIGN_MAX float g[PacketSize];
+  EIGEN_ALIGN_MAX bfloat16 b[PacketSize];
+  for(int i=0; i<PacketSize; ++i)
+    f[i] = internal::random<float>(-1e5f,1e5f);
+  f[0] = std::numeric_limits<float>::quiet_NaN();
+  f[1] = std::numeric_limits<float>::infinity();
+  // Ties are rounded to even.
+  f[2] = 0.5f * (float(bfloat16(bfloat16_impl::raw_uint16_to_bfloat16(0x3f80))) + float(bfloat16(bfloat16_impl::raw_uint16_to_bfloat16(0x3f81))));
+  f[3] = 0.5f * (float(bfloat16(bfloat16_impl::raw_uint16_to_bfloat16(0x3f81))) + float(bfloat16(bfloat16_impl::raw_uint16_to_bfloat16(0x3f82))));
+
+  internal::pstore(b, internal::pcast<PacketF32,PacketBf16>(internal::pload<PacketF32>(f)));
+  for(int i=0; i<PacketSize; ++i)
+    VERIFY_IS_EQUAL(b[i].value, bfloat16(f[i]).value);
+  VERIFY_IS_EQUAL(b[2].value, 0x3f80);
+  VERIFY_IS_EQUAL(b[3].value, 0x3f82);
+
+  internal::pstore(g, internal::pcast<PacketBf16,PacketF32>(internal::pload<PacketBf16>(b)));
+  VERIFY((numext::isnan)(g[0]));
+  for(int i=1; i<PacketSize; ++i)
+    VERIFY_IS_EQUAL(g[i], float(b[i]));
+#endif
+}
+
+void test_array()
+{
+  typedef Array<bfloat16,1,Dynamic> ArrayXbf;
+  Index size = internal::random<Index>(1,100);
+  Index i = internal::random<Index>(0,size-1);
+  ArrayXbf a1 = ArrayXbf::Random(size), a2 = ArrayXbf::Random(size);
+  VERIFY_IS_APPROX( a1+a1, bfloat16(2)*a1 );
+  VERIFY( (a1.abs() >= bfloat16(0)).all() );
+  VERIFY_IS_APPROX( (a1*a1).sqrt(), a1.abs() );
+
+  VERIFY( ((a1.min)(a2) <= (a1.max)(a2)).all() );
+  a1(i) = bfloat16(-10.);
+  VERIFY_IS_EQUAL( a1.minCoeff(), bfloat16(-10.) );
+  a1(i) = bfloat16(10.);
+  VERIFY_IS_EQUAL( a1.maxCoeff(), bfloat16(10.) );
+
+  std::stringstream ss;
+  ss << a1;
+}
+
+void test_product()
+{
+  typedef Matrix<bfloat16,Dynamic,Dynamic> MatrixXbf;
+  typedef Matrix<bfloat16,Dynamic,Dynamic,RowMajor> RowMatrixXbf;
+  Index rows  = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+  Index cols  = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+  Index depth = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+  MatrixXbf Ab = MatrixXbf::Random(rows,depth);
+  MatrixXbf Bb = MatrixXbf::Random(depth,cols);
+  MatrixXbf Cb = MatrixXbf::Random(rows,cols);
+  MatrixXf Af = Ab.cast<float>();
+  MatrixXf Bf = Bb.cast<float>();
+  MatrixXf Cf = Cb.cast<float>();
+  VERIFY_IS_APPROX(Cb.noalias()+=Ab*Bb, (Cf.noalias()+=Af*Bf).cast<bfloat16>());
+
+  RowMatrixXbf Ar = Ab;
+  VERIFY_IS_APPROX(MatrixXbf(Ar*Bb), MatrixXbf((Af*Bf).cast<bfloat16>()));
+  VERIFY_IS_APPROX(MatrixXbf(Bb.transpose()*Ar.transpose()), MatrixXbf((Bf.transpose()*Af.transpose()).cast<bfloat16>()));
+
+  // The products are accumulated in fp32: in bfloat16, the sum of ones would stall at 256.
+  rows  = internal::random<Index>(20,60);
+  cols  = internal::random<Index>(20,60);
+  depth = 512;
+  MatrixXbf D = MatrixXbf::Constant(rows,cols,bfloat16(0));
+  D.noalias() += MatrixXbf::Constant(rows,depth,bfloat16(1)) * MatrixXbf::Constant(depth,cols,bfloat16(1));
+  VERIFY_IS_EQUAL(D, MatrixXbf::Constant(rows,cols,bfloat16(512)));
+}
+
+EIGEN_DECLARE_TEST(bfloat16_float)
+{
+  CALL_SUBTEST(test_numtraits());
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST(test_conversion());
+    CALL_SUBTEST(test_arithmetic());
+    CALL_SUBTEST(test_comparison());
+    CALL_SUBTEST(test_basic_functions());
+    CALL_SUBTEST(test_packet_conversion());
+    CALL_SUBTEST(test_array());
+    CALL_SUBTEST(test_product());
+  }
+}
@@ -283,6 +283,65 @@ template<typename MatrixType> void cholesky(const MatrixType& m)
   CALL_SUBTEST(( test_chol_update<SquareMatrixType,LDLT>(symm) ));
 }
 
+template<typename MatrixType, int UpLo> void cholesky_ldlt_blocked_uplo(const MatrixType& a)
+{
+  typedef Transpositions<Dynamic,Dynamic> TranspositionType;
+  typedef Matrix<typename MatrixType::Scalar,Dynamic,1> VectorType;
+  const Index size = a.rows();
+  MatrixType m1 = a, m2 = a;
+  TranspositionType t1(size), t2(size);
+  VectorType temp1(size), temp2(size);
+  internal::SignMatrix s1 = internal::ZeroSign, s2 = internal::ZeroSign;
+  bool ok1 = internal::ldlt_inplace<UpLo>::unblocked(m1, t1, temp1, s1);
+  bool ok2 = internal::ldlt_inplace<UpLo>::blocked(m2, t2, temp2, s2);
+  VERIFY_IS_EQUAL(ok1, ok2);
+  VERIFY_IS_EQUAL(s1, s2);
+  VERIFY(t1.indices()==t2.indices());
+  MatrixType l1 = m1.template triangularView<UpLo>(), l2 = m2.template triangularView<UpLo>();
+  VERIFY_IS_APPROX(l1, l2);
+}
+
+template<typename MatrixType> void cholesky_ldlt_blocked(Index size)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+
+  // positive definite: same factorization as the unblocked version
+  MatrixType b = MatrixType::Random(size, size);
+  MatrixType a = b * b.adjoint();
+  cholesky_ldlt_blocked_uplo<MatrixType,Lower>(a);
+  cholesky_ldlt_blocked_uplo<MatrixType,Upper>(a);
+
+  // indefinite
+  a = b + b.adjoint();
+  LDLT<MatrixType,Lower> ldltlo(a);
+  VERIFY_IS_EQUAL(ldltlo.info(), Success);
+  VERIFY_IS_APPROX(a, ldltlo.reconstructedMatrix());
+  LDLT<MatrixType,Upper> ldltup(a);
+  VERIFY_IS_EQUAL(ldltup.info(), Success);
+  VERIFY_IS_APPROX(a, ldltup.reconstructedMatrix());
+
+  // positive semi-definite with exact zero pivots
+  Index rank = internal::random<Index>(1, size-1);
+  MatrixType c = MatrixType::Zero(size, size);
+  c.topLeftCorner(rank, rank) = b.topLeftCorner(rank, rank) * b.topLeftCorner(rank, rank).adjoint();
+  PermutationMatrix<Dynamic,Dynamic> p(size);
+  p.setIdentity();
+  for(Index i = size-1; i > 0; --i)
+    p.applyTranspositionOnTheRight(i, internal::random<Index>(0, i));
+  a = p * c * p.inverse();
+  cholesky_ldlt_blocked_uplo<MatrixType,Lower>(a);
+  ldltlo.compute(a);
+  VERIFY_IS_EQUAL(ldltlo.info(), Success);
+  VERIFY(ldltlo.isPositive());
+  VERIFY_IS_APPROX(a, ldltlo.reconstructedMatrix());
+
+  // zero diagonal
+  a.setZero();
+  a(size-1, 0) = a(0, size-1) = Scalar(RealScalar(1));
+  cholesky_ldlt_blocked_uplo<MatrixType,Lower>(a);
+}
+
 template<typename MatrixType> void cholesky_cplx(const MatrixType& m)
 {
   // classic test
@@ -510,6 +569,11 @@ EIGEN_DECLARE_TEST(cholesky)
     s = internal::random<int>(1,EIGEN_TEST_MAX_SIZE/2);
     CALL_SUBTEST_6( cholesky_cplx(MatrixXcd(s,s)) );
     TEST_SET_BUT_UNUSED_VARIABLE(s)
+
+    s = internal::random<int>(32,EIGEN_TEST_MAX_SIZE);
+    CALL_SUBTEST_2( cholesky_ldlt_blocked<MatrixXd>(s) );
+    CALL_SUBTEST_6( cholesky_ldlt_blocked<MatrixXcd>(s/2+16) );
+    TEST_SET_BUT_UNUSED_VARIABLE(s)
   }
   // empty matrix, regression test for Bug 785:
   CALL_SUBTEST_2( cholesky(MatrixXd(0,0)) );
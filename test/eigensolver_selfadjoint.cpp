@@ -190,6 +190,84 @@ template<typename MatrixType> void selfadjointeigensolver(const MatrixType& m)
   }
 }
 
+template<typename MatrixType> void tridiagonalization_blocked(Index size)
+{
+  // compare the blocked tridiagonalization to the unblocked one
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> CoeffVectorType;
+  MatrixType a = MatrixType::Random(size,size);
+  MatrixType symmA = a.adjoint() * a + a;
+  symmA.diagonal() = symmA.diagonal().real().template cast<Scalar>();
+
+  MatrixType ref = symmA, blocked = symmA;
+  CoeffVectorType refCoeffs(size-1), blockedCoeffs(size-1);
+  internal::tridiagonalization_inplace_unblocked(ref, refCoeffs);
+  const Index blockSize = internal::random<Index>(1,8);
+  internal::tridiagonalization_inplace_blocked(blocked, blockedCoeffs, blockSize, internal::random<Index>(1,3*blockSize));
+  VERIFY_IS_APPROX(blocked.template triangularView<Lower>().toDenseMatrix(), ref.template triangularView<Lower>().toDenseMatrix());
+  VERIFY_IS_APPROX(blockedCoeffs, refCoeffs);
+  VERIFY_IS_EQUAL(blocked.template triangularView<StrictlyUpper>().toDenseMatrix(), symmA.template triangularView<StrictlyUpper>().toDenseMatrix());
+
+  // the default path, which is blocked for large enough matrices
+  Tridiagonalization<MatrixType> tridiag(symmA);
+  VERIFY_IS_APPROX(MatrixType(symmA.template selfadjointView<Lower>()), tridiag.matrixQ() * tridiag.matrixT() * tridiag.matrixQ().adjoint());
+}
+
+template<typename MatrixType> void selfadjointeigensolver_divide_conquer(Index size)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<RealScalar,Dynamic,1> RealVectorType;
+
+  MatrixType a = MatrixType::Random(size,size);
+  MatrixType symmA = a.adjoint() * a + a + a.adjoint();
+
+  // compare to the QR algorithm
+  SelfAdjointEigenSolver<MatrixType> eiRef(symmA), eiDC(symmA, ComputeEigenvectors|DivideAndConquer);
+  VERIFY_IS_EQUAL(eiDC.info(), Success);
+  VERIFY_IS_APPROX(eiDC.eigenvalues(), eiRef.eigenvalues());
+  VERIFY_IS_APPROX(symmA * eiDC.eigenvectors(), eiDC.eigenvectors() * eiDC.eigenvalues().asDiagonal());
+  VERIFY(eiDC.eigenvectors().isUnitary(test_precision<RealScalar>()));
+
+  // clustered eigenvalues, most of them being deflated
+  RealVectorType values(size);
+  for(Index i=0; i<size; ++i)
+    values(i) = RealScalar(i%4) + (i%3==0 ? RealScalar(0) : NumTraits<RealScalar>::epsilon()*RealScalar(i));
+  HouseholderQR<MatrixType> qr(a);
+  MatrixType q = qr.householderQ();
+  MatrixType symmC = q * values.asDiagonal() * q.adjoint();
+  eiDC.compute(symmC, ComputeEigenvectors|DivideAndConquer);
+  VERIFY_IS_EQUAL(eiDC.info(), Success);
+  std::sort(values.data(), values.data()+size);
+  VERIFY_IS_APPROX(eiDC.eigenvalues(), values);
+  VERIFY_IS_APPROX(symmC * eiDC.eigenvectors(), eiDC.eigenvectors() * eiDC.eigenvalues().asDiagonal());
+  VERIFY(eiDC.eigenvectors().isUnitary(test_precision<RealScalar>()));
+
+  // from a tridiagonal matrix, with a zero and a tiny off-diagonal entry
+  RealVectorType diag = RealVectorType::Random(size), subdiag = RealVectorType::Random(size-1);
+  if(size>2)
+  {
+    subdiag(internal::random<Index>(0,size-2)) = RealScalar(0);
+    subdiag(internal::random<Index>(0,size-2)) = NumTraits<RealScalar>::epsilon();
+  }
+  Matrix<RealScalar,Dynamic,Dynamic> T = Matrix<RealScalar,Dynamic,Dynamic>::Zero(size,size);
+  T.diagonal() = diag;
+  T.diagonal(-1) = subdiag;
+  T.diagonal(1) = subdiag;
+  SelfAdjointEigenSolver<MatrixType> eiTridiag;
+  eiTridiag.computeFromTridiagonal(diag, subdiag, ComputeEigenvectors|DivideAndConquer);
+  VERIFY_IS_EQUAL(eiTridiag.info(), Success);
+  VERIFY_IS_APPROX(T.template cast<Scalar>() * eiTridiag.eigenvectors(), eiTridiag.eigenvectors() * eiTridiag.eigenvalues().asDiagonal());
+  VERIFY(eiTridiag.eigenvectors().isUnitary(test_precision<RealScalar>()));
+
+  // generalized problem
+  MatrixType b = MatrixType::Random(size,size);
+  MatrixType symmB = b.adjoint() * b + MatrixType::Identity(size,size);
+  GeneralizedSelfAdjointEigenSolver<MatrixType> eiGen(symmA, symmB, ComputeEigenvectors|Ax_lBx|DivideAndConquer);
+  VERIFY_IS_EQUAL(eiGen.info(), Success);
+  VERIFY_IS_APPROX(symmA * eiGen.eigenvectors(), symmB * eiGen.eigenvectors() * eiGen.eigenvalues().asDiagonal());
+}
+
 template<int>
 void bug_854()
 {
@@ -251,6 +329,15 @@ EIGEN_DECLARE_TEST(eigensolver_selfadjoint)
     CALL_SUBTEST_9( selfadjointeigensolver(Matrix<std::complex<double>,Dynamic,Dynamic,RowMajor>(s,s)) );
     TEST_SET_BUT_UNUSED_VARIABLE(s)
 
+    s = internal::random<int>(2,EIGEN_TEST_MAX_SIZE);
+    CALL_SUBTEST_4( tridiagonalization_blocked<MatrixXd>(s) );
+    CALL_SUBTEST_5( tridiagonalization_blocked<MatrixXcd>(s) );
+    CALL_SUBTEST_9(( tridiagonalization_blocked<Matrix<std::complex<double>,Dynamic,Dynamic,RowMajor> >(s) ));
+    CALL_SUBTEST_4( selfadjointeigensolver(MatrixXd(EIGEN_TEST_MAX_SIZE/2,EIGEN_TEST_MAX_SIZE/2)) );
+    CALL_SUBTEST_3( selfadjointeigensolver_divide_conquer<MatrixXf>(s) );
+    CALL_SUBTEST_4( selfadjointeigensolver_divide_conquer<MatrixXd>(s) );
+    CALL_SUBTEST_5( selfadjointeigensolver_divide_conquer<MatrixXcd>(s) );
+
     // some trivial but implementation-wise tricky cases
     CALL_SUBTEST_4( selfadjointeigensolver(MatrixXd(1,1)) );
     CALL_SUBTEST_4( selfadjointeigensolver(MatrixXd(2,2)) );
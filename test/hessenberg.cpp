@@ -49,6 +49,22 @@ template<typename Scalar,int Size> void hessenberg(int size = Size)
   // TODO: Add tests for packedMatrix() and householderCoefficients()
 }
 
+template<typename MatrixType> void hessenberg_blocked(int size)
+{
+  typedef Matrix<typename MatrixType::Scalar,Dynamic,1> VectorType;
+
+  // The blocked reduction, run here with small blocks, must reduce the leading columns
+  // as the unblocked one does.
+  MatrixType m = MatrixType::Random(size,size);
+  HessenbergDecomposition<MatrixType> hess(m);
+  MatrixType packed = m;
+  VectorType hCoeffs(size-1);
+  Index start = internal::hessenberg_decomposition_blocked(packed, hCoeffs, 4, 8);
+  VERIFY(start > 0 && start < size-1);
+  VERIFY_IS_APPROX(packed.leftCols(start), hess.packedMatrix().leftCols(start));
+  VERIFY_IS_APPROX(hCoeffs.head(start), hess.householderCoefficients().head(start));
+}
+
 EIGEN_DECLARE_TEST(hessenberg)
 {
   CALL_SUBTEST_1(( hessenberg<std::complex<double>,1>() ));
@@ -56,6 +72,10 @@ EIGEN_DECLARE_TEST(hessenberg)
   CALL_SUBTEST_3(( hessenberg<std::complex<float>,4>() ));
   CALL_SUBTEST_4(( hessenberg<float,Dynamic>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) ));
   CALL_SUBTEST_5(( hessenberg<std::complex<double>,Dynamic>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE)) ));
+  CALL_SUBTEST_4(( hessenberg_blocked<MatrixXf>(internal::random<int>(9,EIGEN_TEST_MAX_SIZE/4)) ));
+  CALL_SUBTEST_5(( hessenberg_blocked<MatrixXcd>(internal::random<int>(9,EIGEN_TEST_MAX_SIZE/4)) ));
+  CALL_SUBTEST_7(( hessenberg_blocked<Matrix<double,Dynamic,Dynamic,RowMajor> >(internal::random<int>(9,EIGEN_TEST_MAX_SIZE/4)) ));
+  CALL_SUBTEST_7(( hessenberg<double,Dynamic>(internal::random<int>(EIGEN_TEST_MAX_SIZE/2,EIGEN_TEST_MAX_SIZE)) ));
 
   // Test problem size constructors
   CALL_SUBTEST_6(HessenbergDecomposition<MatrixXf>(10));
@@ -152,6 +152,49 @@ template<typename MatrixType> void lu_invertible()
   VERIFY_IS_APPROX(lu.solve(m3*m4), lu.solve(m3)*m4);
 }
 
+template<typename MatrixType> void lu_blocked()
+{
+  /* this test covers the factorization by panels of FullPivLU.h
+  */
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  typedef Matrix<RealScalar,Dynamic,1> RealVectorType;
+
+  Index rows = internal::random<Index>(100,100+EIGEN_TEST_MAX_SIZE);
+  Index cols = internal::random<Index>(100,100+EIGEN_TEST_MAX_SIZE);
+  Index rank = internal::random<Index>(40,(std::min)(rows,cols)-20);
+
+  // a graded spectrum, so that the rook pivots of the panels often fall below the biggest coefficient
+  RealVectorType sv(rank);
+  const RealScalar smallest = numext::sqrt(numext::sqrt(NumTraits<RealScalar>::epsilon()));
+  for(Index i = 0; i < rank; ++i)
+    sv(i) = numext::pow(smallest, RealScalar(i)/RealScalar(rank-1));
+  MatrixType u = HouseholderQR<MatrixType>(MatrixType::Random(rows,rank)).householderQ() * MatrixType::Identity(rows,rank);
+  MatrixType v = HouseholderQR<MatrixType>(MatrixType::Random(cols,rank)).householderQ() * MatrixType::Identity(cols,rank);
+  MatrixType m1 = u * sv.template cast<Scalar>().asDiagonal() * v.adjoint();
+
+  FullPivLU<MatrixType> lu(m1);
+  VERIFY_IS_APPROX(m1, lu.reconstructedMatrix());
+  VERIFY_IS_EQUAL(lu.rank(), rank);
+  VERIFY_IS_EQUAL(lu.dimensionOfKernel(), cols-rank);
+
+  MatrixType m1kernel = lu.kernel();
+  VERIFY_IS_EQUAL(m1kernel.cols(), cols-rank);
+  VERIFY_IS_MUCH_SMALLER_THAN((m1 * m1kernel), m1);
+  VERIFY_IS_EQUAL(m1kernel.fullPivLu().rank(), cols-rank);
+
+  MatrixType m1image = lu.image(m1);
+  VERIFY_IS_EQUAL(m1image.cols(), rank);
+  VERIFY_IS_EQUAL(m1image.fullPivLu().rank(), rank);
+  VERIFY_IS_APPROX(u * (u.adjoint() * m1image), m1image);
+
+  // the full rank case
+  m1.setRandom(rows, cols);
+  lu.compute(m1);
+  VERIFY_IS_APPROX(m1, lu.reconstructedMatrix());
+  VERIFY_IS_EQUAL(lu.rank(), (std::min)(rows,cols));
+}
+
 template<typename MatrixType> void lu_partial_piv(Index size = MatrixType::ColsAtCompileTime)
 {
   /* this test covers the following files:
@@ -248,5 +291,8 @@ EIGEN_DECLARE_TEST(lu)
     // Test problem size constructors
     CALL_SUBTEST_9( PartialPivLU<MatrixXf>(10) );
     CALL_SUBTEST_9( FullPivLU<MatrixXf>(10, 20); );
+
+    CALL_SUBTEST_10( lu_blocked<MatrixXd>() );
+    CALL_SUBTEST_10( lu_blocked<MatrixXcf>() );
   }
 }
@@ -428,6 +428,7 @@ EIGEN_TEST_SCALAR_TEST_OVERLOAD(unsigned long long)
 EIGEN_TEST_SCALAR_TEST_OVERLOAD(float)
 EIGEN_TEST_SCALAR_TEST_OVERLOAD(double)
 EIGEN_TEST_SCALAR_TEST_OVERLOAD(half)
+EIGEN_TEST_SCALAR_TEST_OVERLOAD(bfloat16)
 
 #undef EIGEN_TEST_SCALAR_TEST_OVERLOAD
 
@@ -0,0 +1,137 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse_solver.h"
+#include <Eigen/SparseCholesky>
+#include <Eigen/SparseLU>
+
+// Laplacian of a n x n x nz grid
+template<typename T> SparseMatrix<T> grid_laplacian(int n, int nz)
+{
+  int size = n*n*nz;
+  std::vector<Triplet<T> > triplets;
+  for(int i = 0; i < n; ++i)
+    for(int j = 0; j < n; ++j)
+      for(int k = 0; k < nz; ++k)
+      {
+        int id = (i*n+j)*nz+k;
+        triplets.push_back(Triplet<T>(id, id, T(6.1)));
+        if(i+1 < n)  triplets.push_back(Triplet<T>(id+n*nz, id, T(-1)));
+        if(j+1 < n)  triplets.push_back(Triplet<T>(id+nz, id, T(-1)));
+        if(k+1 < nz) triplets.push_back(Triplet<T>(id+1, id, T(-1)));
+      }
+  SparseMatrix<T> A(size, size);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  return A;
+}
+
+template<typename T> void test_nested_dissection_permutation()
+{
+  typedef SparseMatrix<T> MatrixType;
+  typedef PermutationMatrix<Dynamic,Dynamic,int> PermutationType;
+  int n = internal::random<int>(8,14);
+  int nz = internal::random<int>(1,n);
+  MatrixType A = grid_laplacian<T>(n, nz);
+  MatrixType fullA = MatrixType(A.template selfadjointView<Lower>());
+
+  NestedDissectionOrdering<int> ordering;
+  ordering.setLeafSize(internal::random<int>(1,40));
+  PermutationType p1, p2;
+  ordering(A.template selfadjointView<Lower>(), p1);
+  ordering(fullA, p2);
+  VERIFY_IS_EQUAL(p1.size(), A.rows());
+  VERIFY_IS_EQUAL(p2.size(), A.rows());
+
+  // every index appears exactly once
+  std::vector<bool> seen(A.rows(), false);
+  for(Index i = 0; i < p1.size(); ++i)
+  {
+    VERIFY(p1.indices()(i) >= 0 && p1.indices()(i) < A.rows());
+    VERIFY(!seen[p1.indices()(i)]);
+    seen[p1.indices()(i)] = true;
+  }
+  VERIFY(p1.indices() == p2.indices());
+
+  // the permuted matrix is factored without pivoting
+  MatrixType B(A.rows(), A.cols());
+  B.template selfadjointView<Lower>() = A.template selfadjointView<Lower>().twistedBy(p1.inverse());
+  SimplicialLLT<MatrixType, Lower, NaturalOrdering<int> > llt(B);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+  Matrix<T,Dynamic,1> b = Matrix<T,Dynamic,1>::Random(A.rows());
+  Matrix<T,Dynamic,1> x = p1 * llt.solve(p1.inverse() * b);
+  VERIFY_IS_APPROX(fullA * x, b);
+}
+
+// block diagonal matrix made of many small blocks and a few grids, i.e., a graph with many connected components
+template<typename T> void test_nested_dissection_components()
+{
+  typedef SparseMatrix<T> MatrixType;
+  typedef PermutationMatrix<Dynamic,Dynamic,int> PermutationType;
+  MatrixType grid = grid_laplacian<T>(internal::random<int>(6,10), 1);
+  grid = MatrixType(grid.template selfadjointView<Lower>());
+  int nblocks = internal::random<int>(500,1000);
+  std::vector<Triplet<T> > triplets;
+  int size = 0;
+  for(int b = 0; b < nblocks; ++b)
+  {
+    if(b % 200 == 0)
+    {
+      for(int j = 0; j < grid.outerSize(); ++j)
+        for(typename MatrixType::InnerIterator it(grid, j); it; ++it)
+          triplets.push_back(Triplet<T>(size+int(it.row()), size+j, it.value()));
+      size += int(grid.rows());
+    }
+    int bs = internal::random<int>(1,3);
+    for(int i = 0; i < bs; ++i)
+      for(int j = 0; j < bs; ++j)
+        triplets.push_back(Triplet<T>(size+i, size+j, i==j ? T(4) : T(-1)));
+    size += bs;
+  }
+  MatrixType A(size, size);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+
+  NestedDissectionOrdering<int> ordering;
+  ordering.setLeafSize(internal::random<int>(1,60));
+  PermutationType p;
+  ordering(A, p);
+  VERIFY_IS_EQUAL(p.size(), A.rows());
+  std::vector<bool> seen(A.rows(), false);
+  for(Index i = 0; i < p.size(); ++i)
+  {
+    VERIFY(p.indices()(i) >= 0 && p.indices()(i) < A.rows());
+    VERIFY(!seen[p.indices()(i)]);
+    seen[p.indices()(i)] = true;
+  }
+
+  SimplicialLDLT<MatrixType, Lower, NestedDissectionOrdering<int> > ldlt(A);
+  VERIFY_IS_EQUAL(ldlt.info(), Success);
+  Matrix<T,Dynamic,1> b = Matrix<T,Dynamic,1>::Random(A.rows());
+  VERIFY_IS_APPROX(A * ldlt.solve(b), b);
+}
+
+template<typename T> void test_nested_dissection_T()
+{
+  typedef SparseMatrix<T,ColMajor> MatrixType;
+  SimplicialLLT<MatrixType, Lower, NestedDissectionOrdering<int> > llt;
+  SimplicialLDLT<MatrixType, Upper, NestedDissectionOrdering<int> > ldlt;
+  SparseLU<MatrixType, NestedDissectionOrdering<int> > lu;
+
+  check_sparse_spd_solving(llt);
+  check_sparse_spd_solving(ldlt);
+  check_sparse_square_solving(lu);
+}
+
+EIGEN_DECLARE_TEST(nested_dissection)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(test_nested_dissection_permutation<double>());
+    CALL_SUBTEST_2(test_nested_dissection_permutation<float>());
+    CALL_SUBTEST_1(test_nested_dissection_components<double>());
+  }
+  CALL_SUBTEST_3(test_nested_dissection_T<double>());
+  CALL_SUBTEST_4(test_nested_dissection_T<std::complex<double> >());
+}
@@ -623,6 +623,61 @@ template<typename Scalar,typename Packet> void packetmath_real()
   }
 }
 
+// Returns the distance in ulps between a reference value and an approximation of it.
+template<typename Scalar> Scalar ulp_error(const Scalar& ref, const Scalar& val)
+{
+  if(internal::biteq(ref,val) || ref==val) return Scalar(0);
+  if(!(numext::isfinite)(ref) || !(numext::isfinite)(val)) return NumTraits<Scalar>::infinity();
+  int e;
+  std::frexp(ref, &e);
+  Scalar ulp = std::ldexp(NumTraits<Scalar>::epsilon(), (std::max)(e-1, std::numeric_limits<Scalar>::min_exponent-1));
+  return numext::abs(ref-val) / ulp;
+}
+
+#define CHECK_CWISE1_ULP_IF(COND, REFOP, POP, MAXULP) if(COND) { \
+  packet_helper<COND,Packet> h; \
+  Scalar max_err = 0; \
+  for (int j=0; j<size; j+=PacketSize) { \
+    for (int i=0; i<PacketSize; ++i) \
+      ref[i] = REFOP(data[j+i]); \
+    h.store(data2, POP(h.load(data+j))); \
+    for (int i=0; i<PacketSize; ++i) \
+      max_err = (std::max)(max_err, ulp_error(ref[i], data2[i])); \
+  } \
+  VERIFY(max_err <= Scalar(MAXULP) && #POP); \
+}
+
+// Checks the accuracy of the vectorized double precision functions against the ones of the libm.
+template<typename Scalar,typename Packet> void packetmath_real_ulp()
+{
+  typedef internal::packet_traits<Scalar> PacketTraits;
+  const int PacketSize = internal::unpacket_traits<Packet>::size;
+
+  const int size = PacketSize*256;
+  EIGEN_ALIGN_MAX Scalar data[PacketSize*256];
+  EIGEN_ALIGN_MAX Scalar data2[PacketSize];
+  EIGEN_ALIGN_MAX Scalar ref[PacketSize];
+
+  for (int i=0; i<size; ++i)
+    data[i] = std::pow(Scalar(10), internal::random<Scalar>(-300,300));
+  data[0] = (std::numeric_limits<Scalar>::min)();
+  data[1] = std::numeric_limits<Scalar>::denorm_min() * Scalar(12345);
+  CHECK_CWISE1_ULP_IF(PacketTraits::HasLog, std::log, internal::plog, 2);
+
+  for (int i=0; i<size; ++i)
+    data[i] = internal::random<Scalar>(Scalar(0.5),Scalar(2));
+  CHECK_CWISE1_ULP_IF(PacketTraits::HasLog, std::log, internal::plog, 2);
+
+  for (int i=0; i<size; ++i)
+    data[i] = internal::random<Scalar>(-1,1) * std::pow(Scalar(10), internal::random<Scalar>(-3,4));
+  CHECK_CWISE1_ULP_IF(PacketTraits::HasSin, std::sin, internal::psin, 2);
+  CHECK_CWISE1_ULP_IF(PacketTraits::HasCos, std::cos, internal::pcos, 2);
+
+  for (int i=0; i<size; ++i)
+    data[i] = internal::random<Scalar>(-1,1) * std::pow(Scalar(10), internal::random<Scalar>(-6,2));
+  CHECK_CWISE1_ULP_IF(PacketTraits::HasTanh, std::tanh, internal::ptanh, 2);
+}
+
 template<typename Scalar,typename Packet> void packetmath_notcomplex()
 {
   using std::abs;
@@ -787,6 +842,8 @@ struct runall<Scalar,PacketType,false,false> { // i.e. float or double
     packetmath_scatter_gather<Scalar,PacketType>();
     packetmath_notcomplex<Scalar,PacketType>();
     packetmath_real<Scalar,PacketType>();
+    if(internal::is_same<Scalar,double>::value)
+      packetmath_real_ulp<Scalar,PacketType>();
   }
 };
 
@@ -154,6 +154,32 @@ template<typename MatrixType> void qr()
   }
 }
 
+template<typename MatrixType> void qr_blocked()
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+
+  // large enough to be factored by panels, with norms to be recomputed within the panels
+  Index rows = internal::random<Index>(100,2*EIGEN_TEST_MAX_SIZE), cols = internal::random<Index>(70,EIGEN_TEST_MAX_SIZE);
+  Index rank = internal::random<Index>(1, (std::min)(rows, cols)-1);
+  MatrixType m1;
+  createRandomPIMatrixOfRank(rank,rows,cols,m1);
+  ColPivHouseholderQR<MatrixType> qr(m1);
+  VERIFY_IS_EQUAL(rank, qr.rank());
+
+  MatrixType r = qr.matrixQR().template triangularView<Upper>();
+  MatrixType c = qr.householderQ() * r * qr.colsPermutation().inverse();
+  VERIFY_IS_APPROX(m1, c);
+
+  RealScalar threshold = numext::sqrt(RealScalar(rows)) * numext::abs(r(0, 0)) * NumTraits<Scalar>::epsilon();
+  for (Index i = 0; i < (std::min)(rows, cols) - 1; ++i) {
+    RealScalar x = numext::abs(r(i, i));
+    RealScalar y = numext::abs(r(i + 1, i + 1));
+    if (x < threshold && y < threshold) continue;
+    VERIFY_IS_APPROX_OR_LESS_THAN(y, x);
+  }
+}
+
 template<typename MatrixType, int Cols2> void qr_fixedsize()
 {
   using std::sqrt;
@@ -324,6 +350,9 @@ EIGEN_DECLARE_TEST(qr_colpivoting)
     CALL_SUBTEST_4(( qr_fixedsize<Matrix<float,3,5>, 4 >() ));
     CALL_SUBTEST_5(( qr_fixedsize<Matrix<double,6,2>, 3 >() ));
     CALL_SUBTEST_5(( qr_fixedsize<Matrix<double,1,1>, 1 >() ));
+    CALL_SUBTEST_2( qr_blocked<MatrixXd>() );
+    CALL_SUBTEST_3( qr_blocked<MatrixXcd>() );
+    CALL_SUBTEST_10(( qr_blocked<Matrix<float,Dynamic,Dynamic,RowMajor> >() ));
   }
 
   for(int i = 0; i < g_repeat; i++) {
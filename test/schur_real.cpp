@@ -104,6 +104,8 @@ EIGEN_DECLARE_TEST(schur_real)
   CALL_SUBTEST_2(( schur<MatrixXd>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE/4)) ));
   CALL_SUBTEST_3(( schur<Matrix<float, 1, 1> >() ));
   CALL_SUBTEST_4(( schur<Matrix<double, 3, 3, Eigen::RowMajor> >() ));
+  // large enough to use multishift sweeps and aggressive early deflation
+  CALL_SUBTEST_6(( schur<MatrixXd>(internal::random<int>(EIGEN_TEST_MAX_SIZE/4,EIGEN_TEST_MAX_SIZE)) ));
 
   // Test problem size constructors
   CALL_SUBTEST_5(RealSchur<MatrixXf>(10));
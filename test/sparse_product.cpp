@@ -459,14 +459,84 @@ void test_mixing_types()
   VERIFY_IS_APPROX( dC2 = sC1 * dR1.col(0), dC3 = sC1 * dR1.template cast<Cplx>().col(0) );
 }
 
+template<typename SparseMatrixType> void sparse_product_plan()
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef SparseMatrix<Scalar,ColMajor> ColSpMat;
+  typedef SparseMatrix<Scalar,RowMajor> RowSpMat;
+  Index n = 100;
+  const Index rows  = internal::random<Index>(1,n);
+  const Index cols  = internal::random<Index>(1,n);
+  const Index depth = internal::random<Index>(1,n);
+  double density = (std::max)(8./(rows*cols), 0.2);
+
+  DenseMatrix refA = DenseMatrix::Zero(rows, depth);
+  DenseMatrix refB = DenseMatrix::Zero(depth, cols);
+  ColSpMat a(rows, depth);
+  RowSpMat b(depth, cols);
+  initSparse(density, refA, a);
+  initSparse(density, refB, b);
+  a.makeCompressed();
+  b.makeCompressed();
+
+  SparseProductPlan<SparseMatrixType> plan(a, b);
+  VERIFY_IS_EQUAL(plan.rows(), rows);
+  VERIFY_IS_EQUAL(plan.cols(), cols);
+  SparseMatrixType res, ref = a * b;
+  VERIFY_IS_EQUAL(plan.nonZeros(), ref.nonZeros());
+  plan.evaluate(a, b, res);
+  VERIFY(res.isCompressed());
+  VERIFY_IS_EQUAL(res.nonZeros(), ref.nonZeros());
+  VERIFY_IS_APPROX(res, ref);
+  VERIFY_IS_APPROX(DenseMatrix(res), refA * refB);
+  for(Index j = 0; j < res.outerSize(); ++j)
+    for(Index k = res.outerIndexPtr()[j]+1; k < res.outerIndexPtr()[j+1]; ++k)
+      VERIFY(res.innerIndexPtr()[k-1] < res.innerIndexPtr()[k]);
+
+  // same patterns, new values
+  a.coeffs().setRandom();
+  b.coeffs().setRandom();
+  plan.evaluate(a, b, res);
+  VERIFY_IS_EQUAL(res.nonZeros(), ref.nonZeros());
+  VERIFY_IS_APPROX(DenseMatrix(res), DenseMatrix(a) * DenseMatrix(b));
+
+  // transposed operands, and a triple product
+  plan.analyzePattern(b.transpose(), a.transpose());
+  plan.evaluate(b.transpose(), a.transpose(), res);
+  VERIFY_IS_APPROX(DenseMatrix(res), (DenseMatrix(a) * DenseMatrix(b)).transpose());
+
+  SparseMatrixType ab;
+  SparseProductPlan<SparseMatrixType> plan1(a, b);
+  plan1.evaluate(a, b, ab);
+  SparseProductPlan<SparseMatrixType> plan2(a.transpose(), ab);
+  plan2.evaluate(a.transpose(), ab, res);
+  VERIFY_IS_APPROX(DenseMatrix(res), DenseMatrix(a).transpose() * DenseMatrix(a) * DenseMatrix(b));
+
+  // entries outside of the analyzed patterns, and aliasing
+  SparseMatrixType id(depth, depth), other(depth, depth);
+  id.setIdentity();
+  other.setIdentity();
+  other.insert(0, depth-1) = Scalar(1);
+  SparseProductPlan<SparseMatrixType> plan3(id, id);
+  plan3.evaluate(id, id, res);
+  VERIFY_IS_APPROX(res, id);
+  if(depth>1)
+    VERIFY_RAISES_ASSERT(plan3.evaluate(other, id, res));
+  VERIFY_RAISES_ASSERT(plan3.evaluate(id, id, id));
+}
+
 EIGEN_DECLARE_TEST(sparse_product)
 {
   for(int i = 0; i < g_repeat; i++) {
     CALL_SUBTEST_1( (sparse_product<SparseMatrix<double,ColMajor> >()) );
     CALL_SUBTEST_1( (sparse_product<SparseMatrix<double,RowMajor> >()) );
     CALL_SUBTEST_1( (bug_942<double>()) );
+    CALL_SUBTEST_1( (sparse_product_plan<SparseMatrix<double,ColMajor> >()) );
+    CALL_SUBTEST_1( (sparse_product_plan<SparseMatrix<double,RowMajor> >()) );
     CALL_SUBTEST_2( (sparse_product<SparseMatrix<std::complex<double>, ColMajor > >()) );
     CALL_SUBTEST_2( (sparse_product<SparseMatrix<std::complex<double>, RowMajor > >()) );
+    CALL_SUBTEST_2( (sparse_product_plan<SparseMatrix<std::complex<double>, ColMajor > >()) );
     CALL_SUBTEST_3( (sparse_product<SparseMatrix<float,ColMajor,long int> >()) );
     CALL_SUBTEST_4( (sparse_product_regression_test<SparseMatrix<double,RowMajor>, Matrix<double, Dynamic, Dynamic, RowMajor> >()) );
 
@@ -36,10 +36,91 @@ template<typename T> void test_sparselu_T()
   check_sparse_square_determinant(sparselu_amd);
 }
 
+template<typename T> void test_sparselu_refactorize()
+{
+  typedef SparseMatrix<T, ColMajor> SparseMatrixType;
+  typedef Matrix<T, Dynamic, 1> DenseVector;
+  typedef typename NumTraits<T>::Real RealScalar;
+  Index size = internal::random<Index>(1,300);
+  std::vector<Triplet<T> > triplets;
+  for(Index j = 0; j < size; ++j)
+  {
+    triplets.push_back(Triplet<T>(j, j, T(4) + internal::random<T>()));
+    for(int k = 0; k < 3; ++k)
+      triplets.push_back(Triplet<T>(internal::random<Index>(0,size-1), j, internal::random<T>()));
+  }
+  SparseMatrixType A(size, size);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  DenseVector b = DenseVector::Random(size);
+
+  SparseLU<SparseMatrixType> lu;
+  lu.compute(A);
+  VERIFY_IS_EQUAL(lu.info(), Success);
+  VERIFY(!lu.structureReused());
+
+  // same pattern, slightly different values: the pivots are kept
+  SparseMatrixType A2 = A;
+  for(Index k = 0; k < A2.nonZeros(); ++k)
+    A2.valuePtr()[k] *= T(1) + T(RealScalar(0.01)) * internal::random<T>();
+  lu.refactorize(A2);
+  VERIFY_IS_EQUAL(lu.info(), Success);
+  VERIFY(lu.structureReused());
+  SparseLU<SparseMatrixType> ref(A2);
+  VERIFY_IS_APPROX(lu.solve(b), ref.solve(b));
+  VERIFY_IS_APPROX(lu.logAbsDeterminant(), ref.logAbsDeterminant());
+
+  // the structure can be reused several times
+  SparseMatrixType A3 = A2 * T(2);
+  lu.refactorize(A3);
+  VERIFY_IS_EQUAL(lu.info(), Success);
+  VERIFY(lu.structureReused());
+  VERIFY_IS_APPROX(lu.solve(b), ref.solve(b) / T(2));
+
+  // entirely new values, the pivots may be rejected
+  SparseMatrixType A4 = A;
+  for(Index k = 0; k < A4.nonZeros(); ++k)
+    A4.valuePtr()[k] = internal::random<T>();
+  A4.diagonal() *= T(10);
+  lu.refactorize(A4);
+  VERIFY_IS_EQUAL(lu.info(), Success);
+  ref.compute(A4);
+  VERIFY_IS_APPROX(lu.solve(b), ref.solve(b));
+
+  // a new analysis invalidates the previous structure
+  SparseMatrixType A5 = A4;
+  for(Index j = 0; j + 1 < size; ++j)
+    A5.coeffRef(j+1, j) += T(1);
+  lu.compute(A);
+  lu.analyzePattern(A5);
+  lu.refactorize(A5);
+  VERIFY_IS_EQUAL(lu.info(), Success);
+  VERIFY(!lu.structureReused());
+  ref.compute(A5);
+  VERIFY_IS_APPROX(lu.solve(b), ref.solve(b));
+
+  // the entries outside of the previous pattern are detected
+  if(size > 1)
+  {
+    SparseMatrixType D(size, size), D2(size, size);
+    D.setIdentity();
+    D2.setIdentity();
+    D2.insert(size-1, 0) = T(1);
+    lu.compute(D);
+    VERIFY_RAISES_ASSERT(lu.refactorize(D2));
+  }
+}
+
 EIGEN_DECLARE_TEST(sparselu)
 {
   CALL_SUBTEST_1(test_sparselu_T<float>()); 
   CALL_SUBTEST_2(test_sparselu_T<double>());
   CALL_SUBTEST_3(test_sparselu_T<std::complex<float> >()); 
   CALL_SUBTEST_4(test_sparselu_T<std::complex<double> >());
+  for(int i = 0; i < g_repeat; i++)
+  {
+    CALL_SUBTEST_1(test_sparselu_refactorize<float>());
+    CALL_SUBTEST_2(test_sparselu_refactorize<double>());
+    CALL_SUBTEST_3(test_sparselu_refactorize<std::complex<float> >());
+    CALL_SUBTEST_4(test_sparselu_refactorize<std::complex<double> >());
+  }
 }
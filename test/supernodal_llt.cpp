@@ -0,0 +1,87 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse_solver.h"
+
+template<typename T, typename I_> void test_supernodal_llt_T()
+{
+  typedef SparseMatrix<T,0,I_> SparseMatrixType;
+  SupernodalLLT<SparseMatrixType, Lower> llt_colmajor_lower_amd;
+  SupernodalLLT<SparseMatrixType, Upper> llt_colmajor_upper_amd;
+  SupernodalLLT<SparseMatrixType, Lower, NaturalOrdering<I_> > llt_colmajor_lower_nat;
+  SupernodalLLT<SparseMatrixType, Upper, NaturalOrdering<I_> > llt_colmajor_upper_nat;
+
+  check_sparse_spd_solving(llt_colmajor_lower_amd);
+  check_sparse_spd_solving(llt_colmajor_upper_amd);
+  check_sparse_spd_solving(llt_colmajor_lower_nat, (std::min)(300,EIGEN_TEST_MAX_SIZE), 1000);
+  check_sparse_spd_solving(llt_colmajor_upper_nat, (std::min)(300,EIGEN_TEST_MAX_SIZE), 1000);
+
+  check_sparse_spd_determinant(llt_colmajor_lower_amd);
+  check_sparse_spd_determinant(llt_colmajor_upper_amd);
+}
+
+// 3D Laplacian, whose factor has large supernodes
+template<typename T, typename I_> void test_supernodal_llt_laplacian()
+{
+  typedef SparseMatrix<T,0,I_> SparseMatrixType;
+  typedef Matrix<T,Dynamic,Dynamic> DenseMatrix;
+  const int n = internal::random<int>(4,12);
+  const int size = n*n*n;
+  std::vector<Triplet<T,I_> > triplets;
+  for(int i = 0; i < n; ++i)
+    for(int j = 0; j < n; ++j)
+      for(int k = 0; k < n; ++k)
+      {
+        int id = (i*n+j)*n+k;
+        triplets.push_back(Triplet<T,I_>(id, id, T(6.5)));
+        if(i+1<n) triplets.push_back(Triplet<T,I_>((i+1)*n*n+j*n+k, id, T(-1)));
+        if(j+1<n) triplets.push_back(Triplet<T,I_>(i*n*n+(j+1)*n+k, id, T(-1)));
+        if(k+1<n) triplets.push_back(Triplet<T,I_>(id+1, id, T(-1)));
+      }
+  SparseMatrixType A(size,size);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+
+  SupernodalLLT<SparseMatrixType, Lower> llt(A);
+  SimplicialLLT<SparseMatrixType, Lower> ref(A);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+  VERIFY(llt.supernodes() < size);
+
+  DenseMatrix b = DenseMatrix::Random(size, internal::random<int>(1,4));
+  DenseMatrix x = llt.solve(b);
+  VERIFY_IS_APPROX(x, ref.solve(b));
+  SparseMatrixType fullA = A.template selfadjointView<Lower>();
+  VERIFY_IS_APPROX(fullA*x, b);
+
+  // the factor reconstructs the permuted matrix
+  SparseMatrixType L = llt.matrixL();
+  SparseMatrixType PAPt;
+  PAPt = fullA.twistedBy(llt.permutationP());
+  VERIFY_IS_APPROX(DenseMatrix(L*L.adjoint()), DenseMatrix(PAPt));
+
+  // refactorization with the same pattern
+  A.coeffs() *= T(2);
+  llt.factorize(A);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+  VERIFY_IS_APPROX(llt.solve(b), x/T(2));
+
+  // a matrix which is not positive definite is reported as such
+  A.coeffs() *= T(-1);
+  llt.factorize(A);
+  VERIFY_IS_EQUAL(llt.info(), NumericalIssue);
+}
+
+EIGEN_DECLARE_TEST(supernodal_llt)
+{
+  CALL_SUBTEST_1(( test_supernodal_llt_T<double,int>() ));
+  CALL_SUBTEST_2(( test_supernodal_llt_T<std::complex<double>, int>() ));
+  CALL_SUBTEST_3(( test_supernodal_llt_T<double,long int>() ));
+  for(int i = 0; i < g_repeat; ++i)
+  {
+    CALL_SUBTEST_4(( test_supernodal_llt_laplacian<double,int>() ));
+    CALL_SUBTEST_5(( test_supernodal_llt_laplacian<std::complex<double>,int>() ));
+  }
+}
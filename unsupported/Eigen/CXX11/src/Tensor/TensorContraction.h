@@ -331,6 +331,121 @@ struct TensorContractionKernel {
   const StorageIndex bn;
 };
 
+// Contraction kernel for bfloat16 tensors. Accumulating in bfloat16 loses all
+// accuracy after a few terms, so the blocks are converted to fp32 when they are
+// packed, and are multiplied with the fp32 gebp kernel. Each call to invoke()
+// accumulates a block of depth bk in fp32 before adding it to the output.
+template <typename StorageIndex, typename OutputMapper, typename LhsMapper,
+          typename RhsMapper>
+struct TensorContractionKernel<bfloat16, bfloat16, bfloat16, StorageIndex,
+                               OutputMapper, LhsMapper, RhsMapper> {
+  TensorContractionKernel(StorageIndex m, StorageIndex k, StorageIndex n,
+                          StorageIndex bm, StorageIndex bk, StorageIndex bn)
+      : m(m), k(k), n(n), bm(bm), bk(bk), bn(bn) {}
+
+  // Packed blocks are stored in fp32.
+  typedef float* LhsBlock;
+  typedef float* RhsBlock;
+
+  typedef TensorContractionBlockMemAllocator<float, float> BlockMemAllocator;
+  typedef typename BlockMemAllocator::BlockMemHandle BlockMemHandle;
+
+  typedef typename internal::gebp_traits<float, float> Traits;
+
+  typedef internal::const_blas_data_mapper<float, StorageIndex, ColMajor>
+      FloatMapper;
+  typedef internal::blas_data_mapper<float, StorageIndex, ColMajor> AccMapper;
+
+  typedef internal::gemm_pack_lhs<
+      float, StorageIndex, FloatMapper, Traits::mr, Traits::LhsProgress,
+      typename Traits::LhsPacket4Packing, ColMajor>
+      LhsPacker;
+
+  typedef internal::gemm_pack_rhs<float, StorageIndex, FloatMapper,
+                                  Traits::nr, ColMajor>
+      RhsPacker;
+
+  typedef internal::gebp_kernel<float, float, StorageIndex, AccMapper,
+                                Traits::mr, Traits::nr,
+      /*ConjugateLhs*/ false, /*ConjugateRhs*/ false>
+      GebpKernel;
+
+  template <typename Device>
+  BlockMemHandle allocate(Device& d, LhsBlock* lhs_block,
+                          RhsBlock* rhs_block) {
+    return BlockMemAllocator::allocate(d, bm, bk, bn, lhs_block, rhs_block);
+  }
+
+  template <typename Device>
+  BlockMemHandle allocateSlices(
+      Device& d, const StorageIndex num_lhs, const StorageIndex num_rhs,
+      const StorageIndex num_slices, std::vector<LhsBlock>* lhs_blocks,
+      std::vector<RhsBlock>* rhs_blocks) {
+    return BlockMemAllocator::allocateSlices(
+        d, bm, bk, bn, num_lhs, num_rhs, num_slices, lhs_blocks, rhs_blocks);
+  }
+
+  template <typename Device>
+  static void deallocate(Device& d, BlockMemHandle handle) {
+    BlockMemAllocator::deallocate(d, handle);
+  }
+
+  EIGEN_DONT_INLINE void packLhs(
+      LhsBlock* lhsBlock, const typename LhsMapper::SubMapper& data_mapper,
+      const StorageIndex depth, const StorageIndex rows) {
+    ei_declare_aligned_stack_constructed_variable(float, block, rows * depth, 0);
+    for (StorageIndex j = 0; j < depth; ++j) {
+      for (StorageIndex i = 0; i < rows; ++i) {
+        block[i + j * rows] = static_cast<float>(data_mapper(i, j));
+      }
+    }
+    LhsPacker()(*lhsBlock, FloatMapper(block, rows), depth, rows,
+        /*stride*/ 0, /*offset*/ 0);
+  }
+
+  EIGEN_DONT_INLINE void packRhs(
+      RhsBlock* rhsBlock, const typename RhsMapper::SubMapper& data_mapper,
+      const StorageIndex depth, const StorageIndex cols) {
+    ei_declare_aligned_stack_constructed_variable(float, block, depth * cols, 0);
+    for (StorageIndex j = 0; j < cols; ++j) {
+      for (StorageIndex i = 0; i < depth; ++i) {
+        block[i + j * depth] = static_cast<float>(data_mapper(i, j));
+      }
+    }
+    RhsPacker()(*rhsBlock, FloatMapper(block, depth), depth, cols);
+  }
+
+  EIGEN_DONT_INLINE void invoke(
+      const OutputMapper& output_mapper, const LhsBlock& lhsBlock,
+      const RhsBlock& rhsBlock, const StorageIndex rows,
+      const StorageIndex depth, const StorageIndex cols,
+      const bfloat16 alpha) {
+    static const int kComputeStrideFromBlockDimensions = -1;
+    ei_declare_aligned_stack_constructed_variable(float, acc, rows * cols, 0);
+    std::fill(acc, acc + rows * cols, 0.f);
+    GebpKernel()(AccMapper(acc, rows), lhsBlock, rhsBlock, rows, depth, cols,
+        /*alpha*/ 1.f,
+        /*strideA*/ kComputeStrideFromBlockDimensions,
+        /*strideB*/ kComputeStrideFromBlockDimensions,
+        /*offsetA*/ 0, /*offsetB*/ 0);
+    const float actual_alpha = static_cast<float>(alpha);
+    for (StorageIndex j = 0; j < cols; ++j) {
+      for (StorageIndex i = 0; i < rows; ++i) {
+        bfloat16& out = output_mapper(i, j);
+        out = bfloat16(static_cast<float>(out) + actual_alpha * acc[i + j * rows]);
+      }
+    }
+  }
+
+ private:
+  const StorageIndex m;
+  const StorageIndex k;
+  const StorageIndex n;
+  const StorageIndex bm;
+  const StorageIndex bk;
+  const StorageIndex bn;
+};
+
 }  // end namespace internal
 
 // Tensor contraction params that should enable to get from output matrix
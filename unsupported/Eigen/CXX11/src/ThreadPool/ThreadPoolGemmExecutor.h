@@ -0,0 +1,53 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_CXX11_THREADPOOL_THREAD_POOL_GEMM_EXECUTOR_H
+#define EIGEN_CXX11_THREADPOOL_THREAD_POOL_GEMM_EXECUTOR_H
+
+namespace Eigen {
+
+// Runs the multi-threaded dense matrix products of Eigen/Core on the threads
+// of a ThreadPoolInterface, e.g.:
+//
+//   Eigen::ThreadPool pool(8);
+//   Eigen::ThreadPoolGemmExecutor executor(&pool);
+//   Eigen::setGemmExecutor(&executor);
+//   C.noalias() = A * B;   // runs on the calling thread plus up to 8 threads of pool
+//
+// The calling thread always runs one of the tasks, the other ones are
+// scheduled on the pool. Since the tasks of a parallel GEMM wait for each
+// other, the pool should not be busy with long running closures while a
+// product is being evaluated. Products evaluated from within the threads of
+// the pool itself are not parallelized.
+class ThreadPoolGemmExecutor : public GemmExecutor {
+ public:
+  explicit ThreadPoolGemmExecutor(ThreadPoolInterface* pool) : pool_(pool) {}
+
+  virtual int numThreads() const { return pool_->NumThreads() + 1; }
+
+  virtual bool isWorkerThread() const { return pool_->CurrentThreadId() != -1; }
+
+  virtual void run(int n, const Task& task) {
+    if (n <= 0) return;
+    Barrier barrier(static_cast<unsigned int>(n - 1));
+    for (int i = 1; i < n; ++i) {
+      pool_->Schedule([&task, &barrier, i]() {
+        task(i);
+        barrier.Notify();
+      });
+    }
+    task(0);
+    barrier.Wait();
+  }
+
+ private:
+  ThreadPoolInterface* pool_;
+};
+
+}  // namespace Eigen
+
+#endif  // EIGEN_CXX11_THREADPOOL_THREAD_POOL_GEMM_EXECUTOR_H
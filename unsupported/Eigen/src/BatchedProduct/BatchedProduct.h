@@ -0,0 +1,205 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BATCHED_PRODUCT_H
+#define EIGEN_BATCHED_PRODUCT_H
+
+namespace Eigen {
+
+/** \ingroup BatchedProduct_Module
+  *
+  * \class MatrixBatch
+  *
+  * \brief A sequence of matrices of the same size
+  *
+  * \tparam MatrixType the type of the matrices, which must be const qualified for read-only batches
+  *
+  * The matrices are either stored at regular intervals of a single buffer (strided batch),
+  * or referenced through an array of pointers. In both cases, each matrix is seen as a
+  * Map<MatrixType,Unaligned,OuterStride<> >, and its sizes default to the compile-time sizes of MatrixType.
+  *
+  * Example:
+  * \code
+  * std::vector<float> a(16*n), b(16*n), c(16*n);
+  * MatrixBatch<const Matrix4f> A(a.data(), n, 16), B(b.data(), n, 16);
+  * MatrixBatch<Matrix4f> C(c.data(), n, 16);
+  * batchedProduct(A, B, C); // C[i] = A[i] * B[i] for i=0..n-1
+  * \endcode
+  *
+  * \sa batchedProduct()
+  */
+template<typename MatrixType>
+class MatrixBatch
+{
+  public:
+    typedef typename internal::remove_const<MatrixType>::type PlainMatrixType;
+    typedef typename PlainMatrixType::Scalar Scalar;
+    typedef typename internal::conditional<internal::is_const<MatrixType>::value, const Scalar, Scalar>::type DataScalar;
+    typedef Map<MatrixType, Unaligned, OuterStride<> > MapType;
+
+    enum { IsRowMajor = PlainMatrixType::IsRowMajor };
+
+    /** Constructs a strided batch of \a count matrices, the i-th one starting at \c data+i*batchStride.
+      * If \a outerStride is negative, the matrices are assumed to be contiguous. */
+    MatrixBatch(DataScalar* data, Index count, Index batchStride,
+                Index rows = PlainMatrixType::RowsAtCompileTime, Index cols = PlainMatrixType::ColsAtCompileTime,
+                Index outerStride = -1)
+      : m_data(data), m_pointers(0), m_count(count), m_batchStride(batchStride), m_rows(rows), m_cols(cols)
+    {
+      init(outerStride);
+    }
+
+    /** Constructs a batch of \a count matrices, the i-th one starting at \c pointers[i].
+      * If \a outerStride is negative, the matrices are assumed to be contiguous. */
+    MatrixBatch(DataScalar* const* pointers, Index count,
+                Index rows = PlainMatrixType::RowsAtCompileTime, Index cols = PlainMatrixType::ColsAtCompileTime,
+                Index outerStride = -1)
+      : m_data(0), m_pointers(pointers), m_count(count), m_batchStride(0), m_rows(rows), m_cols(cols)
+    {
+      init(outerStride);
+    }
+
+    /** \returns the number of matrices */
+    Index size() const { return m_count; }
+    /** \returns the number of rows of each matrix */
+    Index rows() const { return m_rows; }
+    /** \returns the number of columns of each matrix */
+    Index cols() const { return m_cols; }
+    /** \returns the outer stride of each matrix */
+    Index outerStride() const { return m_outerStride; }
+
+    /** \returns a pointer to the first coefficient of the i-th matrix */
+    DataScalar* data(Index i) const
+    {
+      eigen_assert(i>=0 && i<m_count);
+      return m_pointers ? m_pointers[i] : m_data + i*m_batchStride;
+    }
+
+    /** \returns the i-th matrix */
+    MapType operator[](Index i) const
+    {
+      return MapType(data(i), m_rows, m_cols, OuterStride<>(m_outerStride));
+    }
+
+  protected:
+    void init(Index outerStride)
+    {
+      eigen_assert(m_rows>=0 && m_cols>=0 && m_count>=0 && "the sizes of the matrices must be specified for dynamic-size types");
+      m_outerStride = outerStride>=0 ? outerStride : (IsRowMajor ? m_cols : m_rows);
+    }
+
+    DataScalar* m_data;
+    DataScalar* const* m_pointers;
+    Index m_count;
+    Index m_batchStride;
+    Index m_rows;
+    Index m_cols;
+    Index m_outerStride;
+};
+
+namespace internal {
+
+template<typename Lhs, typename Rhs, typename Dst>
+struct batched_product_impl
+{
+  typedef typename Dst::Scalar Scalar;
+  typedef typename MatrixBatch<Dst>::PlainMatrixType PlainDst;
+  typedef typename MatrixBatch<Lhs>::PlainMatrixType PlainLhs;
+  typedef typename MatrixBatch<Rhs>::PlainMatrixType PlainRhs;
+
+  enum {
+    MaxDepthAtCompileTime = EIGEN_SIZE_MIN_PREFER_FIXED(PlainLhs::MaxColsAtCompileTime,PlainRhs::MaxRowsAtCompileTime),
+    // Small fixed-size products are evaluated by the coefficient-based product which is fully
+    // vectorized and unrolled. The others reuse the packing buffers of the GEMM kernel for the
+    // whole batch, so that neither the blocking sizes nor the buffers are recomputed per product.
+    CoeffBasedAtCompileTime = PlainDst::MaxRowsAtCompileTime!=Dynamic && PlainDst::MaxColsAtCompileTime!=Dynamic
+                           && MaxDepthAtCompileTime!=Dynamic
+                           && PlainDst::MaxRowsAtCompileTime<=16 && PlainDst::MaxColsAtCompileTime<=16 && MaxDepthAtCompileTime<=16
+  };
+
+  typedef gemm_blocking_space<PlainDst::IsRowMajor ? RowMajor : ColMajor, Scalar, Scalar,
+                              PlainDst::MaxRowsAtCompileTime, PlainDst::MaxColsAtCompileTime, MaxDepthAtCompileTime> BlockingType;
+  typedef general_matrix_matrix_product<Index,
+                                        Scalar, PlainLhs::IsRowMajor ? RowMajor : ColMajor, false,
+                                        Scalar, PlainRhs::IsRowMajor ? RowMajor : ColMajor, false,
+                                        PlainDst::IsRowMajor ? RowMajor : ColMajor> Gemm;
+
+  static void run(const MatrixBatch<Lhs>& lhs, const MatrixBatch<Rhs>& rhs, const MatrixBatch<Dst>& dst, Index start, Index length)
+  {
+    const Index rows = dst.rows(), cols = dst.cols(), depth = lhs.cols();
+    const Index end = start+length;
+
+    if(CoeffBasedAtCompileTime || depth==0 || (rows+cols+depth)<EIGEN_GEMM_TO_COEFFBASED_THRESHOLD)
+    {
+      for(Index i=start; i<end; ++i)
+        dst[i].noalias() = lhs[i].lazyProduct(rhs[i]);
+    }
+    else
+    {
+      BlockingType blocking(rows, cols, depth, 1, true);
+      blocking.allocateAll();
+      for(Index i=start; i<end; ++i)
+      {
+        dst[i].setZero();
+        Gemm::run(rows, cols, depth,
+                  lhs.data(i), lhs.outerStride(),
+                  rhs.data(i), rhs.outerStride(),
+                  dst.data(i), dst.outerStride(),
+                  Scalar(1), blocking);
+      }
+    }
+  }
+};
+
+template<typename Lhs, typename Rhs, typename Dst>
+struct batched_product_range_functor
+{
+  batched_product_range_functor(const MatrixBatch<Lhs>& lhs, const MatrixBatch<Rhs>& rhs, const MatrixBatch<Dst>& dst)
+    : m_lhs(lhs), m_rhs(rhs), m_dst(dst)
+  {}
+
+  void operator()(Index start, Index length) const
+  {
+    batched_product_impl<Lhs,Rhs,Dst>::run(m_lhs, m_rhs, m_dst, start, length);
+  }
+
+  const MatrixBatch<Lhs>& m_lhs;
+  const MatrixBatch<Rhs>& m_rhs;
+  const MatrixBatch<Dst>& m_dst;
+};
+
+} // end namespace internal
+
+/** \ingroup BatchedProduct_Module
+  *
+  * Computes \c dst[i] = \c lhs[i] * \c rhs[i] for all the matrices of the batches.
+  *
+  * The products are assumed to not alias. Small fixed-size products are evaluated through the unrolled
+  * coefficient-based product, and larger ones share the same packing buffers of the GEMM kernel.
+  * Large batches are split among the threads reserved for Eigen (see setNbThreads() and setGemmExecutor()).
+  *
+  * \sa MatrixBatch
+  */
+template<typename Lhs, typename Rhs, typename Dst>
+void batchedProduct(const MatrixBatch<Lhs>& lhs, const MatrixBatch<Rhs>& rhs, const MatrixBatch<Dst>& dst)
+{
+  EIGEN_STATIC_ASSERT((internal::is_same<typename MatrixBatch<Lhs>::Scalar, typename MatrixBatch<Dst>::Scalar>::value
+                    && internal::is_same<typename MatrixBatch<Rhs>::Scalar, typename MatrixBatch<Dst>::Scalar>::value),
+                      YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+  EIGEN_STATIC_ASSERT(!internal::is_const<Dst>::value, THIS_EXPRESSION_IS_NOT_A_LVALUE__IT_IS_READ_ONLY)
+  eigen_assert(lhs.size()==dst.size() && rhs.size()==dst.size());
+  eigen_assert(lhs.rows()==dst.rows() && rhs.cols()==dst.cols() && lhs.cols()==rhs.rows());
+
+  double work = static_cast<double>(dst.size()) * static_cast<double>(dst.rows())
+              * static_cast<double>(dst.cols()) * static_cast<double>(lhs.cols());
+  internal::parallelize_range<true>(internal::batched_product_range_functor<Lhs,Rhs,Dst>(lhs, rhs, dst),
+                                    dst.size(), Index(1), work);
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_BATCHED_PRODUCT_H
@@ -0,0 +1,441 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_GEMM_BLOCKING_TABLE_H
+#define EIGEN_GEMM_BLOCKING_TABLE_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal \returns a wall clock time in seconds */
+inline double gemm_tuning_time()
+{
+#if EIGEN_HAS_CXX11
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#elif defined(_WIN32)
+  return double(std::clock()) / double(CLOCKS_PER_SEC);
+#else
+  timeval tv;
+  gettimeofday(&tv, 0);
+  return double(tv.tv_sec) + 1e-6 * double(tv.tv_usec);
+#endif
+}
+
+template<typename Scalar> struct gemm_tuning_scalar_name;
+template<> struct gemm_tuning_scalar_name<float> { static const char* run() { return "float"; } };
+template<> struct gemm_tuning_scalar_name<double> { static const char* run() { return "double"; } };
+template<> struct gemm_tuning_scalar_name<std::complex<float> > { static const char* run() { return "complex<float>"; } };
+template<> struct gemm_tuning_scalar_name<std::complex<double> > { static const char* run() { return "complex<double>"; } };
+
+} // end namespace internal
+
+/** \ingroup BlockingTuner_Module
+  *
+  * \class GemmBlockingTable
+  *
+  * \brief A table of measured blocking sizes for the matrix products
+  *
+  * This class implements the GemmBlockingProvider interface: once registered with setGemmBlockingProvider(),
+  * the matrix products of float, double, and complex matrices use the blocking sizes stored in the table
+  * instead of the cache size based heuristic.
+  *
+  * The entries are indexed by the scalar types of the operands, the number of threads evaluating the product,
+  * and the shape class of the product. The shape class rounds each dimension up to the next power of two,
+  * so that a single entry covers all the products of similar sizes. The dimensions are the ones of the
+  * underlying column-major kernel: a row-major product uses the entry of its transpose.
+  *
+  * The entries are measured by tune(), which times real products for a few candidate blockings around the
+  * default heuristic and keeps the fastest. With setTuneOnFirstUse(true), the products missing from the
+  * table are tuned the first time they are evaluated. The table can be written to a text file with save()
+  * and read back with load(), for instance to tune once per machine.
+  *
+  * \warning Neither tune() nor load() are thread safe, and the products must not be evaluated from several
+  * threads while they run. In particular tuning on first use must only be enabled when the products are
+  * evaluated from a single thread.
+  *
+  * \sa tuneGemmBlocking(), loadGemmBlocking(), saveGemmBlocking(), setGemmBlockingProvider()
+  */
+class GemmBlockingTable : public GemmBlockingProvider
+{
+  public:
+    /** \brief The blocking sizes of a matrix product */
+    struct Sizes
+    {
+      Sizes() : kc(0), mc(0), nc(0) {}
+      Sizes(Index _kc, Index _mc, Index _nc) : kc(_kc), mc(_mc), nc(_nc) {}
+      Index kc, mc, nc;
+    };
+
+    GemmBlockingTable()
+      : m_tuneOnFirstUse(false), m_maxTuningSize(1024), m_repetitions(3), m_tuning(false), m_observedThreads(0)
+    {}
+
+    /** Removes all the entries of the table */
+    void clear() { m_entries.clear(); }
+
+    /** \returns the number of entries of the table */
+    Index size() const { return Index(m_entries.size()); }
+
+    /** \returns the shape class of a dimension \a dim, that is the exponent of the smallest power of two
+      * larger or equal to \a dim */
+    static int shapeClass(Index dim)
+    {
+      int c = 0;
+      while(c < 62 && (Index(1) << c) < dim)
+        ++c;
+      return c;
+    }
+
+    /** Sets the blocking sizes of the products of \a lhs by \a rhs matrices of the shape class of a \a rows x \a depth
+      * times \a depth x \a cols product, evaluated by \a threads threads. */
+    void insert(ScalarType lhs, ScalarType rhs, int threads, Index rows, Index depth, Index cols, const Sizes& sizes)
+    {
+      eigen_assert(sizes.kc>0 && sizes.mc>0 && sizes.nc>0);
+      m_entries[Key(lhs, rhs, threads, rows, depth, cols)] = sizes;
+    }
+
+    /** \returns true and sets \a sizes if the table contains the blocking sizes of the products of \a lhs
+      * by \a rhs matrices of the shape class of a \a rows x \a depth times \a depth x \a cols product,
+      * evaluated by \a threads threads. */
+    bool find(ScalarType lhs, ScalarType rhs, int threads, Index rows, Index depth, Index cols, Sizes& sizes) const
+    {
+      EntryMap::const_iterator it = m_entries.find(Key(lhs, rhs, threads, rows, depth, cols));
+      if(it==m_entries.end())
+        return false;
+      sizes = it->second;
+      return true;
+    }
+
+    /** Enables or disables the tuning of the products missing from the table when they are first evaluated.
+      * Only the products of operands of the same scalar type are tuned. The default is false. */
+    void setTuneOnFirstUse(bool enable) { m_tuneOnFirstUse = enable; }
+    /** \returns whether the missing products are tuned on first use \sa setTuneOnFirstUse() */
+    bool tuneOnFirstUse() const { return m_tuneOnFirstUse; }
+
+    /** Sets the maximal dimension of the products timed by tune(). Larger products are tuned on a product
+      * of this size, which keeps the tuning time bounded. The default is 1024. */
+    void setMaxTuningSize(Index size) { eigen_assert(size>0); m_maxTuningSize = size; }
+    /** \returns the maximal dimension of the products timed by tune() \sa setMaxTuningSize() */
+    Index maxTuningSize() const { return m_maxTuningSize; }
+
+    /** Sets the number of times each candidate blocking is timed, the fastest run being kept. The default is 3. */
+    void setRepetitions(int repetitions) { eigen_assert(repetitions>0); m_repetitions = repetitions; }
+    /** \returns the number of times each candidate blocking is timed \sa setRepetitions() */
+    int repetitions() const { return m_repetitions; }
+
+    template<typename Scalar>
+    Sizes tune(Index rows, Index depth, Index cols, int threads = nbThreads());
+
+    bool save(std::ostream& s) const;
+    bool load(std::istream& s);
+
+    /** Writes the table to the file \a filename \returns false if the file cannot be written \sa load() */
+    bool save(const std::string& filename) const
+    {
+      std::ofstream out(filename.c_str());
+      return out.is_open() && save(out);
+    }
+
+    /** Replaces the table by the one read from the file \a filename
+      * \returns false, and leaves the table unchanged, if the file cannot be read or is malformed \sa save() */
+    bool load(const std::string& filename)
+    {
+      std::ifstream in(filename.c_str());
+      return in.is_open() && load(in);
+    }
+
+    virtual bool blockingSizes(ScalarType lhs, ScalarType rhs, Index k, Index m, Index n, Index num_threads,
+                               Index& kc, Index& mc, Index& nc)
+    {
+      Sizes sizes;
+      if(m_tuning)
+      {
+        // a product timed by tune()
+        m_observedThreads = numext::maxi(m_observedThreads, int(num_threads));
+        sizes = m_candidate;
+      }
+      else if(!find(lhs, rhs, int(num_threads), m, k, n, sizes))
+      {
+        if(!m_tuneOnFirstUse || lhs!=rhs || !tuneMissing(lhs, m, k, n, int(num_threads), sizes))
+          return false;
+      }
+      kc = sizes.kc;
+      mc = sizes.mc;
+      nc = sizes.nc;
+      return true;
+    }
+
+  protected:
+    struct Key
+    {
+      Key(ScalarType _lhs, ScalarType _rhs, int _threads, Index rows, Index depth, Index cols)
+        : lhs(_lhs), rhs(_rhs), threads(_threads),
+          rowClass(shapeClass(rows)), depthClass(shapeClass(depth)), colClass(shapeClass(cols))
+      {}
+      bool operator<(const Key& other) const
+      {
+        if(lhs!=other.lhs) return lhs<other.lhs;
+        if(rhs!=other.rhs) return rhs<other.rhs;
+        if(threads!=other.threads) return threads<other.threads;
+        if(rowClass!=other.rowClass) return rowClass<other.rowClass;
+        if(depthClass!=other.depthClass) return depthClass<other.depthClass;
+        return colClass<other.colClass;
+      }
+      ScalarType lhs, rhs;
+      int threads;
+      int rowClass, depthClass, colClass;
+    };
+    typedef std::map<Key,Sizes> EntryMap;
+
+    static const char* scalarName(ScalarType type)
+    {
+      switch(type)
+      {
+        case Float:         return internal::gemm_tuning_scalar_name<float>::run();
+        case Double:        return internal::gemm_tuning_scalar_name<double>::run();
+        case ComplexFloat:  return internal::gemm_tuning_scalar_name<std::complex<float> >::run();
+        case ComplexDouble: return internal::gemm_tuning_scalar_name<std::complex<double> >::run();
+      }
+      return "";
+    }
+
+    static bool parseScalarName(const std::string& name, ScalarType& type)
+    {
+      const ScalarType types[] = { Float, Double, ComplexFloat, ComplexDouble };
+      for(int i=0; i<4; ++i)
+      {
+        if(name==scalarName(types[i]))
+        {
+          type = types[i];
+          return true;
+        }
+      }
+      return false;
+    }
+
+    bool tuneMissing(ScalarType type, Index rows, Index depth, Index cols, int threads, Sizes& sizes)
+    {
+      // The blocking does not matter for products fitting in the first level of blocking.
+      if(rows*depth*cols < Index(64*64*64))
+        return false;
+      switch(type)
+      {
+        case Float:         sizes = tune<float>(rows, depth, cols, threads); break;
+        case Double:        sizes = tune<double>(rows, depth, cols, threads); break;
+        case ComplexFloat:  sizes = tune<std::complex<float> >(rows, depth, cols, threads); break;
+        case ComplexDouble: sizes = tune<std::complex<double> >(rows, depth, cols, threads); break;
+      }
+      return true;
+    }
+
+    template<typename MatrixType>
+    double time(const MatrixType& lhs, const MatrixType& rhs, MatrixType& res, const Sizes& candidate)
+    {
+      m_candidate = candidate;
+      double best = NumTraits<double>::highest();
+      for(int r=0; r<m_repetitions; ++r)
+      {
+        double start = internal::gemm_tuning_time();
+        res.noalias() = lhs * rhs;
+        best = numext::mini(best, internal::gemm_tuning_time() - start);
+      }
+      return best;
+    }
+
+    EntryMap m_entries;
+    bool m_tuneOnFirstUse;
+    Index m_maxTuningSize;
+    int m_repetitions;
+
+    // state of a running tune()
+    bool m_tuning;
+    Sizes m_candidate;
+    int m_observedThreads;
+};
+
+/** Times the products of \a Scalar matrices of the shape class of a \a rows x \a depth times \a depth x \a cols product
+  * evaluated by \a threads threads for several candidate blocking sizes, and stores the fastest ones in the table.
+  *
+  * The candidates scale each of the default kc, mc and nc by 1/2, 1 and 2 in turn, keeping the best size of a
+  * dimension before moving on to the next one. The dimensions larger than maxTuningSize() are clamped to it.
+  *
+  * The table is temporarily registered with setGemmBlockingProvider(), and the number of threads is temporarily
+  * set with setNbThreads(). If fewer threads are actually used by the product, the entry is stored for that
+  * number of threads.
+  *
+  * \returns the fastest blocking sizes
+  */
+template<typename Scalar>
+GemmBlockingTable::Sizes GemmBlockingTable::tune(Index rows, Index depth, Index cols, int threads)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  eigen_assert(rows>0 && depth>0 && cols>0 && threads>0);
+  eigen_assert(!m_tuning && "GemmBlockingTable::tune() is not reentrant");
+
+  const Index m = numext::mini(rows, m_maxTuningSize);
+  const Index k = numext::mini(depth, m_maxTuningSize);
+  const Index n = numext::mini(cols, m_maxTuningSize);
+  MatrixType lhs = MatrixType::Random(m, k);
+  MatrixType rhs = MatrixType::Random(k, n);
+  MatrixType res(m, n);
+
+  Sizes best(k, m, n);
+  internal::evaluateProductBlockingSizesHeuristic<Scalar,Scalar,1>(best.kc, best.mc, best.nc, Index(threads));
+
+  GemmBlockingProvider* oldProvider = gemmBlockingProvider();
+  const int oldThreads = nbThreads();
+  setGemmBlockingProvider(this);
+  setNbThreads(threads);
+  m_tuning = true;
+  m_observedThreads = 0;
+
+  // warm up the caches and the threads
+  double bestTime = time(lhs, rhs, res, best);
+  bestTime = time(lhs, rhs, res, best);
+  for(int dim=0; dim<3; ++dim)
+  {
+    const Sizes center = best;
+    const Index extent = dim==0 ? k : dim==1 ? m : n;
+    for(int f=0; f<2; ++f)
+    {
+      Sizes candidate = center;
+      Index& size = dim==0 ? candidate.kc : dim==1 ? candidate.mc : candidate.nc;
+      size = f==0 ? size/2 : numext::mini(extent, 2*size);
+      if(size<1 || size==(dim==0 ? center.kc : dim==1 ? center.mc : center.nc))
+        continue;
+      double t = time(lhs, rhs, res, candidate);
+      if(t<bestTime)
+      {
+        bestTime = t;
+        best = candidate;
+      }
+    }
+  }
+
+  m_tuning = false;
+  setNbThreads(oldThreads);
+  setGemmBlockingProvider(oldProvider);
+
+  const ScalarType type = ScalarType(internal::gemm_blocking_scalar_type<Scalar>::value);
+  insert(type, type, numext::maxi(1, m_observedThreads), rows, depth, cols, best);
+  return best;
+}
+
+/** Writes the table to the stream \a s in a text format, with one entry per line listing the scalar types,
+  * the number of threads, the upper bounds of the shape class of the product, and the blocking sizes.
+  * \returns false if the stream is in a failed state after writing \sa load() */
+inline bool GemmBlockingTable::save(std::ostream& s) const
+{
+  s << "# Eigen gemm blocking table\n";
+  s << "# lhs rhs threads rows depth cols kc mc nc\n";
+  for(EntryMap::const_iterator it=m_entries.begin(); it!=m_entries.end(); ++it)
+  {
+    const Key& key = it->first;
+    s << scalarName(key.lhs) << ' ' << scalarName(key.rhs) << ' ' << key.threads << ' '
+      << (Index(1) << key.rowClass) << ' ' << (Index(1) << key.depthClass) << ' ' << (Index(1) << key.colClass) << ' '
+      << it->second.kc << ' ' << it->second.mc << ' ' << it->second.nc << '\n';
+  }
+  return !s.fail();
+}
+
+/** Replaces the table by the one read from the stream \a s in the format written by save().
+  * Empty lines and lines starting with '#' are ignored.
+  * \returns false, and leaves the table unchanged, if the stream is malformed */
+inline bool GemmBlockingTable::load(std::istream& s)
+{
+  EntryMap entries;
+  std::string line;
+  while(std::getline(s, line))
+  {
+    std::string::size_type first = line.find_first_not_of(" \t\r");
+    if(first==std::string::npos || line[first]=='#')
+      continue;
+    std::istringstream fields(line);
+    std::string lhsName, rhsName, rest;
+    ScalarType lhs, rhs;
+    int threads;
+    Index rows, depth, cols;
+    Sizes sizes;
+    if(!(fields >> lhsName >> rhsName >> threads >> rows >> depth >> cols >> sizes.kc >> sizes.mc >> sizes.nc)
+       || (fields >> rest)
+       || !parseScalarName(lhsName, lhs) || !parseScalarName(rhsName, rhs)
+       || threads<1 || rows<1 || depth<1 || cols<1 || sizes.kc<1 || sizes.mc<1 || sizes.nc<1)
+      return false;
+    entries[Key(lhs, rhs, threads, rows, depth, cols)] = sizes;
+  }
+  if(s.bad())
+    return false;
+  m_entries.swap(entries);
+  return true;
+}
+
+/** \ingroup BlockingTuner_Module
+  * \returns the table used by tuneGemmBlocking(), loadGemmBlocking() and saveGemmBlocking() */
+inline GemmBlockingTable& gemmBlockingTable()
+{
+  static GemmBlockingTable table;
+  return table;
+}
+
+/** \ingroup BlockingTuner_Module
+  * Tunes the blocking sizes of the products of \a Scalar matrices of the shape class of a \a rows x \a depth
+  * times \a depth x \a cols product evaluated by \a threads threads, and registers gemmBlockingTable()
+  * with setGemmBlockingProvider().
+  * \sa GemmBlockingTable::tune() */
+template<typename Scalar>
+void tuneGemmBlocking(Index rows, Index depth, Index cols, int threads = nbThreads())
+{
+  gemmBlockingTable().tune<Scalar>(rows, depth, cols, threads);
+  setGemmBlockingProvider(&gemmBlockingTable());
+}
+
+/** \ingroup BlockingTuner_Module
+  * Tunes the blocking sizes of the square products of float and double matrices of sizes 128, 256, ...
+  * up to \a maxSize, evaluated by nbThreads() threads and by a single thread, and registers
+  * gemmBlockingTable() with setGemmBlockingProvider().
+  * \sa GemmBlockingTable::tune() */
+inline void tuneGemmBlocking(Index maxSize = 1024)
+{
+  GemmBlockingTable& table = gemmBlockingTable();
+  const int threads = nbThreads();
+  for(Index size=128; size<=maxSize; size*=2)
+  {
+    table.tune<float>(size, size, size, 1);
+    table.tune<double>(size, size, size, 1);
+    if(threads>1)
+    {
+      table.tune<float>(size, size, size, threads);
+      table.tune<double>(size, size, size, threads);
+    }
+  }
+  setGemmBlockingProvider(&table);
+}
+
+/** \ingroup BlockingTuner_Module
+  * Loads gemmBlockingTable() from the file \a filename and registers it with setGemmBlockingProvider().
+  * \returns false if the file cannot be read or is malformed, in which case the provider is unchanged
+  * \sa saveGemmBlocking(), GemmBlockingTable::load() */
+inline bool loadGemmBlocking(const std::string& filename)
+{
+  if(!gemmBlockingTable().load(filename))
+    return false;
+  setGemmBlockingProvider(&gemmBlockingTable());
+  return true;
+}
+
+/** \ingroup BlockingTuner_Module
+  * Saves gemmBlockingTable() to the file \a filename.
+  * \returns false if the file cannot be written \sa loadGemmBlocking(), GemmBlockingTable::save() */
+inline bool saveGemmBlocking(const std::string& filename)
+{
+  return gemmBlockingTable().save(filename);
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_GEMM_BLOCKING_TABLE_H
@@ -0,0 +1,207 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_CPU_DISPATCH_H
+#define EIGEN_CPU_DISPATCH_H
+
+#if EIGEN_COMP_MSVC && EIGEN_ARCH_i386_OR_x86_64
+#include <immintrin.h>
+#endif
+
+namespace Eigen {
+
+/** \ingroup CpuDispatch_Module
+  * Flags of the x86 instruction sets, ordered by generation.
+  * \sa supportedCpuFeatures(), CpuDispatcher */
+namespace CpuFeatures {
+  enum Type {
+    SSE2     = 0x1,
+    SSE3     = 0x2,
+    SSSE3    = 0x4,
+    SSE4_1   = 0x8,
+    SSE4_2   = 0x10,
+    AVX      = 0x20,
+    FMA      = 0x40,
+    AVX2     = 0x80,
+    AVX512F  = 0x100,
+    AVX512DQ = 0x200,
+
+    /** The instruction sets enabled at compile time in the current translation unit */
+    Compiled = 0
+#ifdef EIGEN_VECTORIZE_SSE2
+             | SSE2
+#endif
+#ifdef EIGEN_VECTORIZE_SSE3
+             | SSE3
+#endif
+#ifdef EIGEN_VECTORIZE_SSSE3
+             | SSSE3
+#endif
+#ifdef EIGEN_VECTORIZE_SSE4_1
+             | SSE4_1
+#endif
+#ifdef EIGEN_VECTORIZE_SSE4_2
+             | SSE4_2
+#endif
+#ifdef EIGEN_VECTORIZE_AVX
+             | AVX
+#endif
+#ifdef EIGEN_VECTORIZE_FMA
+             | FMA
+#endif
+#ifdef EIGEN_VECTORIZE_AVX2
+             | AVX2
+#endif
+#ifdef EIGEN_VECTORIZE_AVX512
+             | AVX512F
+#endif
+#ifdef EIGEN_VECTORIZE_AVX512DQ
+             | AVX512DQ
+#endif
+  };
+}
+
+namespace internal {
+
+#ifdef EIGEN_CPUID
+/** \internal \returns the content of the extended control register \a index */
+inline unsigned long long cpu_dispatch_xgetbv(unsigned int index)
+{
+#if EIGEN_COMP_GNUC
+  unsigned int eax, edx;
+  // xgetbv, spelled out for old assemblers
+  __asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0" : "=a" (eax), "=d" (edx) : "c" (index));
+  return (static_cast<unsigned long long>(edx) << 32) | eax;
+#else
+  return _xgetbv(index);
+#endif
+}
+#endif
+
+/** \internal
+  * Queries the processor and \returns the instruction sets which are both supported by the processor
+  * and enabled by the operating system, as a combination of CpuFeatures flags */
+inline int queryCpuFeatures()
+{
+  int features = 0;
+#ifdef EIGEN_CPUID
+  int abcd[4];
+  EIGEN_CPUID(abcd,0x0,0);
+  const int max_std_funcs = abcd[0];
+  if(max_std_funcs<1)
+    return features;
+
+  EIGEN_CPUID(abcd,0x1,0);
+  const int ecx = abcd[2], edx = abcd[3];
+  if(edx & (1<<26)) features |= CpuFeatures::SSE2;
+  if(ecx & (1<<0))  features |= CpuFeatures::SSE3;
+  if(ecx & (1<<9))  features |= CpuFeatures::SSSE3;
+  if(ecx & (1<<19)) features |= CpuFeatures::SSE4_1;
+  if(ecx & (1<<20)) features |= CpuFeatures::SSE4_2;
+
+  // The AVX registers must also be saved by the operating system on context switches.
+  const bool osxsave = (ecx & (1<<27)) != 0;
+  const unsigned long long xcr0 = osxsave ? cpu_dispatch_xgetbv(0) : 0;
+  const bool os_avx = (xcr0 & 0x6) == 0x6;        // XMM and YMM states
+  const bool os_avx512 = (xcr0 & 0xe6) == 0xe6;   // and opmask, ZMM_Hi256, Hi16_ZMM states
+  if(!os_avx)
+    return features;
+
+  if(ecx & (1<<28)) features |= CpuFeatures::AVX;
+  if(ecx & (1<<12)) features |= CpuFeatures::FMA;
+  if(max_std_funcs>=7)
+  {
+    EIGEN_CPUID(abcd,0x7,0);
+    const int ebx = abcd[1];
+    if(ebx & (1<<5)) features |= CpuFeatures::AVX2;
+    if(os_avx512)
+    {
+      if(ebx & (1<<16)) features |= CpuFeatures::AVX512F;
+      if(ebx & (1<<17)) features |= CpuFeatures::AVX512DQ;
+    }
+  }
+#endif
+  return features;
+}
+
+} // end namespace internal
+
+/** \ingroup CpuDispatch_Module
+  * \returns the x86 instruction sets which can be used on the host, as a combination of CpuFeatures flags.
+  *
+  * The processor is only queried once. When this information is not available (e.g., on other architectures),
+  * the instruction sets enabled at compile time are assumed to be supported.
+  */
+inline int supportedCpuFeatures()
+{
+  static int features = -1;
+  if(features<0)
+  {
+#ifdef EIGEN_CPUID
+    features = internal::queryCpuFeatures();
+#else
+    features = CpuFeatures::Compiled;
+#endif
+  }
+  return features;
+}
+
+/** \ingroup CpuDispatch_Module
+  *
+  * \class CpuDispatcher
+  *
+  * \brief Selects the best variant of a function for the host processor
+  *
+  * \tparam Function the type of the variants, typically a function pointer
+  *
+  * Each variant is registered with the instruction sets it requires. select() returns the
+  * variant requiring the most recent instruction sets among those supported by the processor,
+  * or the default variant if none is supported. Since the processor is queried once and the selection
+  * is cheap, the result is typically stored in a static variable.
+  *
+  * See the \ref CpuDispatch_Module "module documentation" for an example.
+  */
+template<typename Function>
+class CpuDispatcher
+{
+  public:
+    /** Constructs a dispatcher returning \a fallback when no other variant is supported */
+    explicit CpuDispatcher(Function fallback) : m_fallback(fallback) {}
+
+    /** Registers the variant \a func which requires the instruction sets \a features,
+      * a combination of CpuFeatures flags. */
+    CpuDispatcher& add(int features, Function func)
+    {
+      m_variants.push_back(std::make_pair(features, func));
+      return *this;
+    }
+
+    /** \returns the best variant for the instruction sets \a features, which default to the ones of the host. */
+    Function select(int features = supportedCpuFeatures()) const
+    {
+      Function res = m_fallback;
+      int best = -1;
+      for(std::size_t i=0; i<m_variants.size(); ++i)
+      {
+        const int required = m_variants[i].first;
+        if((required & features)==required && required>=best)
+        {
+          best = required;
+          res = m_variants[i].second;
+        }
+      }
+      return res;
+    }
+
+  protected:
+    Function m_fallback;
+    std::vector<std::pair<int,Function> > m_variants;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_CPU_DISPATCH_H
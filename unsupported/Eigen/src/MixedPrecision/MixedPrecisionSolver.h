@@ -0,0 +1,337 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_MIXED_PRECISION_SOLVER_H
+#define EIGEN_MIXED_PRECISION_SOLVER_H
+
+namespace Eigen {
+
+template<typename _Decomposition> class MixedPrecisionSolver;
+
+namespace internal {
+
+/** \internal the scalar type in which the factorization of a matrix of \a Scalar is computed */
+template<typename Scalar> struct mixed_precision_scalar;
+template<> struct mixed_precision_scalar<double> { typedef float type; };
+template<> struct mixed_precision_scalar<long double> { typedef double type; };
+template<typename RealScalar> struct mixed_precision_scalar<std::complex<RealScalar> >
+{ typedef std::complex<typename mixed_precision_scalar<RealScalar>::type> type; };
+
+template<typename MatrixType> struct mixed_precision_matrix
+{
+  typedef Matrix<typename mixed_precision_scalar<typename MatrixType::Scalar>::type,
+                 MatrixType::RowsAtCompileTime, MatrixType::ColsAtCompileTime, MatrixType::Options,
+                 MatrixType::MaxRowsAtCompileTime, MatrixType::MaxColsAtCompileTime> type;
+};
+
+/** \internal Describes how a full precision decomposition is refined by MixedPrecisionSolver:
+  * - LowDecomposition is the same decomposition of the lower precision matrix,
+  * - subProduct(a, x, r) computes r -= A x where \a a is the matrix stored by the solver,
+  * - norm(a) is the infinity norm of A,
+  * - info(dec) reports whether the decomposition \a dec succeeded.
+  */
+template<typename Decomposition> struct mixed_precision_decomposition;
+
+template<typename MatrixType> struct mixed_precision_decomposition<PartialPivLU<MatrixType> >
+{
+  typedef PartialPivLU<typename mixed_precision_matrix<MatrixType>::type> LowDecomposition;
+
+  template<typename X, typename Dst>
+  static void subProduct(const MatrixType& a, const X& x, Dst& r) { r.noalias() -= a * x; }
+
+  static typename MatrixType::RealScalar norm(const MatrixType& a)
+  {
+    return a.cwiseAbs().rowwise().sum().maxCoeff();
+  }
+
+  // PartialPivLU never fails, the singular matrices are detected by the refinement
+  template<typename Dec>
+  static ComputationInfo info(const Dec&) { return Success; }
+};
+
+template<typename MatrixType, int UpLo> struct mixed_precision_decomposition<LLT<MatrixType,UpLo> >
+{
+  typedef LLT<typename mixed_precision_matrix<MatrixType>::type, UpLo> LowDecomposition;
+
+  // only the UpLo triangular part of the matrix is referenced
+  template<typename X, typename Dst>
+  static void subProduct(const MatrixType& a, const X& x, Dst& r) { r.noalias() -= a.template selfadjointView<UpLo>() * x; }
+
+  static typename MatrixType::RealScalar norm(const MatrixType& a)
+  {
+    typedef typename MatrixType::RealScalar RealScalar;
+    const Index size = a.rows();
+    RealScalar ret = 0;
+    for(Index col = 0; col < size; ++col)
+    {
+      RealScalar absColSum = UpLo==Lower ? a.col(col).tail(size - col).template lpNorm<1>() + a.row(col).head(col).template lpNorm<1>()
+                                         : a.col(col).head(col).template lpNorm<1>() + a.row(col).tail(size - col).template lpNorm<1>();
+      ret = numext::maxi(ret, absColSum);
+    }
+    return ret;
+  }
+
+  template<typename Dec>
+  static ComputationInfo info(const Dec& dec) { return dec.info(); }
+};
+
+template<typename _Decomposition> struct traits<MixedPrecisionSolver<_Decomposition> >
+ : traits<typename _Decomposition::MatrixType>
+{
+  typedef MatrixXpr XprKind;
+  typedef SolverStorage StorageKind;
+  typedef int StorageIndex;
+  enum { Flags = 0 };
+};
+
+} // end namespace internal
+
+/** \ingroup MixedPrecision_Module
+  *
+  * \class MixedPrecisionSolver
+  *
+  * \brief Linear solver factorizing in lower precision with iterative refinement
+  *
+  * \tparam _Decomposition the full precision decomposition, either PartialPivLU<MatrixType> or LLT<MatrixType,UpLo>,
+  *                        with a double, long double, or complex scalar type
+  *
+  * This class computes the decomposition of the matrix A cast to the lower precision scalar type (e.g., float for
+  * double), which halves the memory traffic of the factorization and runs it with twice wider packets. The
+  * solution of A x = b is then refined in the precision of A:
+  * \f[ r = b - A x, \quad A d = r \mbox{ solved in lower precision}, \quad x \leftarrow x + d, \f]
+  * until the normwise backward error \f$ \|r\|_\infty / (\|A\|_\infty \|x\|_\infty) \f$ of each column of x is below
+  * tolerance(). For a matrix with a condition number well below the inverse of the lower precision epsilon,
+  * a few iterations give the accuracy of the full precision solver.
+  *
+  * When the refinement stalls, that is when an iteration does not halve the backward error, or when
+  * maxIterations() are reached, the solver falls back to the full precision decomposition of A, which
+  * is then used by all the following solves. It also falls back right away when the lower precision
+  * factorization fails, e.g., if A is not numerically positive definite in single precision for LLT.
+  *
+  * Example:
+  * \code
+  * MixedPrecisionSolver<PartialPivLU<MatrixXd> > solver(A);
+  * VectorXd x = solver.solve(b);
+  * std::cout << solver.iterations() << " iterations, backward error " << solver.error() << "\n";
+  * \endcode
+  *
+  * The solver keeps a copy of A in full precision to compute the residuals, in addition to the lower precision
+  * decomposition. Like for LLT, only the triangular part of A selected by \c UpLo is referenced by the LLT variant.
+  *
+  * \warning The fallback factorization happens within solve(), which is therefore not thread safe.
+  *
+  * \sa class PartialPivLU, class LLT
+  */
+template<typename _Decomposition> class MixedPrecisionSolver
+  : public SolverBase<MixedPrecisionSolver<_Decomposition> >
+{
+  public:
+    typedef _Decomposition Decomposition;
+    typedef typename Decomposition::MatrixType MatrixType;
+    typedef SolverBase<MixedPrecisionSolver> Base;
+    friend class SolverBase<MixedPrecisionSolver>;
+
+    EIGEN_GENERIC_PUBLIC_INTERFACE(MixedPrecisionSolver)
+
+    typedef internal::mixed_precision_decomposition<Decomposition> Traits;
+    typedef typename Traits::LowDecomposition LowDecomposition;
+    typedef typename LowDecomposition::Scalar LowScalar;
+
+    /** \brief Default constructor, see compute() */
+    MixedPrecisionSolver()
+      : m_tolerance(-1), m_maxIterations(30), m_isInitialized(false)
+    {}
+
+    /** \brief Constructs the solver of \a matrix \sa compute() */
+    template<typename InputType>
+    explicit MixedPrecisionSolver(const EigenBase<InputType>& matrix)
+      : m_tolerance(-1), m_maxIterations(30), m_isInitialized(false)
+    {
+      compute(matrix.derived());
+    }
+
+    /** Computes the lower precision decomposition of \a matrix.
+      * The full precision decomposition is only computed if it turns out to be needed.
+      */
+    template<typename InputType>
+    MixedPrecisionSolver& compute(const EigenBase<InputType>& matrix)
+    {
+      eigen_assert(matrix.rows()==matrix.cols() && "MixedPrecisionSolver requires a square matrix");
+      m_matrix = matrix.derived();
+      m_matrixNorm = Traits::norm(m_matrix);
+      m_low.compute(m_matrix.template cast<LowScalar>());
+      m_full = Decomposition();
+      m_usesFullPrecision = false;
+      m_info = Traits::info(m_low);
+      m_iterations = 0;
+      m_error = 0;
+      m_isInitialized = true;
+      if(m_info!=Success)
+        fallback();
+      return *this;
+    }
+
+    inline Index rows() const { return m_matrix.rows(); }
+    inline Index cols() const { return m_matrix.cols(); }
+
+    /** \returns the tolerance on the normwise backward error of the solutions.
+      * The default is the full precision epsilon times the square root of the size of the matrix.
+      * \sa setTolerance() */
+    RealScalar tolerance() const
+    {
+      using std::sqrt;
+      return m_tolerance>=0 ? m_tolerance : sqrt(RealScalar(rows())) * NumTraits<Scalar>::epsilon();
+    }
+
+    /** Sets the tolerance on the normwise backward error of the solutions \sa tolerance() */
+    MixedPrecisionSolver& setTolerance(const RealScalar& tolerance)
+    {
+      m_tolerance = tolerance;
+      return *this;
+    }
+
+    /** \returns the maximal number of refinement iterations before falling back to the full precision
+      * factorization. The default is 30. */
+    Index maxIterations() const { return m_maxIterations; }
+
+    /** Sets the maximal number of refinement iterations \sa maxIterations() */
+    MixedPrecisionSolver& setMaxIterations(Index maxIters)
+    {
+      m_maxIterations = maxIters;
+      return *this;
+    }
+
+    /** \returns the number of refinement iterations of the last solve */
+    Index iterations() const
+    {
+      eigen_assert(m_isInitialized && "MixedPrecisionSolver is not initialized.");
+      return m_iterations;
+    }
+
+    /** \returns the largest normwise backward error of the columns of the last solution */
+    RealScalar error() const
+    {
+      eigen_assert(m_isInitialized && "MixedPrecisionSolver is not initialized.");
+      return m_error;
+    }
+
+    /** \returns true if the solver fell back to the full precision decomposition */
+    bool usesFullPrecision() const
+    {
+      eigen_assert(m_isInitialized && "MixedPrecisionSolver is not initialized.");
+      return m_usesFullPrecision;
+    }
+
+    /** \brief Reports whether the previous computation was successful.
+      *
+      * \returns \c Success if the last solve converged, either by refinement or with the full precision
+      *          decomposition, and the error reported by the full precision decomposition otherwise.
+      */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "MixedPrecisionSolver is not initialized.");
+      return m_info;
+    }
+
+    /** \returns the lower precision decomposition */
+    const LowDecomposition& lowPrecisionDecomposition() const { return m_low; }
+
+    #ifndef EIGEN_PARSED_BY_DOXYGEN
+    template<typename RhsType, typename DstType>
+    void _solve_impl(const RhsType &rhs, DstType &dst) const;
+    #endif
+
+  protected:
+
+    static void check_template_parameters()
+    {
+      EIGEN_STATIC_ASSERT_NON_INTEGER(Scalar);
+    }
+
+    void fallback() const
+    {
+      if(!m_usesFullPrecision)
+      {
+        m_full.compute(m_matrix);
+        m_usesFullPrecision = true;
+      }
+      m_info = Traits::info(m_full);
+    }
+
+    template<typename RhsType, typename XType, typename ResidualType>
+    RealScalar backwardError(const RhsType& rhs, const XType& x, ResidualType& r) const
+    {
+      r = rhs;
+      Traits::subProduct(m_matrix, x, r);
+      RealScalar ret = 0;
+      for(Index j = 0; j < x.cols(); ++j)
+      {
+        const RealScalar rnorm = r.col(j).template lpNorm<Infinity>();
+        const RealScalar xnorm = x.col(j).template lpNorm<Infinity>();
+        RealScalar e = rnorm==RealScalar(0) ? RealScalar(0) : rnorm / (m_matrixNorm * xnorm);
+        if(!(numext::isfinite)(e))
+          e = NumTraits<RealScalar>::infinity();
+        ret = numext::maxi(ret, e);
+      }
+      return ret;
+    }
+
+    MatrixType m_matrix;
+    RealScalar m_matrixNorm;
+    LowDecomposition m_low;
+    mutable Decomposition m_full;
+    RealScalar m_tolerance;
+    Index m_maxIterations;
+    bool m_isInitialized;
+    mutable bool m_usesFullPrecision;
+    mutable ComputationInfo m_info;
+    mutable Index m_iterations;
+    mutable RealScalar m_error;
+};
+
+#ifndef EIGEN_PARSED_BY_DOXYGEN
+template<typename _Decomposition>
+template<typename RhsType, typename DstType>
+void MixedPrecisionSolver<_Decomposition>::_solve_impl(const RhsType &rhs, DstType &dst) const
+{
+  typedef typename DstType::PlainObject PlainType;
+  const PlainType b(rhs);
+  PlainType r;
+  m_iterations = 0;
+
+  if(!m_usesFullPrecision)
+  {
+    const RealScalar threshold = tolerance();
+    RealScalar previousError = NumTraits<RealScalar>::infinity();
+    dst = m_low.solve(b.template cast<LowScalar>()).template cast<Scalar>();
+    for(;;)
+    {
+      m_error = backwardError(b, dst, r);
+      if(m_error<=threshold)
+      {
+        m_info = Success;
+        return;
+      }
+      // stop when the refinement stalls or diverges
+      if(m_iterations>=m_maxIterations || !(m_error < RealScalar(0.5) * previousError))
+        break;
+      previousError = m_error;
+      dst += m_low.solve(r.template cast<LowScalar>()).template cast<Scalar>();
+      ++m_iterations;
+    }
+    fallback();
+  }
+
+  dst = m_full.solve(b);
+  m_error = backwardError(b, dst, r);
+  m_info = Traits::info(m_full);
+}
+#endif
+
+} // end namespace Eigen
+
+#endif // EIGEN_MIXED_PRECISION_SOLVER_H
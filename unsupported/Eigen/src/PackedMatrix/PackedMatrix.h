@@ -0,0 +1,308 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_PACKED_MATRIX_H
+#define EIGEN_PACKED_MATRIX_H
+
+namespace Eigen {
+
+template<typename _Scalar> class PackedMatrix;
+
+namespace internal {
+
+template<typename _Scalar>
+struct traits<PackedMatrix<_Scalar> >
+{
+  typedef _Scalar Scalar;
+  typedef Eigen::Index StorageIndex;
+  typedef Dense StorageKind;
+  typedef MatrixXpr XprKind;
+  enum {
+    RowsAtCompileTime = Dynamic,
+    ColsAtCompileTime = Dynamic,
+    MaxRowsAtCompileTime = Dynamic,
+    MaxColsAtCompileTime = Dynamic,
+    Flags = NestByRefBit
+  };
+};
+
+struct PackedShape { static std::string debugName() { return "PackedShape"; } };
+
+template<typename _Scalar>
+struct evaluator_traits<PackedMatrix<_Scalar> >
+  : public evaluator_traits_base<PackedMatrix<_Scalar> >
+{
+  typedef PackedShape Shape;
+};
+
+} // end namespace internal
+
+/** \ingroup PackedMatrix_Module
+  *
+  * \class PackedMatrix
+  *
+  * \brief A matrix stored in the packed format of the left hand side of the matrix product kernel
+  *
+  * \tparam _Scalar the type of the coefficients
+  *
+  * A general matrix product \c W*X packs the blocks of \c W into a contiguous buffer before calling the
+  * panel-by-block kernel, and this packing is done again for each product. This class performs the
+  * packing once, using the blocking sizes of gemm_blocking_space, so that subsequent products
+  * \c W*X only pack the blocks of \c X. This is especially beneficial when the same \c W is applied to
+  * a large number of skinny matrices \c X.
+  *
+  * Example:
+  * \code
+  * PackedMatrix<float> W(weights);
+  * for(...)
+  *   Y.noalias() = W * X;
+  * \endcode
+  *
+  * The right hand side can be any dense expression with the same scalar type, and the products can be
+  * assigned, added, or subtracted to any dense destination. A PackedMatrix can only be used as the left
+  * hand side of a product. Large products are split among the threads reserved for Eigen.
+  */
+template<typename _Scalar>
+class PackedMatrix : public EigenBase<PackedMatrix<_Scalar> >
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef Eigen::Index StorageIndex;
+    typedef Matrix<Scalar,Dynamic,Dynamic> PlainObject;
+    enum {
+      RowsAtCompileTime = Dynamic,
+      ColsAtCompileTime = Dynamic,
+      MaxRowsAtCompileTime = Dynamic,
+      MaxColsAtCompileTime = Dynamic,
+      IsRowMajor = false
+    };
+
+    /** Default constructor, the matrix must be initialized with compute(). */
+    PackedMatrix() : m_rows(0), m_cols(0), m_kc(0), m_mc(0), m_nc(0) {}
+
+    /** Constructs the packed version of \a matrix, see compute(). */
+    template<typename Derived>
+    explicit PackedMatrix(const EigenBase<Derived>& matrix, Index colsHint = -1)
+      : m_rows(0), m_cols(0), m_kc(0), m_mc(0), m_nc(0)
+    {
+      compute(matrix, colsHint);
+    }
+
+    /** Packs \a matrix.
+      *
+      * The blocking sizes are computed for a product with a right hand side of \a colsHint columns,
+      * or of as many columns as \a matrix has rows if \a colsHint is not positive. They stay the same
+      * for all the subsequent products. */
+    template<typename Derived>
+    PackedMatrix& compute(const EigenBase<Derived>& matrix, Index colsHint = -1)
+    {
+      typedef internal::const_blas_data_mapper<Scalar, Index, ColMajor> LhsMapper;
+      typedef internal::gebp_traits<Scalar,Scalar> Traits;
+
+      Ref<const PlainObject, 0, OuterStride<> > mat(matrix.derived());
+      m_rows = mat.rows();
+      m_cols = mat.cols();
+
+      internal::gemm_blocking_space<ColMajor,Scalar,Scalar,Dynamic,Dynamic,Dynamic>
+        blocking(m_rows, colsHint>0 ? colsHint : m_rows, m_cols, 1, true);
+      m_kc = blocking.kc();
+      m_mc = (std::min)(m_rows, blocking.mc());
+      m_nc = blocking.nc();
+
+      // Every block starts at an aligned address, as required by the kernel.
+      const Index align = (std::max)(Index(1), Index(EIGEN_DEFAULT_ALIGN_BYTES/sizeof(Scalar)));
+      const Index blocksK = m_kc>0 ? (m_cols+m_kc-1)/m_kc : 0;
+      m_blockOffsets.clear();
+      Index size = 0;
+      for(Index i2=0; i2<m_rows; i2+=m_mc)
+      {
+        const Index actual_mc = (std::min)(i2+m_mc,m_rows)-i2;
+        for(Index k2=0; k2<m_cols; k2+=m_kc)
+        {
+          const Index actual_kc = (std::min)(k2+m_kc,m_cols)-k2;
+          m_blockOffsets.push_back(size);
+          size += ((actual_mc*actual_kc+align-1)/align)*align;
+        }
+      }
+      eigen_internal_assert(Index(m_blockOffsets.size())==(m_mc>0 ? (m_rows+m_mc-1)/m_mc : 0)*blocksK);
+      EIGEN_UNUSED_VARIABLE(blocksK);
+      m_data.resize(size);
+
+      LhsMapper lhs(mat.data(), mat.outerStride());
+      internal::gemm_pack_lhs<Scalar, Index, LhsMapper, Traits::mr, Traits::LhsProgress, typename Traits::LhsPacket4Packing, ColMajor> pack_lhs;
+      for(Index i2=0; i2<m_rows; i2+=m_mc)
+      {
+        const Index actual_mc = (std::min)(i2+m_mc,m_rows)-i2;
+        for(Index k2=0; k2<m_cols; k2+=m_kc)
+        {
+          const Index actual_kc = (std::min)(k2+m_kc,m_cols)-k2;
+          pack_lhs(m_data.data()+blockOffset(i2,k2), lhs.getSubMapper(i2,k2), actual_kc, actual_mc);
+        }
+      }
+      return *this;
+    }
+
+    /** \returns the number of rows of the packed matrix */
+    Index rows() const { return m_rows; }
+    /** \returns the number of columns of the packed matrix */
+    Index cols() const { return m_cols; }
+
+    /** \returns the blocking size along the columns of the packed matrix */
+    Index kc() const { return m_kc; }
+    /** \returns the blocking size along the rows of the packed matrix */
+    Index mc() const { return m_mc; }
+    /** \returns the blocking size along the columns of the right hand sides */
+    Index nc() const { return m_nc; }
+
+    /** \internal \returns a pointer to the packed block starting at row \a i2 and column \a k2,
+      * which must be multiple of mc() and kc() respectively. */
+    const Scalar* block(Index i2, Index k2) const
+    {
+      return m_data.data() + blockOffset(i2,k2);
+    }
+
+    /** \returns an expression of the product of \c *this by the dense expression \a other */
+    template<typename Rhs>
+    const Product<PackedMatrix,Rhs> operator*(const MatrixBase<Rhs>& other) const
+    {
+      return Product<PackedMatrix,Rhs>(*this, other.derived());
+    }
+
+  protected:
+    Index blockOffset(Index i2, Index k2) const
+    {
+      eigen_internal_assert(i2%m_mc==0 && k2%m_kc==0);
+      return m_blockOffsets[(i2/m_mc)*((m_cols+m_kc-1)/m_kc) + k2/m_kc];
+    }
+
+    Matrix<Scalar,Dynamic,1> m_data;
+    std::vector<Index> m_blockOffsets;
+    Index m_rows;
+    Index m_cols;
+    Index m_kc;
+    Index m_mc;
+    Index m_nc;
+};
+
+namespace internal {
+
+template<typename Scalar, int RhsStorageOrder, bool ConjugateRhs>
+struct packed_matrix_product_range_functor
+{
+  typedef gebp_traits<Scalar,Scalar> Traits;
+  typedef const_blas_data_mapper<Scalar, Index, RhsStorageOrder> RhsMapper;
+  typedef blas_data_mapper<Scalar, Index, ColMajor> ResMapper;
+
+  packed_matrix_product_range_functor(const PackedMatrix<Scalar>& lhs, const RhsMapper& rhs, Index cols,
+                                      Scalar* res, Index resStride, const Scalar& alpha)
+    : m_lhs(lhs), m_rhs(rhs), m_cols(cols), m_res(res), m_resStride(resStride), m_alpha(alpha)
+  {}
+
+  // Computes the rows [start,start+length) of the result, start being a multiple of mc.
+  void operator()(Index start, Index length) const
+  {
+    const Index depth = m_lhs.cols();
+    const Index end = start+length;
+    const Index kc = m_lhs.kc();
+    const Index mc = m_lhs.mc();
+    const Index nc = (std::min)(m_cols, m_lhs.nc());
+
+    gemm_pack_rhs<Scalar, Index, RhsMapper, Traits::nr, RhsStorageOrder> pack_rhs;
+    gebp_kernel<Scalar, Scalar, Index, ResMapper, Traits::mr, Traits::nr, false, ConjugateRhs> gebp;
+    ResMapper res(m_res, m_resStride);
+
+    std::size_t sizeB = kc*nc;
+    ei_declare_aligned_stack_constructed_variable(Scalar, blockB, sizeB, 0);
+
+    // The lhs is already packed, so the loops are ordered such that each block of the rhs is packed only once.
+    for(Index k2=0; k2<depth; k2+=kc)
+    {
+      const Index actual_kc = (std::min)(k2+kc,depth)-k2;
+      for(Index j2=0; j2<m_cols; j2+=nc)
+      {
+        const Index actual_nc = (std::min)(j2+nc,m_cols)-j2;
+        pack_rhs(blockB, m_rhs.getSubMapper(k2,j2), actual_kc, actual_nc);
+        for(Index i2=start; i2<end; i2+=mc)
+        {
+          const Index actual_mc = (std::min)(i2+mc,end)-i2;
+          gebp(res.getSubMapper(i2,j2), m_lhs.block(i2,k2), blockB, actual_mc, actual_kc, actual_nc, m_alpha);
+        }
+      }
+    }
+  }
+
+  const PackedMatrix<Scalar>& m_lhs;
+  RhsMapper m_rhs;
+  Index m_cols;
+  Scalar* m_res;
+  Index m_resStride;
+  Scalar m_alpha;
+};
+
+template<typename _Scalar, typename Rhs, int ProductTag>
+struct generic_product_impl<PackedMatrix<_Scalar>, Rhs, PackedShape, DenseShape, ProductTag>
+  : generic_product_impl_base<PackedMatrix<_Scalar>,Rhs,generic_product_impl<PackedMatrix<_Scalar>,Rhs,PackedShape,DenseShape,ProductTag> >
+{
+  typedef PackedMatrix<_Scalar> Lhs;
+  typedef _Scalar Scalar;
+
+  typedef internal::blas_traits<Rhs> RhsBlasTraits;
+  typedef typename RhsBlasTraits::DirectLinearAccessType ExtractedRhsType;
+  typedef typename internal::remove_all<ExtractedRhsType>::type ExtractedRhsTypeCleaned;
+  // Vectors with a non unit inner stride are copied.
+  typedef typename conditional<inner_stride_at_compile_time<ExtractedRhsTypeCleaned>::ret==1,
+                               ExtractedRhsType, typename ExtractedRhsTypeCleaned::PlainObject>::type ActualRhsType;
+  typedef typename internal::remove_all<ActualRhsType>::type ActualRhsTypeCleaned;
+
+  template<typename Dest>
+  static void scaleAndAddTo(Dest& dst, const Lhs& lhs, const Rhs& a_rhs, const Scalar& alpha)
+  {
+    EIGEN_STATIC_ASSERT((internal::is_same<Scalar, typename Rhs::Scalar>::value),
+                        YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+    eigen_assert(dst.rows()==lhs.rows() && dst.cols()==a_rhs.cols());
+    if(lhs.cols()==0 || lhs.rows()==0 || a_rhs.cols()==0)
+      return;
+
+    enum {
+      // The kernel writes to a column-major destination with a unit inner stride.
+      EvalToTemp = (Dest::ColsAtCompileTime!=1 && (Dest::Flags&RowMajorBit))
+                || inner_stride_at_compile_time<Dest>::ret!=1
+    };
+
+    typename internal::add_const_on_value_type<ActualRhsType>::type rhs = RhsBlasTraits::extract(a_rhs);
+    Scalar actualAlpha = alpha * RhsBlasTraits::extractScalarFactor(a_rhs);
+
+    if(EvalToTemp)
+    {
+      Matrix<Scalar,Dynamic,Dynamic> tmp = Matrix<Scalar,Dynamic,Dynamic>::Zero(dst.rows(), dst.cols());
+      run(tmp, lhs, rhs, actualAlpha);
+      dst += tmp;
+    }
+    else
+      run(dst, lhs, rhs, actualAlpha);
+  }
+
+  template<typename Dest>
+  static void run(Dest& dst, const Lhs& lhs, const ActualRhsTypeCleaned& rhs, const Scalar& alpha)
+  {
+    enum { RhsStorageOrder = (ActualRhsTypeCleaned::Flags&RowMajorBit) ? RowMajor : ColMajor };
+    typedef packed_matrix_product_range_functor<Scalar, RhsStorageOrder, bool(RhsBlasTraits::NeedToConjugate)> Functor;
+    typedef typename Functor::RhsMapper RhsMapper;
+
+    Functor func(lhs, RhsMapper(rhs.data(), rhs.outerStride()), rhs.cols(),
+                 dst.data(), dst.outerStride(), alpha);
+    double work = static_cast<double>(lhs.rows()) * static_cast<double>(lhs.cols()) * static_cast<double>(rhs.cols());
+    internal::parallelize_range<true>(func, lhs.rows(), lhs.mc(), work);
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_PACKED_MATRIX_H
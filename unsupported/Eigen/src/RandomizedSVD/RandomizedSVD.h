@@ -0,0 +1,266 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_RANDOMIZED_SVD_H
+#define EIGEN_RANDOMIZED_SVD_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal \returns a sample of the standard normal distribution, by the Box-Muller transform */
+template<typename Scalar>
+struct randomized_svd_gaussian
+{
+  static Scalar run()
+  {
+    using std::sqrt;
+    using std::log;
+    using std::cos;
+    Scalar u1;
+    do {
+      u1 = internal::random<Scalar>(Scalar(0), Scalar(1));
+    } while(u1 <= Scalar(0));
+    Scalar u2 = internal::random<Scalar>(Scalar(0), Scalar(1));
+    return sqrt(Scalar(-2) * log(u1)) * cos(Scalar(2 * EIGEN_PI) * u2);
+  }
+};
+
+/** \internal complex samples have independent real and imaginary parts of variance 1/2 */
+template<typename RealScalar>
+struct randomized_svd_gaussian<std::complex<RealScalar> >
+{
+  static std::complex<RealScalar> run()
+  {
+    using std::sqrt;
+    const RealScalar scale = sqrt(RealScalar(0.5));
+    RealScalar re = randomized_svd_gaussian<RealScalar>::run();
+    RealScalar im = randomized_svd_gaussian<RealScalar>::run();
+    return std::complex<RealScalar>(scale * re, scale * im);
+  }
+};
+
+/** \internal Replaces the columns of \a mat by an orthonormal basis of their span */
+template<typename DenseType>
+void randomized_svd_orthonormalize(DenseType& mat)
+{
+  HouseholderQR<DenseType> qr(mat);
+  mat = qr.householderQ() * DenseType::Identity(mat.rows(), mat.cols());
+}
+
+} // end namespace internal
+
+/** \ingroup RandomizedSVD_Module
+  *
+  * \returns a matrix with \a size orthonormal columns approximating the range of \a matrix
+  *
+  * \param matrix the matrix whose range is sketched. Any type whose products \c matrix*X and \c matrix.adjoint()*X
+  *               by a dense matrix \c X are defined can be used, e.g., dense matrices, Map, or SparseMatrix.
+  * \param size the number of columns of the result, which must not be larger than the rows and the columns of \a matrix
+  * \param powerIterations the number of power iterations
+  *
+  * The range of \a matrix is sampled by its product with a \a cols x \a size matrix of independent standard normal
+  * entries, whose columns are then orthonormalized by HouseholderQR. When the singular values of \a matrix decay
+  * slowly, each power iteration multiplies the sample by \c matrix*matrix.adjoint(), which makes the largest
+  * singular values dominate, and the sample is orthonormalized again after each product to keep the smallest
+  * singular values from vanishing in round-off errors. Each power iteration costs two products by \a matrix.
+  *
+  * The random numbers are drawn from the same generator as DenseBase::Random(), that is \c std::rand().
+  *
+  * \sa class RandomizedSVD
+  */
+template<typename MatrixType>
+Matrix<typename MatrixType::Scalar,Dynamic,Dynamic>
+randomizedRangeFinder(const MatrixType& matrix, Index size, Index powerIterations = 2)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseType;
+  eigen_assert(size>=0 && size<=numext::mini(matrix.rows(), matrix.cols()) && powerIterations>=0);
+
+  DenseType omega(matrix.cols(), size);
+  for(Index j = 0; j < size; ++j)
+    for(Index i = 0; i < matrix.cols(); ++i)
+      omega.coeffRef(i,j) = internal::randomized_svd_gaussian<Scalar>::run();
+
+  DenseType q = matrix * omega;
+  internal::randomized_svd_orthonormalize(q);
+  for(Index i = 0; i < powerIterations; ++i)
+  {
+    omega = matrix.adjoint() * q;
+    internal::randomized_svd_orthonormalize(omega);
+    q = matrix * omega;
+    internal::randomized_svd_orthonormalize(q);
+  }
+  return q;
+}
+
+/** \ingroup RandomizedSVD_Module
+  *
+  * \class RandomizedSVD
+  *
+  * \brief Truncated singular value decomposition by random sketching
+  *
+  * \tparam _MatrixType the type of the matrix of which we are computing the SVD decomposition. Any type whose
+  *                     products \c A*X and \c A.adjoint()*X by a dense matrix \c X are defined can be used,
+  *                     e.g., MatrixXd, Map<const MatrixXd>, or SparseMatrix<double>.
+  *
+  * This class computes the \a k largest singular values of a m x n matrix A, and optionally the corresponding
+  * left and right singular vectors, such that
+  * \f[ A \approx U S V^* \f]
+  * with thin U and V of \a k columns. An orthonormal basis Q of \a l = \a k + oversampling() columns approximating the
+  * range of A is first computed by randomizedRangeFinder(), with powerIterations() power iterations. The small
+  * matrix \f$ A^* Q \f$ is then decomposed by JacobiSVD, whose singular values and vectors give the ones of
+  * \f$ Q Q^* A \f$. JacobiSVD is preferred to BDCSVD here because this small matrix is exactly rank deficient
+  * whenever the rank of A is lower than \a l, and its QR preconditioner first reduces it to \a l x \a l.
+  * The cost is dominated by the 2 + 2 powerIterations() products of A by dense matrices of \a l columns, that is
+  * O(mnl) instead of the O(mn min(m,n)) of a complete SVD, and the matrix is only accessed through these products.
+  *
+  * The results are exact if the rank of A is at most \a l, and otherwise approximate the largest singular values
+  * best when they are well separated from the (\a l + 1)-th one. Increasing oversampling() improves the accuracy
+  * of the last singular triplets, and increasing powerIterations() helps when the singular values decay slowly.
+  *
+  * Example:
+  * \code
+  * SparseMatrix<double> A = ...;
+  * RandomizedSVD<SparseMatrix<double> > svd(A, 50);
+  * VectorXd s = svd.singularValues();
+  * MatrixXd U = svd.matrixU(), V = svd.matrixV();
+  * \endcode
+  *
+  * \sa randomizedRangeFinder(), class JacobiSVD
+  */
+template<typename _MatrixType> class RandomizedSVD
+{
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrixType;
+    typedef Matrix<RealScalar,Dynamic,1> SingularValuesType;
+
+    /** \brief Default constructor, see compute() */
+    RandomizedSVD()
+      : m_rows(0), m_cols(0), m_oversampling(10), m_powerIterations(2),
+        m_computeU(false), m_computeV(false), m_isInitialized(false)
+    {}
+
+    /** \brief Computes the \a rank largest singular values of \a matrix \sa compute() */
+    RandomizedSVD(const MatrixType& matrix, Index rank, unsigned int computationOptions = ComputeThinU | ComputeThinV)
+      : m_rows(0), m_cols(0), m_oversampling(10), m_powerIterations(2),
+        m_computeU(false), m_computeV(false), m_isInitialized(false)
+    {
+      compute(matrix, rank, computationOptions);
+    }
+
+    /** Computes the \a rank largest singular values of \a matrix, and the corresponding singular vectors
+      * according to \a computationOptions, which is a bit field of ComputeThinU and ComputeThinV.
+      * Only thin unitaries can be computed. */
+    RandomizedSVD& compute(const MatrixType& matrix, Index rank, unsigned int computationOptions = ComputeThinU | ComputeThinV)
+    {
+      const Index diagSize = numext::mini(matrix.rows(), matrix.cols());
+      eigen_assert(rank>=0 && rank<=diagSize && "RandomizedSVD: invalid rank");
+      eigen_assert(!(computationOptions & (ComputeFullU|ComputeFullV)) && "RandomizedSVD only computes thin unitaries");
+      m_rows = matrix.rows();
+      m_cols = matrix.cols();
+      m_computeU = (computationOptions & ComputeThinU) != 0;
+      m_computeV = (computationOptions & ComputeThinV) != 0;
+
+      const Index size = numext::mini(rank + m_oversampling, diagSize);
+      DenseMatrixType q = randomizedRangeFinder(matrix, size, m_powerIterations);
+
+      // A ~ Q B with B = Q^* A, whose adjoint W = B^* = V_w S U_w^* gives A ~ (Q U_w) S V_w^*
+      DenseMatrixType w = matrix.adjoint() * q;
+      JacobiSVD<DenseMatrixType> svd(w, (m_computeU ? ComputeThinV : 0) | (m_computeV ? ComputeThinU : 0));
+      m_singularValues = svd.singularValues().head(rank);
+      if(m_computeU)
+        m_matrixU.noalias() = q * svd.matrixV().leftCols(rank);
+      else
+        m_matrixU.resize(0, 0);
+      if(m_computeV)
+        m_matrixV = svd.matrixU().leftCols(rank);
+      else
+        m_matrixV.resize(0, 0);
+      m_isInitialized = true;
+      return *this;
+    }
+
+    /** \returns the \a rows x \a rank matrix of the left singular vectors */
+    const DenseMatrixType& matrixU() const
+    {
+      eigen_assert(m_isInitialized && "RandomizedSVD is not initialized.");
+      eigen_assert(m_computeU && "This SVD decomposition didn't compute U. Did you ask for it?");
+      return m_matrixU;
+    }
+
+    /** \returns the \a cols x \a rank matrix of the right singular vectors */
+    const DenseMatrixType& matrixV() const
+    {
+      eigen_assert(m_isInitialized && "RandomizedSVD is not initialized.");
+      eigen_assert(m_computeV && "This SVD decomposition didn't compute V. Did you ask for it?");
+      return m_matrixV;
+    }
+
+    /** \returns the vector of the \a rank largest singular values, sorted in decreasing order */
+    const SingularValuesType& singularValues() const
+    {
+      eigen_assert(m_isInitialized && "RandomizedSVD is not initialized.");
+      return m_singularValues;
+    }
+
+    /** \returns the number of extra columns sampled in addition to the requested rank. The default is 10.
+      * \sa setOversampling() */
+    Index oversampling() const { return m_oversampling; }
+
+    /** Sets the number of extra columns sampled in addition to the requested rank \sa oversampling() */
+    RandomizedSVD& setOversampling(Index oversampling)
+    {
+      eigen_assert(oversampling>=0);
+      m_oversampling = oversampling;
+      return *this;
+    }
+
+    /** \returns the number of power iterations. The default is 2. \sa setPowerIterations() */
+    Index powerIterations() const { return m_powerIterations; }
+
+    /** Sets the number of power iterations \sa powerIterations(), randomizedRangeFinder() */
+    RandomizedSVD& setPowerIterations(Index iterations)
+    {
+      eigen_assert(iterations>=0);
+      m_powerIterations = iterations;
+      return *this;
+    }
+
+    /** \returns true if \a U was requested when computing the decomposition */
+    bool computeU() const { return m_computeU; }
+    /** \returns true if \a V was requested when computing the decomposition */
+    bool computeV() const { return m_computeV; }
+
+    inline Index rows() const { return m_rows; }
+    inline Index cols() const { return m_cols; }
+
+    /** \brief Reports whether the previous computation was successful.
+      *
+      * \returns \c Success, since JacobiSVD always succeeds.
+      */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "RandomizedSVD is not initialized.");
+      return Success;
+    }
+
+  protected:
+    DenseMatrixType m_matrixU;
+    DenseMatrixType m_matrixV;
+    SingularValuesType m_singularValues;
+    Index m_rows, m_cols;
+    Index m_oversampling, m_powerIterations;
+    bool m_computeU, m_computeV, m_isInitialized;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_RANDOMIZED_SVD_H
@@ -0,0 +1,291 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_STRASSEN_PRODUCT_H
+#define EIGEN_STRASSEN_PRODUCT_H
+
+namespace Eigen {
+
+template<typename Lhs, typename Rhs> class StrassenProduct;
+
+namespace internal {
+
+/** \internal */
+inline void manage_strassen_cutoff(Action action, Index* cutoff)
+{
+  static Index m_cutoff = 1024;
+
+  if(action==SetAction)
+  {
+    eigen_internal_assert(cutoff!=0);
+    m_cutoff = *cutoff;
+  }
+  else if(action==GetAction)
+  {
+    eigen_internal_assert(cutoff!=0);
+    *cutoff = m_cutoff;
+  }
+  else
+  {
+    eigen_internal_assert(false);
+  }
+}
+
+template<typename _Lhs, typename _Rhs>
+struct traits<StrassenProduct<_Lhs,_Rhs> >
+{
+  typedef typename remove_all<_Lhs>::type Lhs;
+  typedef typename remove_all<_Rhs>::type Rhs;
+  typedef typename ScalarBinaryOpTraits<typename Lhs::Scalar, typename Rhs::Scalar>::ReturnType Scalar;
+  typedef typename promote_index_type<typename Lhs::StorageIndex, typename Rhs::StorageIndex>::type StorageIndex;
+
+  enum {
+    Rows = Lhs::RowsAtCompileTime,
+    Cols = Rhs::ColsAtCompileTime,
+    MaxRows = Lhs::MaxRowsAtCompileTime,
+    MaxCols = Rhs::MaxColsAtCompileTime
+  };
+
+  typedef Matrix<Scalar,Rows,Cols,
+                 AutoAlign | ((Rows==1 && Cols!=1) ? RowMajor : ColMajor),
+                 MaxRows,MaxCols> ReturnType;
+};
+
+/* Recursive Strassen-Winograd product of column-major matrices.
+ *
+ * At each level, the even part of the operands is split into 2x2 blocks, and the 7 products of the
+ * Winograd variant are scheduled with three temporaries X, Y, Z of sizes m/2 x k/2, k/2 x n/2 and m/2 x n/2,
+ * the quadrants of the result holding the intermediate sums. The odd rows and columns are handled by
+ * dynamic peeling with matrix-vector products. The recursion stops as soon as one of the dimensions is
+ * not larger than the cutoff, and the leaves are evaluated by the general matrix product kernels.
+ */
+template<typename Scalar>
+struct strassen_product_impl
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  typedef Ref<const MatrixType, 0, OuterStride<> > ConstRefType;
+  typedef Ref<MatrixType, 0, OuterStride<> > RefType;
+  typedef Map<MatrixType> TmpType;
+
+  static bool isLeaf(Index m, Index k, Index n, Index cutoff)
+  {
+    return numext::mini(m, numext::mini(k, n)) <= numext::maxi(cutoff, Index(1));
+  }
+
+  /* \returns the number of scalars of workspace needed by run() */
+  static Index workspaceSize(Index m, Index k, Index n, Index cutoff)
+  {
+    if(isLeaf(m, k, n, cutoff))
+      return 0;
+    const Index m2 = m/2, k2 = k/2, n2 = n/2;
+    return m2*k2 + k2*n2 + m2*n2 + workspaceSize(m2, k2, n2, cutoff);
+  }
+
+  static void run(const ConstRefType& A, const ConstRefType& B, RefType& C, Index cutoff, Scalar* workspace)
+  {
+    const Index m = A.rows(), k = A.cols(), n = B.cols();
+    if(isLeaf(m, k, n, cutoff))
+    {
+      C.noalias() = A * B;
+      return;
+    }
+
+    const Index m2 = m/2, k2 = k/2, n2 = n/2;
+    TmpType X(workspace, m2, k2);
+    TmpType Y(workspace + m2*k2, k2, n2);
+    TmpType Zmap(workspace + m2*k2 + k2*n2, m2, n2);
+    RefType Z(Zmap);
+    Scalar* next = workspace + m2*k2 + k2*n2 + m2*n2;
+
+    const ConstRefType A11 = A.block(0, 0, m2, k2), A12 = A.block(0, k2, m2, k2),
+                       A21 = A.block(m2, 0, m2, k2), A22 = A.block(m2, k2, m2, k2);
+    const ConstRefType B11 = B.block(0, 0, k2, n2), B12 = B.block(0, n2, k2, n2),
+                       B21 = B.block(k2, 0, k2, n2), B22 = B.block(k2, n2, k2, n2);
+    RefType C11 = C.block(0, 0, m2, n2), C12 = C.block(0, n2, m2, n2),
+            C21 = C.block(m2, 0, m2, n2), C22 = C.block(m2, n2, m2, n2);
+
+    // P7 = (A11 - A21) (B22 - B12)
+    X = A11 - A21;
+    Y = B22 - B12;
+    run(X, Y, C21, cutoff, next);
+    // P5 = (A21 + A22) (B12 - B11)
+    X = A21 + A22;
+    Y = B12 - B11;
+    run(X, Y, C22, cutoff, next);
+    // P6 = (A21 + A22 - A11) (B22 - B12 + B11)
+    X -= A11;
+    Y = B22 - Y;
+    run(X, Y, C12, cutoff, next);
+    // P1 = A11 B11
+    run(A11, B11, C11, cutoff, next);
+
+    C12 += C11;  // U2 = P1 + P6
+    C21 += C12;  // U3 = U2 + P7
+    C12 += C22;  // U4 = U2 + P5
+    C22 += C21;  // C22 = U3 + P5
+
+    // P3 = (A12 - A21 - A22 + A11) B22
+    X = A12 - X;
+    run(X, B22, Z, cutoff, next);
+    C12 += Z;    // C12 = U4 + P3
+    // P4 = A22 (B22 - B12 + B11 - B21)
+    Y -= B21;
+    run(A22, Y, Z, cutoff, next);
+    C21 -= Z;    // C21 = U3 - P4
+    // P2 = A12 B21
+    run(A12, B21, Z, cutoff, next);
+    C11 += Z;    // C11 = P1 + P2
+
+    // dynamic peeling of the odd row, column, and depth
+    const Index me = 2*m2, ke = 2*k2, ne = 2*n2;
+    if(k!=ke)
+      C.topLeftCorner(me, ne).noalias() += A.col(ke).head(me) * B.row(ke).head(ne);
+    if(n!=ne)
+      C.col(ne).noalias() = A * B.col(ne);
+    if(m!=me)
+      C.row(me).head(ne).noalias() = A.row(me) * B.leftCols(ne);
+  }
+
+  template<typename Dest>
+  static void run(const ConstRefType& A, const ConstRefType& B, Dest& dst, Index cutoff)
+  {
+    RefType C(dst);
+    const Index size = workspaceSize(A.rows(), A.cols(), B.cols(), cutoff);
+    ei_declare_aligned_stack_constructed_variable(Scalar, workspace, size, 0);
+    run(A, B, C, cutoff, workspace);
+  }
+};
+
+template<typename Scalar, bool DestIsRowMajor>
+struct strassen_product_dest_selector
+{
+  template<typename Lhs, typename Rhs, typename Dest>
+  static void run(const Lhs& lhs, const Rhs& rhs, Dest& dst, Index cutoff)
+  {
+    strassen_product_impl<Scalar>::run(lhs, rhs, dst, cutoff);
+  }
+};
+
+template<typename Scalar>
+struct strassen_product_dest_selector<Scalar,true>
+{
+  template<typename Lhs, typename Rhs, typename Dest>
+  static void run(const Lhs& lhs, const Rhs& rhs, Dest& dst, Index cutoff)
+  {
+    Matrix<Scalar,Dynamic,Dynamic> tmp(dst.rows(), dst.cols());
+    strassen_product_impl<Scalar>::run(lhs, rhs, tmp, cutoff);
+    dst = tmp;
+  }
+};
+
+} // end namespace internal
+
+/** \ingroup StrassenProduct_Module
+  *
+  * \brief Expression of a matrix product evaluated by the Strassen-Winograd algorithm
+  *
+  * This class is the return value of strassenProduct(). Use the function rather than constructing this class
+  * directly.
+  *
+  * \tparam Lhs the type of the left hand side
+  * \tparam Rhs the type of the right hand side
+  */
+template<typename Lhs, typename Rhs>
+class StrassenProduct : public ReturnByValue<StrassenProduct<Lhs,Rhs> >
+{
+    typedef typename internal::traits<StrassenProduct>::Scalar Scalar;
+  public:
+    StrassenProduct(const Lhs& lhs, const Rhs& rhs, Index cutoff)
+      : m_lhs(lhs), m_rhs(rhs), m_cutoff(cutoff)
+    {
+      eigen_assert(lhs.cols()==rhs.rows() && "invalid matrix product");
+    }
+
+    inline Index rows() const { return m_lhs.rows(); }
+    inline Index cols() const { return m_rhs.cols(); }
+
+    /** \brief Evaluates the product into \a dst */
+    template<typename Dest> void evalTo(Dest& dst) const
+    {
+      typedef typename internal::strassen_product_impl<Scalar>::ConstRefType ConstRefType;
+      dst.resize(rows(), cols());
+      // the operands which are not column-major matrices are evaluated into temporaries
+      const ConstRefType lhs(m_lhs), rhs(m_rhs);
+      internal::strassen_product_dest_selector<Scalar,bool(Dest::IsRowMajor)>::run(lhs, rhs, dst, m_cutoff);
+    }
+
+  protected:
+    typename Lhs::Nested m_lhs;
+    typename Rhs::Nested m_rhs;
+    Index m_cutoff;
+};
+
+/** \ingroup StrassenProduct_Module
+  *
+  * \returns an expression of the product of \a lhs by \a rhs evaluated by the Strassen-Winograd algorithm
+  *
+  * The operands are recursively split into halves until one of the dimensions is not larger than \a cutoff,
+  * and the smaller products are evaluated by the usual matrix product kernels, including their multi-threading.
+  * Each level of recursion trades one eighth of the operations for about 15 extra matrix additions, so the
+  * algorithm only pays off for large products, typically when all the dimensions are larger than 2 to 4 times
+  * the cutoff. The temporaries need about (mk+kn+mn)/3 scalars, and are allocated once per product.
+  *
+  * The result is slightly less accurate than the one of the classical product: its error is bounded in norm
+  * rather than entry-wise, and grows by a small constant factor per level of recursion.
+  *
+  * Example:
+  * \code
+  * MatrixXd C = strassenProduct(A, B);
+  * \endcode
+  *
+  * \warning The destination must not alias the operands: \c A = strassenProduct(A,B) is a bug, use
+  * strassenProduct(A,B).eval() instead.
+  *
+  * \sa setStrassenCutoff()
+  */
+template<typename Lhs, typename Rhs>
+StrassenProduct<Lhs,Rhs> strassenProduct(const MatrixBase<Lhs>& lhs, const MatrixBase<Rhs>& rhs, Index cutoff)
+{
+  EIGEN_STATIC_ASSERT((internal::is_same<typename Lhs::Scalar, typename Rhs::Scalar>::value),
+                      YOU_MIXED_DIFFERENT_NUMERIC_TYPES__YOU_NEED_TO_USE_THE_CAST_METHOD_OF_MATRIXBASE_TO_CAST_NUMERIC_TYPES_EXPLICITLY)
+  return StrassenProduct<Lhs,Rhs>(lhs.derived(), rhs.derived(), cutoff);
+}
+
+/** \ingroup StrassenProduct_Module
+  *
+  * \returns the cutoff used by strassenProduct() when none is given
+  * \sa setStrassenCutoff() */
+inline Index strassenCutoff()
+{
+  Index ret;
+  internal::manage_strassen_cutoff(GetAction, &ret);
+  return ret;
+}
+
+/** \ingroup StrassenProduct_Module
+  *
+  * Sets the cutoff used by strassenProduct() when none is given. The default is 1024.
+  * \sa strassenCutoff() */
+inline void setStrassenCutoff(Index cutoff)
+{
+  eigen_assert(cutoff>0);
+  internal::manage_strassen_cutoff(SetAction, &cutoff);
+}
+
+/** \ingroup StrassenProduct_Module
+  *
+  * \returns strassenProduct(lhs, rhs, strassenCutoff())
+  */
+template<typename Lhs, typename Rhs>
+StrassenProduct<Lhs,Rhs> strassenProduct(const MatrixBase<Lhs>& lhs, const MatrixBase<Rhs>& rhs)
+{
+  return strassenProduct(lhs, rhs, strassenCutoff());
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_STRASSEN_PRODUCT_H
@@ -0,0 +1,412 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_TALL_SKINNY_QR_H
+#define EIGEN_TALL_SKINNY_QR_H
+
+namespace Eigen {
+
+template<typename _MatrixType> class TallSkinnyQR;
+
+namespace internal {
+
+template<typename _MatrixType> struct traits<TallSkinnyQR<_MatrixType> >
+ : traits<_MatrixType>
+{
+  typedef MatrixXpr XprKind;
+  typedef SolverStorage StorageKind;
+  typedef int StorageIndex;
+  enum { Flags = 0 };
+};
+
+/* Factors the blocks of rows [starts[i],starts[i+1]) of mat in place, the Householder coefficients
+ * of the i-th block being stored in the i-th column of hCoeffs. */
+template<typename MatrixType>
+struct tall_skinny_qr_factor_functor
+{
+  tall_skinny_qr_factor_functor(MatrixType& mat, MatrixType& hCoeffs, const std::vector<Index>& starts)
+    : m_mat(mat), m_hCoeffs(hCoeffs), m_starts(starts)
+  {}
+
+  void operator()(Index start, Index length) const
+  {
+    typedef Block<MatrixType,Dynamic,Dynamic> BlockType;
+    typedef typename MatrixType::ColXpr CoeffsType;
+    typedef typename MatrixType::Scalar Scalar;
+    Matrix<Scalar,Dynamic,1> temp(m_mat.cols());
+    for(Index i = start; i < start+length; ++i)
+    {
+      BlockType block(m_mat, m_starts[i], 0, m_starts[i+1]-m_starts[i], m_mat.cols());
+      CoeffsType hCoeffs(m_hCoeffs.col(i));
+      householder_qr_inplace_blocked<BlockType,CoeffsType>::run(block, hCoeffs, 48, temp.data());
+    }
+  }
+
+  MatrixType& m_mat;
+  MatrixType& m_hCoeffs;
+  const std::vector<Index>& m_starts;
+};
+
+/* Applies the adjoint of the Q factors of the blocks factored by tall_skinny_qr_factor_functor
+ * to the same blocks of rows of dst. */
+template<typename MatrixType>
+struct tall_skinny_qr_apply_functor
+{
+  tall_skinny_qr_apply_functor(const MatrixType& mat, const MatrixType& hCoeffs, const std::vector<Index>& starts,
+                               MatrixType& dst)
+    : m_mat(mat), m_hCoeffs(hCoeffs), m_starts(starts), m_dst(dst)
+  {}
+
+  void operator()(Index start, Index length) const
+  {
+    for(Index i = start; i < start+length; ++i)
+    {
+      const Index rows = m_starts[i+1]-m_starts[i];
+      m_dst.middleRows(m_starts[i], rows)
+           .applyOnTheLeft(householderSequence(m_mat.middleRows(m_starts[i], rows),
+                                               m_hCoeffs.col(i).conjugate()).adjoint());
+    }
+  }
+
+  const MatrixType& m_mat;
+  const MatrixType& m_hCoeffs;
+  const std::vector<Index>& m_starts;
+  MatrixType& m_dst;
+};
+
+} // end namespace internal
+
+/** \ingroup TallSkinnyQR_Module
+  *
+  * \class TallSkinnyQR
+  *
+  * \brief Householder QR decomposition of a tall and skinny matrix by a reduction tree
+  *
+  * \tparam _MatrixType the type of the matrix of which we are computing the QR decomposition
+  *
+  * This class computes the QR decomposition \f$ A = Q R \f$ of a matrix with at least as many rows as columns,
+  * as the TSQR algorithm: the rows of A are split into blocks which are factored independently, and the
+  * R factors of the blocks are then combined pairwise, by factoring the stack of two of them, until a single
+  * R factor remains. The factorizations of a same level of the tree are independent from each other, and are
+  * split among the threads reserved for Eigen (see setNbThreads() and setGemmExecutor()). In contrast,
+  * HouseholderQR factors all the rows as a single panel, whose updates are dominated by memory bound
+  * matrix-vector products when there are few columns.
+  *
+  * Q is stored implicitly as the Householder reflectors of the blocks and of the nodes of the tree, and is only
+  * used to solve least-squares problems through solve(). Like HouseholderQR, the decomposition does not reveal
+  * the rank of A, which must have full column rank for the solutions to be meaningful.
+  *
+  * The decomposition can also be computed from blocks of rows given one after the other by addRows(), after
+  * a call to reset(). Each block is then factored together with the current R factor, and only R, as well as
+  * the first rows of the product of Q^* by the right hand sides given with the blocks, are kept. This solves
+  * least-squares problems whose matrix never has to be resident in memory:
+  * \code
+  * TallSkinnyQR<MatrixXd> tsqr;
+  * tsqr.reset(A_cols, 1);
+  * while(readNextBlock(A_block, b_block))
+  *   tsqr.addRows(A_block, b_block);
+  * VectorXd x = tsqr.solution();
+  * \endcode
+  *
+  * \sa class HouseholderQR
+  */
+template<typename _MatrixType> class TallSkinnyQR
+        : public SolverBase<TallSkinnyQR<_MatrixType> >
+{
+  public:
+
+    typedef _MatrixType MatrixType;
+    typedef SolverBase<TallSkinnyQR> Base;
+    friend class SolverBase<TallSkinnyQR>;
+
+    EIGEN_GENERIC_PUBLIC_INTERFACE(TallSkinnyQR)
+    enum {
+      MaxColsAtCompileTime = MatrixType::MaxColsAtCompileTime
+    };
+    typedef Matrix<Scalar,ColsAtCompileTime,ColsAtCompileTime,ColMajor,MaxColsAtCompileTime,MaxColsAtCompileTime> MatrixRType;
+    typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+
+    /** \brief Default constructor, see compute() and reset() */
+    TallSkinnyQR()
+      : m_rows(0), m_cols(0), m_blockRows(0), m_isInitialized(false), m_isStreaming(false)
+    {}
+
+    /** \brief Constructs the QR decomposition of \a matrix \sa compute() */
+    template<typename InputType>
+    explicit TallSkinnyQR(const EigenBase<InputType>& matrix)
+      : m_rows(0), m_cols(0), m_blockRows(0), m_isInitialized(false), m_isStreaming(false)
+    {
+      compute(matrix.derived());
+    }
+
+    /** Computes the QR decomposition of \a matrix, which must have at least as many rows as columns. */
+    template<typename InputType>
+    TallSkinnyQR& compute(const EigenBase<InputType>& matrix)
+    {
+      check_template_parameters();
+      eigen_assert(matrix.rows()>=matrix.cols() && "TallSkinnyQR requires at least as many rows as columns");
+      m_qr = matrix.derived();
+      m_rows = m_qr.rows();
+      m_cols = m_qr.cols();
+      factorize();
+      m_rhsHead.resize(0, 0);
+      m_isStreaming = false;
+      m_isInitialized = true;
+      return *this;
+    }
+
+    /** Starts a new decomposition of a matrix with \a cols columns, whose rows are then given by addRows().
+      * The right hand sides of the least-squares problem, if any, have \a rhsCols columns, and their rows
+      * have to be given together with the rows of the matrix. */
+    TallSkinnyQR& reset(Index cols, Index rhsCols = 0)
+    {
+      check_template_parameters();
+      eigen_assert(cols>=0 && rhsCols>=0);
+      m_rows = 0;
+      m_cols = cols;
+      m_qr.resize(0, cols);
+      m_matrixR.setZero(cols, cols);
+      m_rhsHead.setZero(cols, rhsCols);
+      m_isStreaming = true;
+      m_isInitialized = true;
+      return *this;
+    }
+
+    /** Appends the rows \a rows to the matrix being decomposed since the last call to reset().
+      * This version can only be used when reset() was called without right hand sides. */
+    template<typename RowsType>
+    TallSkinnyQR& addRows(const MatrixBase<RowsType>& rows)
+    {
+      eigen_assert(m_isStreaming && "TallSkinnyQR::reset() must be called before adding rows");
+      eigen_assert(m_rhsHead.cols()==0 && "the right hand sides must be given with the rows");
+      stackRows(rows);
+      factorize();
+      return *this;
+    }
+
+    /** Appends the rows \a rows to the matrix being decomposed since the last call to reset(), and the
+      * rows \a rhs to the right hand sides of the least-squares problem. */
+    template<typename RowsType, typename RhsType>
+    TallSkinnyQR& addRows(const MatrixBase<RowsType>& rows, const MatrixBase<RhsType>& rhs)
+    {
+      eigen_assert(m_isStreaming && "TallSkinnyQR::reset() must be called before adding rows");
+      eigen_assert(rhs.rows()==rows.rows() && rhs.cols()==m_rhsHead.cols());
+      stackRows(rows);
+      factorize();
+      WorkMatrixType b(m_qr.rows(), m_rhsHead.cols());
+      b.topRows(m_cols) = m_rhsHead;
+      b.bottomRows(rhs.rows()) = rhs;
+      applyQAdjointHead(b, m_rhsHead);
+      return *this;
+    }
+
+    /** \returns the least-squares solution of the rows given to addRows() since the last call to reset() */
+    WorkMatrixType solution() const
+    {
+      eigen_assert(m_isInitialized && m_isStreaming && "TallSkinnyQR::solution() requires rows given by addRows()");
+      return m_matrixR.template triangularView<Upper>().solve(m_rhsHead);
+    }
+
+    /** \returns the product of the adjoint of Q by the right hand sides given to addRows(), restricted to
+      * its first cols() rows */
+    const WorkMatrixType& rhsHead() const
+    {
+      eigen_assert(m_isInitialized && m_isStreaming && "TallSkinnyQR::rhsHead() requires rows given by addRows()");
+      return m_rhsHead;
+    }
+
+    /** \returns the upper triangular factor R, as a square matrix whose strictly lower part is zero */
+    const MatrixRType& matrixR() const
+    {
+      eigen_assert(m_isInitialized && "TallSkinnyQR is not initialized.");
+      return m_matrixR;
+    }
+
+    /** \returns the number of rows of the blocks factored at the leaves of the tree
+      * \sa setBlockRows() */
+    Index blockRows() const
+    {
+      return numext::maxi(m_cols, m_blockRows>0 ? m_blockRows : numext::maxi(Index(2048), 8*m_cols));
+    }
+
+    /** Sets the number of rows of the blocks factored at the leaves of the tree. The actual blocks are never
+      * smaller than the number of columns, and the rows of the matrix are split into as many blocks of at least
+      * \a rows rows as possible. The default, 0, selects a number of rows such that a block is about 1MB
+      * for up to 64 columns of doubles. */
+    TallSkinnyQR& setBlockRows(Index rows)
+    {
+      m_blockRows = rows;
+      return *this;
+    }
+
+    /** \returns the number of blocks of rows factored at the leaves of the tree by the last factorization */
+    Index leafCount() const
+    {
+      eigen_assert(m_isInitialized && "TallSkinnyQR is not initialized.");
+      return m_blockStarts.empty() ? 0 : Index(m_blockStarts.size())-1;
+    }
+
+    /** \returns the number of rows of the decomposed matrix */
+    inline Index rows() const { return m_rows; }
+    /** \returns the number of columns of the decomposed matrix */
+    inline Index cols() const { return m_cols; }
+
+    /** \brief Reports whether the QR factorization was successful.
+      *
+      * \note This function always returns \c Success. It is provided for compatibility
+      * with other factorization routines.
+      * \returns \c Success
+      */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "TallSkinnyQR is not initialized.");
+      return Success;
+    }
+
+    #ifndef EIGEN_PARSED_BY_DOXYGEN
+    template<typename RhsType, typename DstType>
+    void _solve_impl(const RhsType &rhs, DstType &dst) const;
+    #endif
+
+  protected:
+
+    static void check_template_parameters()
+    {
+      EIGEN_STATIC_ASSERT_NON_INTEGER(Scalar);
+    }
+
+    template<typename RowsType>
+    void stackRows(const MatrixBase<RowsType>& rows)
+    {
+      eigen_assert(rows.cols()==m_cols);
+      // the current R factor stands for all the rows given so far
+      m_qr.resize(m_cols+rows.rows(), m_cols);
+      m_qr.topRows(m_cols) = m_matrixR;
+      m_qr.bottomRows(rows.rows()) = rows;
+      m_rows += rows.rows();
+    }
+
+    static void evenStarts(std::vector<Index>& starts, Index count, Index rows)
+    {
+      starts.resize(count+1);
+      for(Index i = 0; i <= count; ++i)
+        starts[i] = (i*rows)/count;
+    }
+
+    static void factorBlocks(WorkMatrixType& mat, WorkMatrixType& hCoeffs, const std::vector<Index>& starts)
+    {
+      const Index count = Index(starts.size())-1;
+      hCoeffs.resize(mat.cols(), count);
+      double work = 2. * static_cast<double>(mat.rows()) * static_cast<double>(mat.cols()) * static_cast<double>(mat.cols());
+      internal::parallelize_range<true>(internal::tall_skinny_qr_factor_functor<WorkMatrixType>(mat, hCoeffs, starts),
+                                        count, Index(1), work);
+    }
+
+    static void applyBlocks(const WorkMatrixType& mat, const WorkMatrixType& hCoeffs, const std::vector<Index>& starts,
+                            WorkMatrixType& dst)
+    {
+      const Index count = Index(starts.size())-1;
+      double work = 4. * static_cast<double>(mat.rows()) * static_cast<double>(mat.cols()) * static_cast<double>(dst.cols());
+      internal::parallelize_range<true>(internal::tall_skinny_qr_apply_functor<WorkMatrixType>(mat, hCoeffs, starts, dst),
+                                        count, Index(1), work);
+    }
+
+    void factorize();
+    void applyQAdjointHead(const WorkMatrixType& rhs, WorkMatrixType& head) const;
+
+    WorkMatrixType m_qr;
+    WorkMatrixType m_leafCoeffs;
+    std::vector<Index> m_blockStarts;
+    // the pairs of R factors stacked and factored at each level of the tree
+    std::vector<WorkMatrixType> m_levels;
+    std::vector<WorkMatrixType> m_levelCoeffs;
+    MatrixRType m_matrixR;
+    WorkMatrixType m_rhsHead;
+    Index m_rows, m_cols, m_blockRows;
+    bool m_isInitialized, m_isStreaming;
+};
+
+/** \internal Factors m_qr by blocks of rows, and reduces their R factors by a binary tree into m_matrixR */
+template<typename MatrixType>
+void TallSkinnyQR<MatrixType>::factorize()
+{
+  const Index rows = m_qr.rows();
+  const Index cols = m_qr.cols();
+  const Index leaves = numext::maxi(Index(1), rows/blockRows());
+  evenStarts(m_blockStarts, leaves, rows);
+  factorBlocks(m_qr, m_leafCoeffs, m_blockStarts);
+
+  // the R factors of the current level of the tree, stacked
+  WorkMatrixType factors(leaves*cols, cols);
+  for(Index i = 0; i < leaves; ++i)
+    factors.middleRows(i*cols, cols) = m_qr.middleRows(m_blockStarts[i], cols).template triangularView<Upper>();
+
+  m_levels.clear();
+  m_levelCoeffs.clear();
+  std::vector<Index> starts;
+  for(Index count = leaves; count > 1; count = (count+1)/2)
+  {
+    const Index pairs = count/2;
+    m_levels.push_back(factors.topRows(2*pairs*cols));
+    m_levelCoeffs.push_back(WorkMatrixType());
+    evenStarts(starts, pairs, 2*pairs*cols);
+    factorBlocks(m_levels.back(), m_levelCoeffs.back(), starts);
+
+    // the R factor of each pair, followed by the unpaired factor if any
+    for(Index p = 0; p < pairs; ++p)
+      factors.middleRows(p*cols, cols) = m_levels.back().middleRows(2*p*cols, cols).template triangularView<Upper>();
+    if(count%2)
+      factors.middleRows(pairs*cols, cols) = factors.middleRows((count-1)*cols, cols);
+  }
+  m_matrixR = factors.topRows(cols);
+}
+
+/** \internal Computes the first cols() rows of the product of the adjoint of Q by \a rhs */
+template<typename MatrixType>
+void TallSkinnyQR<MatrixType>::applyQAdjointHead(const WorkMatrixType& rhs, WorkMatrixType& head) const
+{
+  const Index cols = m_cols;
+  const Index leaves = Index(m_blockStarts.size())-1;
+  WorkMatrixType c = rhs;
+  applyBlocks(m_qr, m_leafCoeffs, m_blockStarts, c);
+
+  WorkMatrixType heads(leaves*cols, rhs.cols());
+  for(Index i = 0; i < leaves; ++i)
+    heads.middleRows(i*cols, cols) = c.middleRows(m_blockStarts[i], cols);
+
+  std::vector<Index> starts;
+  Index count = leaves;
+  for(size_t l = 0; l < m_levels.size(); ++l, count = (count+1)/2)
+  {
+    const Index pairs = count/2;
+    evenStarts(starts, pairs, 2*pairs*cols);
+    c = heads.topRows(2*pairs*cols);
+    applyBlocks(m_levels[l], m_levelCoeffs[l], starts, c);
+    for(Index p = 0; p < pairs; ++p)
+      heads.middleRows(p*cols, cols) = c.middleRows(2*p*cols, cols);
+    if(count%2)
+      heads.middleRows(pairs*cols, cols) = heads.middleRows((count-1)*cols, cols);
+  }
+  head = heads.topRows(cols);
+}
+
+#ifndef EIGEN_PARSED_BY_DOXYGEN
+template<typename _MatrixType>
+template<typename RhsType, typename DstType>
+void TallSkinnyQR<_MatrixType>::_solve_impl(const RhsType &rhs, DstType &dst) const
+{
+  eigen_assert(!m_isStreaming && "TallSkinnyQR::solve() requires a decomposition computed by compute(), use solution() instead");
+  WorkMatrixType head;
+  applyQAdjointHead(rhs, head);
+  m_matrixR.template triangularView<Upper>().solveInPlace(head);
+  dst = head;
+}
+#endif
+
+} // end namespace Eigen
+
+#endif // EIGEN_TALL_SKINNY_QR_H
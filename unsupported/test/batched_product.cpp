@@ -0,0 +1,84 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <unsupported/Eigen/BatchedProduct>
+
+template<typename LhsType, typename RhsType, typename DstType>
+void batched_product_strided(Index rows, Index depth, Index cols)
+{
+  typedef typename DstType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+  const Index count = internal::random<Index>(1,300);
+  // add some padding between the matrices
+  const Index lhsStride = rows*depth + internal::random<Index>(0,3);
+  const Index rhsStride = depth*cols + internal::random<Index>(0,3);
+  const Index dstStride = rows*cols + internal::random<Index>(0,3);
+
+  VectorType a = VectorType::Random(count*lhsStride);
+  VectorType b = VectorType::Random(count*rhsStride);
+  VectorType c = VectorType::Random(count*dstStride);
+
+  MatrixBatch<const LhsType> A(a.data(), count, lhsStride, rows, depth);
+  MatrixBatch<const RhsType> B(b.data(), count, rhsStride, depth, cols);
+  MatrixBatch<DstType> C(c.data(), count, dstStride, rows, cols);
+  VERIFY_IS_EQUAL(A.size(), count);
+  VERIFY_IS_EQUAL(C.outerStride(), DstType::IsRowMajor ? cols : rows);
+
+  batchedProduct(A, B, C);
+
+  for(Index i=0; i<count; ++i)
+  {
+    DstType ref = A[i] * B[i];
+    VERIFY_IS_APPROX(C[i], ref);
+  }
+}
+
+template<typename MatrixType>
+void batched_product_pointers(Index rows, Index depth, Index cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  const Index count = internal::random<Index>(1,100);
+  const Index outerStride = rows + 2;
+
+  std::vector<MatrixType> a(count), b(count), c(count);
+  std::vector<const Scalar*> pa(count), pb(count);
+  std::vector<Scalar*> pc(count);
+  for(Index i=0; i<count; ++i)
+  {
+    // the matrices of the lhs batch are blocks of larger matrices
+    a[i] = MatrixType::Random(outerStride, depth);
+    b[i] = MatrixType::Random(depth, cols);
+    c[i] = MatrixType::Zero(rows, cols);
+    pa[i] = a[i].data(); pb[i] = b[i].data(); pc[i] = c[i].data();
+  }
+
+  MatrixBatch<const MatrixType> A(&pa[0], count, rows, depth, outerStride);
+  MatrixBatch<const MatrixType> B(&pb[0], count, depth, cols);
+  MatrixBatch<MatrixType> C(&pc[0], count, rows, cols);
+
+  batchedProduct(A, B, C);
+
+  for(Index i=0; i<count; ++i)
+    VERIFY_IS_APPROX(c[i], (a[i].topRows(rows) * b[i]).eval());
+}
+
+EIGEN_DECLARE_TEST(batched_product)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( batched_product_strided<Matrix4f,Matrix4f,Matrix4f>(4,4,4) ));
+    CALL_SUBTEST_1(( batched_product_strided<Matrix3f,Matrix<float,3,5>,Matrix<float,3,5,RowMajor> >(3,3,5) ));
+    CALL_SUBTEST_2(( batched_product_strided<Matrix<double,8,8>,Matrix<double,8,8,RowMajor>,Matrix<double,8,8> >(8,8,8) ));
+    CALL_SUBTEST_3(( batched_product_strided<Matrix<float,32,32>,Matrix<float,32,32>,Matrix<float,32,32> >(32,32,32) ));
+    CALL_SUBTEST_3(( batched_product_strided<Matrix<float,24,32,RowMajor>,Matrix<float,32,20>,Matrix<float,24,20,RowMajor> >(24,32,20) ));
+    CALL_SUBTEST_4(( batched_product_strided<MatrixXd,MatrixXd,MatrixXd>(internal::random<Index>(1,8),internal::random<Index>(1,8),internal::random<Index>(1,8)) ));
+    CALL_SUBTEST_4(( batched_product_strided<MatrixXd,MatrixXd,MatrixXd>(internal::random<Index>(20,50),internal::random<Index>(20,50),internal::random<Index>(20,50)) ));
+    CALL_SUBTEST_5(( batched_product_strided<MatrixXcf,MatrixXcf,Matrix<std::complex<float>,Dynamic,Dynamic,RowMajor> >(internal::random<Index>(1,40),internal::random<Index>(1,40),internal::random<Index>(1,40)) ));
+    CALL_SUBTEST_6(( batched_product_pointers<MatrixXf>(internal::random<Index>(1,40),internal::random<Index>(1,40),internal::random<Index>(1,40)) ));
+    CALL_SUBTEST_6(( batched_product_pointers<MatrixXd>(internal::random<Index>(1,6),internal::random<Index>(1,6),internal::random<Index>(1,6)) ));
+  }
+}
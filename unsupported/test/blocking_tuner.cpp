@@ -0,0 +1,134 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// <chrono>, used by the tuner, must be included before the min/max macros of main.h
+#if __cplusplus >= 201103L
+#include <chrono>
+#endif
+
+#include "main.h"
+#include <unsupported/Eigen/BlockingTuner>
+
+void blocking_table_io()
+{
+  typedef GemmBlockingTable::Sizes Sizes;
+  GemmBlockingTable table;
+  VERIFY_IS_EQUAL(GemmBlockingTable::shapeClass(1), 0);
+  VERIFY_IS_EQUAL(GemmBlockingTable::shapeClass(64), 6);
+  VERIFY_IS_EQUAL(GemmBlockingTable::shapeClass(65), 7);
+
+  table.insert(GemmBlockingProvider::Double, GemmBlockingProvider::Double, 1, 300, 500, 700, Sizes(128, 96, 512));
+  table.insert(GemmBlockingProvider::Float, GemmBlockingProvider::ComplexFloat, 4, 1000, 20, 3000, Sizes(20, 256, 1024));
+  VERIFY_IS_EQUAL(table.size(), 2);
+
+  // all the products of the same shape class share an entry
+  Sizes sizes;
+  VERIFY(table.find(GemmBlockingProvider::Double, GemmBlockingProvider::Double, 1, 257, 512, 600, sizes));
+  VERIFY_IS_EQUAL(sizes.kc, 128);
+  VERIFY_IS_EQUAL(sizes.mc, 96);
+  VERIFY_IS_EQUAL(sizes.nc, 512);
+  VERIFY(!table.find(GemmBlockingProvider::Double, GemmBlockingProvider::Double, 2, 300, 500, 700, sizes));
+  VERIFY(!table.find(GemmBlockingProvider::Float, GemmBlockingProvider::Float, 1, 300, 500, 700, sizes));
+  VERIFY(!table.find(GemmBlockingProvider::Double, GemmBlockingProvider::Double, 1, 300, 500, 1100, sizes));
+
+  std::stringstream stream;
+  VERIFY(table.save(stream));
+  GemmBlockingTable loaded;
+  VERIFY(loaded.load(stream));
+  VERIFY_IS_EQUAL(loaded.size(), 2);
+  VERIFY(loaded.find(GemmBlockingProvider::Float, GemmBlockingProvider::ComplexFloat, 4, 1000, 20, 3000, sizes));
+  VERIFY_IS_EQUAL(sizes.kc, 20);
+  VERIFY_IS_EQUAL(sizes.mc, 256);
+  VERIFY_IS_EQUAL(sizes.nc, 1024);
+
+  // malformed tables are rejected and leave the table unchanged
+  std::istringstream badScalar("half half 1 64 64 64 32 32 32\n");
+  VERIFY(!loaded.load(badScalar));
+  std::istringstream badSizes("float float 1 64 64 64 32 0 32\n");
+  VERIFY(!loaded.load(badSizes));
+  std::istringstream extraField("float float 1 64 64 64 32 32 32 32\n");
+  VERIFY(!loaded.load(extraField));
+  VERIFY_IS_EQUAL(loaded.size(), 2);
+
+  std::istringstream commented("# comment\n\n  double double 2 128 128 128 64 32 128\n");
+  VERIFY(loaded.load(commented));
+  VERIFY_IS_EQUAL(loaded.size(), 1);
+  VERIFY(loaded.find(GemmBlockingProvider::Double, GemmBlockingProvider::Double, 2, 100, 100, 100, sizes));
+}
+
+template<typename Scalar>
+void blocking_table_provider()
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMatrixType;
+  typedef typename GemmBlockingProvider::ScalarType ScalarType;
+  typedef internal::gebp_traits<Scalar,Scalar> Traits;
+  const ScalarType type = ScalarType(internal::gemm_blocking_scalar_type<Scalar>::value);
+
+  GemmBlockingTable table;
+  table.insert(type, type, 1, 200, 150, 180, GemmBlockingTable::Sizes(24, 5*Traits::mr+1, 3*Traits::nr+1));
+  setGemmBlockingProvider(&table);
+  VERIFY(gemmBlockingProvider()==&table);
+
+  // the provided sizes are rounded to the register blocking
+  Index k = 150, m = 200, n = 180;
+  internal::computeProductBlockingSizes<Scalar,Scalar>(k, m, n);
+  VERIFY_IS_EQUAL(k, 24);
+  VERIFY_IS_EQUAL(m, (5*Traits::mr+1) - (5*Traits::mr+1)%Traits::mr);
+  VERIFY_IS_EQUAL(n, (3*Traits::nr+1) - (3*Traits::nr+1)%Traits::nr);
+
+  // and clamped to the dimensions of the product
+  k = 20; m = 130; n = 3;
+  internal::computeProductBlockingSizes<Scalar,Scalar>(k, m, n);
+  VERIFY_IS_EQUAL(k, 20);
+  VERIFY_IS_EQUAL(n, 3);
+
+  // products with the provided sizes
+  MatrixType a = MatrixType::Random(200, 150), b = MatrixType::Random(150, 180), c(200, 180);
+  RowMatrixType br = b;
+  c.noalias() = a * b;
+  setGemmBlockingProvider(0);
+  MatrixType ref = a * b;
+  VERIFY_IS_APPROX(c, ref);
+  setGemmBlockingProvider(&table);
+  c.noalias() = a * br;
+  VERIFY_IS_APPROX(c, ref);
+
+  // tuning
+  table.clear();
+  table.setMaxTuningSize(96);
+  table.setRepetitions(1);
+  GemmBlockingTable::Sizes tuned = table.template tune<Scalar>(200, 150, 180, 1);
+  VERIFY(tuned.kc>=1 && tuned.kc<=96);
+  VERIFY(tuned.mc>=1 && tuned.mc<=96);
+  VERIFY(tuned.nc>=1 && tuned.nc<=96);
+  VERIFY_IS_EQUAL(table.size(), 1);
+  VERIFY(gemmBlockingProvider()==&table);
+  GemmBlockingTable::Sizes found;
+  VERIFY(table.find(type, type, 1, 200, 150, 180, found));
+  VERIFY_IS_EQUAL(found.kc, tuned.kc);
+  c.noalias() = a * b;
+  VERIFY_IS_APPROX(c, ref);
+
+  // tuning on first use
+  table.setTuneOnFirstUse(true);
+  MatrixType e = MatrixType::Random(300, 100), f = MatrixType::Random(100, 90), g(300, 90);
+  g.noalias() = e * f;
+  VERIFY_IS_EQUAL(table.size(), 2);
+  VERIFY(table.find(type, type, 1, 300, 100, 90, found));
+  setGemmBlockingProvider(0);
+  VERIFY_IS_APPROX(g, (e * f).eval());
+}
+
+EIGEN_DECLARE_TEST(blocking_tuner)
+{
+  CALL_SUBTEST_1( blocking_table_io() );
+  CALL_SUBTEST_2( blocking_table_provider<float>() );
+  CALL_SUBTEST_3( blocking_table_provider<double>() );
+  CALL_SUBTEST_4( blocking_table_provider<std::complex<float> >() );
+  CALL_SUBTEST_5( blocking_table_provider<std::complex<double> >() );
+}
@@ -0,0 +1,86 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <unsupported/Eigen/CpuDispatch>
+#include <cstring>
+#include <typeinfo>
+
+// defined in cpu_dispatch_variant.cpp
+void EIGEN_CPU_DISPATCH_NAME(cpu_dispatch_product)(const float* A, const float* B, float* C, int m, int k, int n);
+int EIGEN_CPU_DISPATCH_NAME(cpu_dispatch_compiled_features)();
+const char* EIGEN_CPU_DISPATCH_NAME(cpu_dispatch_matrix_type)();
+
+int variant_generic() { return 0; }
+int variant_sse4()    { return 1; }
+int variant_avx2()    { return 2; }
+int variant_avx512()  { return 3; }
+
+void cpu_dispatch_features()
+{
+  int features = supportedCpuFeatures();
+  // the test is run on the host it has been compiled for
+  VERIFY_IS_EQUAL(features & int(CpuFeatures::Compiled), int(CpuFeatures::Compiled));
+  VERIFY_IS_EQUAL(supportedCpuFeatures(), features);
+#if EIGEN_ARCH_x86_64
+  VERIFY(features & CpuFeatures::SSE2);
+#endif
+  // the instruction sets of a generation imply the previous ones
+  if(features & CpuFeatures::AVX2)    VERIFY(features & CpuFeatures::AVX);
+  if(features & CpuFeatures::AVX)     VERIFY(features & CpuFeatures::SSE4_2);
+  if(features & CpuFeatures::AVX512F) VERIFY(features & CpuFeatures::AVX2);
+}
+
+void cpu_dispatch_select()
+{
+  typedef int (*Func)();
+  CpuDispatcher<Func> dispatcher(variant_generic);
+  VERIFY_IS_EQUAL(dispatcher.select()(), 0);
+
+  // the registration order does not matter
+  dispatcher.add(CpuFeatures::AVX512F, variant_avx512)
+            .add(CpuFeatures::SSE4_2, variant_sse4)
+            .add(CpuFeatures::AVX2|CpuFeatures::FMA, variant_avx2);
+
+  VERIFY_IS_EQUAL(dispatcher.select(0)(), 0);
+  VERIFY_IS_EQUAL(dispatcher.select(CpuFeatures::SSE2|CpuFeatures::SSE3)(), 0);
+  VERIFY_IS_EQUAL(dispatcher.select(CpuFeatures::SSE2|CpuFeatures::SSE4_1|CpuFeatures::SSE4_2)(), 1);
+  VERIFY_IS_EQUAL(dispatcher.select(CpuFeatures::SSE4_2|CpuFeatures::AVX|CpuFeatures::AVX2)(), 1);
+  VERIFY_IS_EQUAL(dispatcher.select(CpuFeatures::SSE4_2|CpuFeatures::AVX|CpuFeatures::AVX2|CpuFeatures::FMA)(), 2);
+  VERIFY_IS_EQUAL(dispatcher.select(CpuFeatures::SSE4_2|CpuFeatures::AVX2|CpuFeatures::FMA|CpuFeatures::AVX512F)(), 3);
+
+  int expected = 0;
+  int features = supportedCpuFeatures();
+  if(features & CpuFeatures::SSE4_2) expected = 1;
+  if((features & CpuFeatures::AVX2) && (features & CpuFeatures::FMA)) expected = 2;
+  if(features & CpuFeatures::AVX512F) expected = 3;
+  VERIFY_IS_EQUAL(dispatcher.select()(), expected);
+}
+
+void cpu_dispatch_variant()
+{
+  // the variant lives in its own copy of Eigen, whose instantiations do not clash with the ones of this file
+  VERIFY(std::strcmp(EIGEN_CPU_DISPATCH_NAME(cpu_dispatch_matrix_type)(), typeid(MatrixXf).name()) != 0);
+  VERIFY_IS_EQUAL(EIGEN_CPU_DISPATCH_NAME(cpu_dispatch_compiled_features)(), int(CpuFeatures::Compiled));
+
+  typedef void (*Func)(const float*, const float*, float*, int, int, int);
+  Func product = CpuDispatcher<Func>(EIGEN_CPU_DISPATCH_NAME(cpu_dispatch_product)).select();
+
+  int m = internal::random<int>(1,200), k = internal::random<int>(1,200), n = internal::random<int>(1,200);
+  MatrixXf A = MatrixXf::Random(m,k), B = MatrixXf::Random(k,n), C(m,n);
+  product(A.data(), B.data(), C.data(), m, k, n);
+  VERIFY_IS_APPROX(C, A*B);
+}
+
+EIGEN_DECLARE_TEST(cpu_dispatch)
+{
+  CALL_SUBTEST( cpu_dispatch_features() );
+  CALL_SUBTEST( cpu_dispatch_select() );
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST( cpu_dispatch_variant() );
+  }
+}
@@ -0,0 +1,28 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Variant of the kernels of the cpu_dispatch test, compiled with EIGEN_CPU_DISPATCH_VARIANT,
+// and linked with cpu_dispatch.cpp which instantiates the same products within Eigen.
+
+#include <unsupported/Eigen/CpuDispatch>
+#include <typeinfo>
+
+void EIGEN_CPU_DISPATCH_NAME(cpu_dispatch_product)(const float* A, const float* B, float* C, int m, int k, int n)
+{
+  using namespace Eigen;
+  MatrixXf::Map(C,m,n).noalias() = MatrixXf::Map(A,m,k) * MatrixXf::Map(B,k,n);
+}
+
+int EIGEN_CPU_DISPATCH_NAME(cpu_dispatch_compiled_features)()
+{
+  return Eigen::CpuFeatures::Compiled;
+}
+
+const char* EIGEN_CPU_DISPATCH_NAME(cpu_dispatch_matrix_type)()
+{
+  return typeid(Eigen::MatrixXf).name();
+}
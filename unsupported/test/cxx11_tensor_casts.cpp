@@ -104,6 +104,23 @@ static void test_small_to_big_type_cast()
   }
 }
 
+static void test_bfloat16_cast()
+{
+  Tensor<float, 2> ftensor(20, 30);
+  ftensor.setRandom();
+  Tensor<bfloat16, 2> btensor(20, 30);
+  btensor = ftensor.cast<bfloat16>();
+  Tensor<float, 2> rtensor(20, 30);
+  rtensor = btensor.cast<float>();
+
+  for (int i = 0; i < 20; ++i) {
+    for (int j = 0; j < 30; ++j) {
+      VERIFY_IS_EQUAL(btensor(i,j).value, bfloat16(ftensor(i,j)).value);
+      VERIFY_IS_EQUAL(rtensor(i,j), static_cast<float>(bfloat16(ftensor(i,j))));
+    }
+  }
+}
+
 
 EIGEN_DECLARE_TEST(cxx11_tensor_casts)
 {
@@ -112,4 +129,5 @@ EIGEN_DECLARE_TEST(cxx11_tensor_casts)
    CALL_SUBTEST(test_float_to_int_cast());
    CALL_SUBTEST(test_big_to_small_type_cast());
    CALL_SUBTEST(test_small_to_big_type_cast());
+   CALL_SUBTEST(test_bfloat16_cast());
 }
@@ -559,6 +559,40 @@ static void test_large_contraction_with_output_kernel() {
     VERIFY_IS_APPROX(t_result.data()[i], std::sqrt(m_result.data()[i]));
   }
 }
+template<int DataLayout>
+static void test_bfloat16_contraction()
+{
+  Tensor<bfloat16, 2, DataLayout> t_left(30, 40);
+  Tensor<bfloat16, 2, DataLayout> t_right(40, 20);
+  Tensor<bfloat16, 2, DataLayout> t_result(30, 20);
+  t_left.setRandom();
+  t_right.setRandom();
+
+  Tensor<float, 2, DataLayout> f_left = t_left.template cast<float>();
+  Tensor<float, 2, DataLayout> f_right = t_right.template cast<float>();
+
+  Eigen::array<DimPair, 1> dims = {{DimPair(1, 0)}};
+  t_result = t_left.contract(t_right, dims);
+  Tensor<float, 2, DataLayout> f_result = f_left.contract(f_right, dims);
+
+  for (int i = 0; i < 30; ++i) {
+    for (int j = 0; j < 20; ++j) {
+      VERIFY_IS_EQUAL(t_result(i,j).value, bfloat16(f_result(i,j)).value);
+    }
+  }
+
+  // Summing 512 ones stays exact only if the products are accumulated in fp32.
+  Tensor<bfloat16, 2, DataLayout> ones_left(4, 512);
+  Tensor<bfloat16, 2, DataLayout> ones_right(512, 3);
+  ones_left.setConstant(bfloat16(1.f));
+  ones_right.setConstant(bfloat16(1.f));
+  Tensor<bfloat16, 2, DataLayout> sums = ones_left.contract(ones_right, dims);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      VERIFY_IS_EQUAL(static_cast<float>(sums(i,j)), 512.f);
+    }
+  }
+}
 
 EIGEN_DECLARE_TEST(cxx11_tensor_contraction)
 {
@@ -594,4 +628,6 @@ EIGEN_DECLARE_TEST(cxx11_tensor_contraction)
   CALL_SUBTEST(test_const_inputs<RowMajor>());
   CALL_SUBTEST(test_large_contraction_with_output_kernel<ColMajor>());
   CALL_SUBTEST(test_large_contraction_with_output_kernel<RowMajor>());
+  CALL_SUBTEST(test_bfloat16_contraction<ColMajor>());
+  CALL_SUBTEST(test_bfloat16_contraction<RowMajor>());
 }
@@ -0,0 +1,294 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_USE_THREADS
+#include "main.h"
+#include "Eigen/CXX11/ThreadPool"
+#include <Eigen/LU>
+#include <Eigen/SparseLU>
+
+// Forwards to a ThreadPoolGemmExecutor while counting the parallel regions.
+class CountingGemmExecutor : public ThreadPoolGemmExecutor {
+ public:
+  explicit CountingGemmExecutor(ThreadPoolInterface* pool)
+      : ThreadPoolGemmExecutor(pool), count(0) {}
+
+  virtual void run(int n, const Task& task) {
+    ++count;
+    ThreadPoolGemmExecutor::run(n, task);
+  }
+
+  std::atomic<int> count;
+};
+
+template <typename MatrixType>
+static void test_products(CountingGemmExecutor& executor, Index rows, Index cols, Index depth)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, Dynamic> ColMatrix;
+  typedef Matrix<Scalar, Dynamic, Dynamic, RowMajor> RowMatrix;
+
+  MatrixType a = MatrixType::Random(rows, depth);
+  MatrixType b = MatrixType::Random(depth, cols);
+  MatrixType sq = MatrixType::Random(depth, depth);
+  MatrixType sl = MatrixType::Random(rows, rows);
+  MatrixType sr = MatrixType::Random(cols, cols);
+
+  // reference results computed sequentially
+  setGemmExecutor(0);
+  ColMatrix gemm_ref = a * b;
+  ColMatrix trmm_lhs_ref = sq.template triangularView<Upper>() * b;
+  ColMatrix trmm_rhs_ref = a * sq.template triangularView<UnitLower>();
+  ColMatrix symm_lhs_ref = sl.template selfadjointView<Lower>() * a;
+  ColMatrix symm_rhs_ref = b * sr.template selfadjointView<Upper>();
+
+  setGemmExecutor(&executor);
+  executor.count = 0;
+
+  ColMatrix c = a * b;
+  VERIFY_IS_APPROX(c, gemm_ref);
+  RowMatrix r = a * b;
+  VERIFY_IS_APPROX(r, gemm_ref);
+  VERIFY(executor.count >= 2);
+
+  executor.count = 0;
+  c.noalias() = sq.template triangularView<Upper>() * b;
+  VERIFY_IS_APPROX(c, trmm_lhs_ref);
+  r.noalias() = a * sq.template triangularView<UnitLower>();
+  VERIFY_IS_APPROX(r, trmm_rhs_ref);
+  VERIFY(executor.count >= 2);
+
+  executor.count = 0;
+  c.noalias() = sl.template selfadjointView<Lower>() * a;
+  VERIFY_IS_APPROX(c, symm_lhs_ref);
+  r.noalias() = b * sr.template selfadjointView<Upper>();
+  VERIFY_IS_APPROX(r, symm_rhs_ref);
+  VERIFY(executor.count >= 2);
+
+  setGemmExecutor(0);
+}
+
+template <typename MatrixType>
+static void test_matrix_vector_products(CountingGemmExecutor& executor, Index rows, Index cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, 1> VectorType;
+  typedef Matrix<Scalar, Dynamic, Dynamic, RowMajor> RowMatrix;
+
+  MatrixType a = MatrixType::Random(rows, cols);
+  RowMatrix ar = a;
+  MatrixType s = MatrixType::Random(rows, rows);
+  RowMatrix sr = s;
+  VectorType x = VectorType::Random(cols), y = VectorType::Random(rows);
+
+  setGemmExecutor(0);
+  VectorType gemv_ref = a * x;
+  VectorType gemv_adj_ref = a.adjoint() * y;
+  VectorType symv_lower_ref = s.template selfadjointView<Lower>() * y;
+  VectorType symv_upper_ref = s.template selfadjointView<Upper>() * y;
+  VectorType symv_adj_ref = s.adjoint().template selfadjointView<Upper>() * y;
+  VectorType symv_row_ref = sr.template selfadjointView<Lower>() * y;
+
+  setGemmExecutor(&executor);
+  executor.count = 0;
+  VectorType r;
+  r.noalias() = a * x;
+  VERIFY_IS_APPROX(r, gemv_ref);
+  r.noalias() = ar * x;
+  VERIFY_IS_APPROX(r, gemv_ref);
+  r.noalias() = a.adjoint() * y;
+  VERIFY_IS_APPROX(r, gemv_adj_ref);
+  VERIFY(executor.count >= 3);
+
+  executor.count = 0;
+  r.noalias() = s.template selfadjointView<Lower>() * y;
+  VERIFY_IS_APPROX(r, symv_lower_ref);
+  r.noalias() = s.template selfadjointView<Upper>() * y;
+  VERIFY_IS_APPROX(r, symv_upper_ref);
+  r.noalias() = s.adjoint().template selfadjointView<Upper>() * y;
+  VERIFY_IS_APPROX(r, symv_adj_ref);
+  r.noalias() = sr.template selfadjointView<Lower>() * y;
+  VERIFY_IS_APPROX(r, symv_row_ref);
+  VERIFY(executor.count >= 4);
+
+  setGemmExecutor(0);
+}
+
+static void test_nested_product(ThreadPool& pool, CountingGemmExecutor& executor)
+{
+  // products evaluated within the pool must not be parallelized on the same pool
+  MatrixXf a = MatrixXf::Random(200, 200), b = MatrixXf::Random(200, 200);
+  MatrixXf ref = a * b;
+  MatrixXf c;
+  setGemmExecutor(&executor);
+  executor.count = 0;
+  Barrier barrier(1);
+  pool.Schedule([&]() {
+    c = a * b;
+    barrier.Notify();
+  });
+  barrier.Wait();
+  VERIFY_IS_APPROX(c, ref);
+  VERIFY_IS_EQUAL(executor.count.load(), 0);
+  setGemmExecutor(0);
+}
+
+template <typename MatrixType>
+static void test_partial_piv_lu(CountingGemmExecutor& executor, Index size)
+{
+  MatrixType m = MatrixType::Random(size, size);
+  MatrixType rhs = MatrixType::Random(size, 2);
+
+  setGemmExecutor(0);
+  PartialPivLU<MatrixType> ref(m);
+
+  // the panels are factored while the trailing matrix is updated on the pool
+  setGemmExecutor(&executor);
+  executor.count = 0;
+  PartialPivLU<MatrixType> lu(m);
+  VERIFY(executor.count >= 1);
+  VERIFY_IS_APPROX(lu.reconstructedMatrix(), m);
+  VERIFY_IS_APPROX(lu.solve(rhs), ref.solve(rhs));
+  VERIFY_IS_APPROX(lu.matrixLU(), ref.matrixLU());
+  setGemmExecutor(0);
+}
+
+template <typename Scalar>
+static void test_sparse_lu(CountingGemmExecutor& executor, Index size)
+{
+  typedef SparseMatrix<Scalar> SparseMatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  std::vector<Triplet<Scalar> > triplets;
+  for(Index j = 0; j < size; ++j)
+  {
+    triplets.push_back(Triplet<Scalar>(j, j, Scalar(10)));
+    for(int k = 0; k < 8; ++k)
+      triplets.push_back(Triplet<Scalar>(internal::random<Index>(0,size-1), j, internal::random<Scalar>()));
+  }
+  SparseMatrixType m(size, size);
+  m.setFromTriplets(triplets.begin(), triplets.end());
+  DenseMatrix rhs = DenseMatrix::Random(size, 2);
+
+  setGemmExecutor(0);
+  SparseLU<SparseMatrixType> ref(m);
+  DenseMatrix refx = ref.solve(rhs);
+
+  // the supernode-panel updates are only split among the threads on request
+  setGemmExecutor(&executor);
+  executor.count = 0;
+  SparseLU<SparseMatrixType> seq(m);
+  VERIFY_IS_EQUAL(executor.count.load(), 0);
+
+  // which yields the same factors
+  SparseLU<SparseMatrixType> lu;
+  lu.setParallelUpdates(true);
+  lu.compute(m);
+  VERIFY(executor.count >= 1);
+  setGemmExecutor(0);
+  VERIFY_IS_EQUAL(lu.info(), Success);
+  DenseMatrix x = lu.solve(rhs);
+  VERIFY((x.array() == refx.array()).all());
+  VERIFY_IS_APPROX(m*x, rhs);
+}
+
+template <typename SparseMatrixType>
+static void test_sparse_product(CountingGemmExecutor& executor, Index size)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  std::vector<Triplet<Scalar> > triplets;
+  for(Index j = 0; j < size; ++j)
+    for(int k = 0; k < 10; ++k)
+      triplets.push_back(Triplet<Scalar>(internal::random<Index>(0,size-1), j, internal::random<Scalar>()));
+  SparseMatrix<Scalar> a(size, size);
+  a.setFromTriplets(triplets.begin(), triplets.end());
+  SparseMatrix<Scalar,RowMajor> b = a.transpose();
+
+  setGemmExecutor(0);
+  SparseMatrixType ata_ref = a.transpose() * a;
+  SparseMatrixType ab_ref = a * b;
+
+  // the symbolic and numeric passes are split among the threads
+  setGemmExecutor(&executor);
+  executor.count = 0;
+  SparseMatrixType ata = a.transpose() * a;
+  SparseMatrixType ab = a * b;
+  VERIFY(executor.count >= 4);
+  VERIFY_IS_EQUAL(ata.nonZeros(), ata_ref.nonZeros());
+  VERIFY_IS_APPROX(ata, ata_ref);
+  VERIFY_IS_APPROX(ab, ab_ref);
+
+  executor.count = 0;
+  SparseProductPlan<SparseMatrixType> plan(a.transpose(), a);
+  SparseMatrixType res;
+  plan.evaluate(a.transpose(), a, res);
+  VERIFY(executor.count >= 3);
+  VERIFY_IS_APPROX(res, ata_ref);
+  a.coeffs() *= Scalar(2);
+  plan.evaluate(a.transpose(), a, res);
+  VERIFY_IS_APPROX(res, Scalar(4) * ata_ref);
+  setGemmExecutor(0);
+}
+
+static void test_bfloat16_product(CountingGemmExecutor& executor, Index rows, Index cols, Index depth)
+{
+  typedef Matrix<bfloat16,Dynamic,Dynamic> MatrixXbf;
+  MatrixXbf a = MatrixXbf::Random(rows, depth);
+  MatrixXbf b = MatrixXbf::Random(depth, cols);
+  MatrixXbf c = MatrixXbf::Random(rows, cols);
+  MatrixXf ref = c.cast<float>() + a.cast<float>() * b.cast<float>();
+
+  // the threads share the lhs packed in fp32
+  setGemmExecutor(&executor);
+  executor.count = 0;
+  c.noalias() += a * b;
+  VERIFY(executor.count >= 1);
+  setGemmExecutor(0);
+  VERIFY_IS_APPROX(c, MatrixXbf(ref.cast<bfloat16>()));
+}
+
+EIGEN_DECLARE_TEST(cxx11_thread_pool_gemm)
+{
+  ThreadPool pool(3);
+  CountingGemmExecutor executor(&pool);
+  setGemmExecutor(&executor);
+  VERIFY_IS_EQUAL(nbThreads(), 4);
+  setNbThreads(16);
+  // capped by the number of threads of the executor
+  VERIFY_IS_EQUAL(nbThreads(), 4);
+  setNbThreads(0);
+  setGemmExecutor(0);
+
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( test_products<MatrixXf>(executor, internal::random<int>(100,300), internal::random<int>(100,300), internal::random<int>(100,300)) ));
+    CALL_SUBTEST_2(( test_products<MatrixXd>(executor, internal::random<int>(100,300), internal::random<int>(100,300), internal::random<int>(100,300)) ));
+    CALL_SUBTEST_3(( test_products<MatrixXcf>(executor, internal::random<int>(100,200), internal::random<int>(100,200), internal::random<int>(100,200)) ));
+  }
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_4(( test_matrix_vector_products<MatrixXf>(executor, internal::random<int>(500,1000), internal::random<int>(500,1000)) ));
+    CALL_SUBTEST_5(( test_matrix_vector_products<MatrixXd>(executor, internal::random<int>(500,1000), internal::random<int>(500,1000)) ));
+    CALL_SUBTEST_6(( test_matrix_vector_products<MatrixXcd>(executor, internal::random<int>(500,1000), internal::random<int>(500,1000)) ));
+  }
+  CALL_SUBTEST_7( test_nested_product(pool, executor) );
+  // the calling thread runs its share of the look-ahead tasks, even with a single thread in the pool
+  ThreadPool small_pool(1);
+  CountingGemmExecutor small_executor(&small_pool);
+  setGemmExecutor(&small_executor);
+  VERIFY_IS_EQUAL(internal::parallel_tasks_threads(), 2);
+  setGemmExecutor(0);
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_8(( test_partial_piv_lu<MatrixXd>(executor, internal::random<int>(300,600)) ));
+    CALL_SUBTEST_8(( test_partial_piv_lu<Matrix<float,Dynamic,Dynamic,RowMajor> >(executor, internal::random<int>(300,600)) ));
+    CALL_SUBTEST_8(( test_partial_piv_lu<MatrixXd>(small_executor, internal::random<int>(300,600)) ));
+  }
+  CALL_SUBTEST_9(( test_sparse_lu<double>(executor, internal::random<int>(2200,2600)) ));
+  CALL_SUBTEST_9(( test_sparse_lu<std::complex<float> >(executor, internal::random<int>(2200,2600)) ));
+  CALL_SUBTEST_10(( test_sparse_product<SparseMatrix<double> >(executor, internal::random<int>(3000,4000)) ));
+  CALL_SUBTEST_10(( test_sparse_product<SparseMatrix<std::complex<float>,RowMajor> >(executor, internal::random<int>(3000,4000)) ));
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_11(( test_bfloat16_product(executor, internal::random<int>(200,400), internal::random<int>(200,400), internal::random<int>(300,1000)) ));
+  }
+}
@@ -0,0 +1,112 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <unsupported/Eigen/MixedPrecision>
+
+template<typename MatrixType>
+void mixed_precision_lu(Index size)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> RhsType;
+
+  // a well conditioned matrix
+  MatrixType a = MatrixType::Random(size, size);
+  a.diagonal().array() += Scalar(RealScalar(2*size));
+  RhsType b = RhsType::Random(size, 3);
+
+  MixedPrecisionSolver<PartialPivLU<MatrixType> > solver(a);
+  VERIFY_IS_EQUAL(solver.rows(), size);
+  RhsType x = solver.solve(b);
+  VERIFY_IS_EQUAL(solver.info(), Success);
+  VERIFY(!solver.usesFullPrecision());
+  VERIFY(solver.error() <= solver.tolerance());
+  VERIFY(solver.iterations() <= 5);
+  VERIFY_IS_APPROX(a * x, b);
+  // as accurate as the full precision solver
+  RhsType ref = a.partialPivLu().solve(b);
+  VERIFY_IS_APPROX(x, ref);
+
+  // vector right hand sides
+  Matrix<Scalar,Dynamic,1> v = b.col(0);
+  Matrix<Scalar,Dynamic,1> y = solver.solve(v);
+  VERIFY_IS_APPROX(y, x.col(0));
+
+  // without refinement iterations, the solution has the lower precision only and the solver falls back
+  solver.setMaxIterations(0);
+  x = solver.solve(b);
+  VERIFY_IS_EQUAL(solver.info(), Success);
+  VERIFY(solver.usesFullPrecision());
+  VERIFY_IS_EQUAL(solver.iterations(), 0);
+  VERIFY_IS_APPROX(x, ref);
+  // and keeps using the full precision decomposition
+  x = solver.setMaxIterations(30).solve(b);
+  VERIFY(solver.usesFullPrecision());
+  VERIFY_IS_APPROX(x, ref);
+
+  // recomputing restarts in lower precision
+  solver.compute(a);
+  VERIFY(!solver.usesFullPrecision());
+
+  // an ill conditioned matrix stalls the refinement
+  MatrixType q = MatrixType(a.householderQr().householderQ());
+  Matrix<RealScalar,Dynamic,1> s = Matrix<RealScalar,Dynamic,1>::LinSpaced(size, RealScalar(0), RealScalar(-12));
+  MatrixType c = q * (s.array() * RealScalar(std::log(10.0))).exp().matrix().asDiagonal() * q.adjoint();
+  solver.compute(c);
+  x = solver.solve(b);
+  VERIFY_IS_EQUAL(solver.info(), Success);
+  if(size>4)
+    VERIFY(solver.usesFullPrecision());
+  // the solution is backward stable
+  VERIFY(solver.error() <= RealScalar(100) * solver.tolerance());
+}
+
+template<typename MatrixType>
+void mixed_precision_llt(Index size)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> RhsType;
+
+  MatrixType m = MatrixType::Random(size, size);
+  MatrixType a = m.adjoint() * m;
+  a.diagonal().array() += Scalar(RealScalar(size));
+  RhsType b = RhsType::Random(size, 2);
+
+  // only the referenced triangle is used
+  MatrixType lower = a.template triangularView<Lower>();
+  MixedPrecisionSolver<LLT<MatrixType,Lower> > solver(lower);
+  RhsType x = solver.solve(b);
+  VERIFY_IS_EQUAL(solver.info(), Success);
+  VERIFY(!solver.usesFullPrecision());
+  VERIFY_IS_APPROX(a * x, b);
+
+  MatrixType upper = a.template triangularView<Upper>();
+  MixedPrecisionSolver<LLT<MatrixType,Upper> > usolver(upper);
+  x = usolver.solve(b);
+  VERIFY_IS_EQUAL(usolver.info(), Success);
+  VERIFY_IS_APPROX(a * x, b);
+
+  // not positive definite
+  MatrixType c = -a;
+  solver.compute(c);
+  VERIFY(solver.usesFullPrecision());
+  VERIFY_IS_EQUAL(solver.info(), NumericalIssue);
+}
+
+EIGEN_DECLARE_TEST(mixed_precision)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( mixed_precision_lu<MatrixXd>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE)) ));
+    CALL_SUBTEST_2(( mixed_precision_lu<MatrixXcd>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE)) ));
+    CALL_SUBTEST_3(( mixed_precision_lu<Matrix4d>(4) ));
+    CALL_SUBTEST_4(( mixed_precision_llt<MatrixXd>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE)) ));
+    CALL_SUBTEST_5(( mixed_precision_llt<MatrixXcd>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE)) ));
+  }
+  CALL_SUBTEST_1(( mixed_precision_lu<MatrixXd>(300) ));
+}
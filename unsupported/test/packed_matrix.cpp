@@ -0,0 +1,95 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <unsupported/Eigen/PackedMatrix>
+
+template<typename Scalar>
+void packed_matrix_product(Index rows, Index depth, Index cols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMatrixType;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+  MatrixType w = MatrixType::Random(rows, depth);
+  MatrixType x = MatrixType::Random(depth, cols);
+  RowMatrixType xr = RowMatrixType::Random(depth, cols);
+  MatrixType y = MatrixType::Random(rows, cols), ref = y;
+  RowMatrixType yr(rows, cols);
+  VectorType v = VectorType::Random(depth), u(rows);
+  Scalar s = internal::random<Scalar>();
+
+  PackedMatrix<Scalar> pw(w, cols);
+  VERIFY_IS_EQUAL(pw.rows(), rows);
+  VERIFY_IS_EQUAL(pw.cols(), depth);
+
+  y.noalias() = pw * x;
+  VERIFY_IS_APPROX(y, w * x);
+  y = pw * xr;
+  VERIFY_IS_APPROX(y, w * xr);
+
+  ref = y;
+  y.noalias() += pw * (s * x);
+  VERIFY_IS_APPROX(y, ref + s * (w * x));
+  y.noalias() -= pw * x.conjugate();
+  VERIFY_IS_APPROX(y, ref + s * (w * x) - w * x.conjugate());
+
+  yr.noalias() = pw * xr;
+  VERIFY_IS_APPROX(yr, w * xr);
+  y.noalias() = pw * (x + xr);
+  VERIFY_IS_APPROX(y, w * (x + xr));
+  y.noalias() = pw * xr.adjoint().adjoint();
+  VERIFY_IS_APPROX(y, w * xr);
+
+  u.noalias() = pw * v;
+  VERIFY_IS_APPROX(u, w * v);
+  u.noalias() = pw * xr.col(0);
+  VERIFY_IS_APPROX(u, w * xr.col(0));
+  y.col(0).noalias() = pw * x.col(0);
+  VERIFY_IS_APPROX(y.col(0), w * x.col(0));
+  yr.col(0).noalias() = pw * x.col(0);
+  VERIFY_IS_APPROX(yr.col(0), w * x.col(0));
+
+  // the same packed matrix is reused for right hand sides with a different number of columns
+  MatrixType x2 = MatrixType::Random(depth, internal::random<Index>(1,2*cols+1));
+  VERIFY_IS_APPROX((pw * x2).eval(), w * x2);
+
+  // the packed matrix can be rebuilt from a block of a row-major matrix
+  RowMatrixType wr = RowMatrixType::Random(rows+2, depth);
+  pw.compute(wr.bottomRows(rows));
+  y.noalias() = pw * x;
+  VERIFY_IS_APPROX(y, wr.bottomRows(rows) * x);
+}
+
+template<typename Scalar>
+void packed_matrix_blocking(Index rows, Index depth, Index cols, Index colsHint)
+{
+  // the blocking sizes are reduced by EIGEN_DEBUG_SMALL_PRODUCT_BLOCKS
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  MatrixType w = MatrixType::Random(rows, depth);
+  MatrixType x = MatrixType::Random(depth, cols);
+  PackedMatrix<Scalar> pw(w, colsHint);
+  VERIFY(pw.kc()<depth || pw.mc()<rows || pw.nc()<cols);
+
+  MatrixType y = pw * x;
+  VERIFY_IS_APPROX(y, w * x);
+}
+
+EIGEN_DECLARE_TEST(packed_matrix)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( packed_matrix_product<float>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,16)) ));
+    CALL_SUBTEST_1(( packed_matrix_product<float>(internal::random<Index>(1,8),internal::random<Index>(1,8),internal::random<Index>(1,8)) ));
+    CALL_SUBTEST_2(( packed_matrix_product<double>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,EIGEN_TEST_MAX_SIZE)) ));
+    CALL_SUBTEST_3(( packed_matrix_product<std::complex<float> >(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,16)) ));
+    CALL_SUBTEST_4(( packed_matrix_product<std::complex<double> >(internal::random<Index>(1,50),internal::random<Index>(1,50),internal::random<Index>(1,50)) ));
+    // blocking along the depth, the rows, and the columns respectively
+    CALL_SUBTEST_5(( packed_matrix_blocking<float>(internal::random<Index>(20,60),internal::random<Index>(300,400),internal::random<Index>(1,16),-1) ));
+    CALL_SUBTEST_5(( packed_matrix_blocking<double>(internal::random<Index>(150,250),internal::random<Index>(20,40),internal::random<Index>(1,16),16) ));
+    CALL_SUBTEST_5(( packed_matrix_blocking<double>(internal::random<Index>(50,100),internal::random<Index>(20,40),internal::random<Index>(30,50),8) ));
+  }
+}
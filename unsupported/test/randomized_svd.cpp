@@ -0,0 +1,112 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse.h"
+#include <unsupported/Eigen/RandomizedSVD>
+
+template<typename MatrixType, typename DenseType>
+void check_low_rank_svd(const MatrixType& a, const DenseType& dense, Index rank)
+{
+  typedef typename DenseType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<RealScalar,Dynamic,1> RealVectorType;
+
+  JacobiSVD<DenseType> ref(dense);
+  Index k = internal::random<Index>(1, rank);
+
+  // the rank of the matrix is less than the number of samples: the decomposition is exact
+  RandomizedSVD<MatrixType> svd(a, k);
+  VERIFY_IS_EQUAL(svd.rows(), dense.rows());
+  VERIFY_IS_EQUAL(svd.cols(), dense.cols());
+  VERIFY_IS_EQUAL(svd.singularValues().size(), k);
+  VERIFY_IS_APPROX(svd.singularValues(), RealVectorType(ref.singularValues().head(k)));
+  VERIFY_IS_UNITARY(svd.matrixU());
+  VERIFY_IS_UNITARY(svd.matrixV());
+  VERIFY_IS_APPROX(DenseType(dense.adjoint() * svd.matrixU()), DenseType(svd.matrixV() * svd.singularValues().asDiagonal()));
+  VERIFY_IS_APPROX(DenseType(dense * svd.matrixV()), DenseType(svd.matrixU() * svd.singularValues().asDiagonal()));
+
+  // all the triplets
+  svd.setOversampling(0).compute(a, rank);
+  VERIFY_IS_APPROX(DenseType(svd.matrixU() * svd.singularValues().asDiagonal() * svd.matrixV().adjoint()), dense);
+
+  // singular values only
+  svd.setPowerIterations(0).compute(a, rank, 0);
+  VERIFY(!svd.computeU() && !svd.computeV());
+  VERIFY_IS_APPROX(svd.singularValues(), RealVectorType(ref.singularValues().head(rank)));
+  VERIFY_RAISES_ASSERT(svd.matrixU());
+  VERIFY_RAISES_ASSERT(svd.matrixV());
+}
+
+template<typename DenseType>
+void randomized_svd_dense(Index rows, Index cols)
+{
+  typedef typename DenseType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<RealScalar,Dynamic,1> RealVectorType;
+
+  Index diagSize = numext::mini(rows, cols);
+  Index rank = internal::random<Index>(1, numext::mini(diagSize, Index(10)));
+  DenseType a = DenseType::Random(rows, rank) * DenseType::Random(rank, cols);
+  check_low_rank_svd(a, a, rank);
+
+  // through a map
+  Map<const DenseType> map(a.data(), rows, cols);
+  check_low_rank_svd(map, a, rank);
+
+  // a full rank matrix with quickly decaying singular values: the largest ones are accurate
+  DenseType u = DenseType::Random(rows, diagSize).householderQr().householderQ() * DenseType::Identity(rows, diagSize);
+  DenseType v = DenseType::Random(cols, diagSize).householderQr().householderQ() * DenseType::Identity(cols, diagSize);
+  RealVectorType s(diagSize);
+  for(Index i = 0; i < diagSize; ++i)
+    s(i) = std::pow(RealScalar(0.5), RealScalar(i));
+  DenseType b = u * s.asDiagonal() * v.adjoint();
+  Index k = numext::mini(diagSize, Index(5));
+  RandomizedSVD<DenseType> svd(b, k);
+  VERIFY_IS_APPROX(svd.singularValues(), RealVectorType(s.head(k)));
+  VERIFY_IS_APPROX(DenseType(svd.matrixU() * svd.singularValues().asDiagonal() * svd.matrixV().adjoint()),
+                   DenseType(u.leftCols(k) * s.head(k).asDiagonal() * v.leftCols(k).adjoint()));
+
+  VERIFY_RAISES_ASSERT(svd.compute(a, diagSize+1));
+  VERIFY_RAISES_ASSERT(svd.compute(a, k, ComputeFullU));
+}
+
+template<typename Scalar>
+void randomized_svd_sparse(Index rows, Index cols)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseType;
+  typedef SparseMatrix<Scalar> SparseType;
+
+  // a sum of a few sparse rank one matrices
+  Index rank = internal::random<Index>(1, numext::mini(numext::mini(rows, cols), Index(10)));
+  SparseType a(rows, cols);
+  for(Index r = 0; r < rank; ++r)
+  {
+    SparseType x(rows, 1), y(cols, 1);
+    for(Index i = 0; i < rows; ++i)
+      if(internal::random<int>(0, 4) == 0 || i == r)
+        x.insert(i, 0) = internal::random<Scalar>();
+    for(Index i = 0; i < cols; ++i)
+      if(internal::random<int>(0, 4) == 0 || i == r)
+        y.insert(i, 0) = internal::random<Scalar>();
+    a += SparseType(x * y.adjoint());
+  }
+  DenseType dense = a;
+  check_low_rank_svd(a, dense, rank);
+}
+
+EIGEN_DECLARE_TEST(randomized_svd)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    Index rows = internal::random<Index>(1, EIGEN_TEST_MAX_SIZE);
+    Index cols = internal::random<Index>(1, EIGEN_TEST_MAX_SIZE);
+    CALL_SUBTEST_1(( randomized_svd_dense<MatrixXd>(rows, cols) ));
+    CALL_SUBTEST_2(( randomized_svd_dense<MatrixXcd>(rows, cols) ));
+    CALL_SUBTEST_3(( randomized_svd_dense<Matrix<float,Dynamic,Dynamic,RowMajor> >(rows, cols) ));
+    CALL_SUBTEST_4(( randomized_svd_sparse<double>(rows, cols) ));
+    CALL_SUBTEST_5(( randomized_svd_sparse<std::complex<double> >(rows, cols) ));
+  }
+}
@@ -0,0 +1,76 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <unsupported/Eigen/StrassenProduct>
+
+template<typename Scalar>
+void strassen_product(Index rows, Index depth, Index cols, Index cutoff)
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowMatrixType;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+
+  MatrixType a = MatrixType::Random(rows, depth);
+  MatrixType b = MatrixType::Random(depth, cols);
+  RowMatrixType br = b;
+  MatrixType ref = a * b;
+
+  MatrixType c = strassenProduct(a, b, cutoff);
+  VERIFY_IS_APPROX(c, ref);
+  RowMatrixType cr = strassenProduct(a, br, cutoff);
+  VERIFY_IS_APPROX(cr, ref);
+
+  // expressions as operands and destination
+  MatrixType big = MatrixType::Zero(rows+2, cols+3);
+  big.block(1, 2, rows, cols) = strassenProduct(a.adjoint().adjoint(), Scalar(2) * b, cutoff);
+  VERIFY_IS_APPROX(big.block(1, 2, rows, cols), Scalar(2) * ref);
+  VERIFY_IS_EQUAL(big.row(0).squaredNorm(), RealScalar(0));
+  c = strassenProduct(b.transpose(), a.transpose(), cutoff);
+  VERIFY_IS_APPROX(c, ref.transpose());
+
+  // vector results
+  Matrix<Scalar,1,Dynamic> rowRes = strassenProduct(a.row(0), b, cutoff);
+  VERIFY_IS_APPROX(rowRes, ref.row(0));
+  Matrix<Scalar,Dynamic,1> colRes = strassenProduct(a, b.col(0), cutoff);
+  VERIFY_IS_APPROX(colRes, ref.col(0));
+  VERIFY_IS_APPROX(strassenProduct(a.row(0), b, cutoff).eval(), ref.row(0));
+
+  // the global cutoff
+  Index oldCutoff = strassenCutoff();
+  setStrassenCutoff(cutoff);
+  VERIFY_IS_EQUAL(strassenCutoff(), cutoff);
+  c = strassenProduct(a, b);
+  VERIFY_IS_APPROX(c, ref);
+  setStrassenCutoff(oldCutoff);
+}
+
+template<typename Scalar>
+void strassen_product_accuracy()
+{
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixType;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  const Index size = 256;
+  MatrixType a = MatrixType::Random(size, size), b = MatrixType::Random(size, size);
+  MatrixType ref = a * b;
+  // five levels of recursion, the error must remain a small multiple of the one of the classical product
+  MatrixType c = strassenProduct(a, b, 8);
+  VERIFY((c - ref).norm() <= RealScalar(100) * NumTraits<Scalar>::epsilon() * a.norm() * b.norm());
+}
+
+EIGEN_DECLARE_TEST(strassen_product)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( strassen_product<float>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,16)) ));
+    CALL_SUBTEST_2(( strassen_product<double>(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,16)) ));
+    CALL_SUBTEST_3(( strassen_product<std::complex<double> >(internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,EIGEN_TEST_MAX_SIZE),internal::random<Index>(1,16)) ));
+    CALL_SUBTEST_2(( strassen_product<double>(internal::random<Index>(1,5),internal::random<Index>(1,5),internal::random<Index>(1,5),1) ));
+  }
+  CALL_SUBTEST_2(( strassen_product<double>(129, 65, 97, 4) ));
+  CALL_SUBTEST_4(( strassen_product_accuracy<float>() ));
+  CALL_SUBTEST_4(( strassen_product_accuracy<double>() ));
+}
@@ -0,0 +1,90 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <unsupported/Eigen/TallSkinnyQR>
+
+template<typename MatrixType>
+void tall_skinny_qr(Index rows, Index cols, Index blockRows)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseType;
+
+  MatrixType a = MatrixType::Random(rows, cols);
+  DenseType b = DenseType::Random(rows, 2);
+
+  TallSkinnyQR<MatrixType> tsqr;
+  tsqr.setBlockRows(blockRows).compute(a);
+  VERIFY_IS_EQUAL(tsqr.rows(), rows);
+  VERIFY_IS_EQUAL(tsqr.cols(), cols);
+  VERIFY(tsqr.leafCount() >= 1);
+  VERIFY_IS_EQUAL(tsqr.leafCount(), numext::maxi(Index(1), rows/tsqr.blockRows()));
+
+  // R is upper triangular, and R^* R = A^* A since Q is unitary
+  DenseType r = tsqr.matrixR();
+  VERIFY_IS_EQUAL(DenseType(r.template triangularView<StrictlyLower>()), DenseType::Zero(cols, cols));
+  VERIFY_IS_APPROX(DenseType(r.adjoint() * r), DenseType(a.adjoint() * a));
+
+  // same least-squares solutions as HouseholderQR
+  DenseType ref = a.householderQr().solve(b);
+  DenseType x = tsqr.solve(b);
+  VERIFY_IS_APPROX(x, ref);
+
+  // the same rows given by blocks of random sizes, some of them smaller than the number of columns
+  tsqr.setBlockRows(blockRows).reset(cols, 2);
+  Index start = 0;
+  while(start < rows)
+  {
+    Index size = numext::mini(rows-start, internal::random<Index>(0, 3*tsqr.blockRows()));
+    tsqr.addRows(a.middleRows(start, size), b.middleRows(start, size));
+    start += size;
+  }
+  VERIFY_IS_EQUAL(tsqr.rows(), rows);
+  r = tsqr.matrixR();
+  VERIFY_IS_APPROX(DenseType(r.adjoint() * r), DenseType(a.adjoint() * a));
+  VERIFY_IS_APPROX(tsqr.solution(), ref);
+  VERIFY_RAISES_ASSERT(x = tsqr.solve(b));
+
+  // without right hand sides
+  tsqr.reset(cols);
+  tsqr.addRows(a.topRows(rows/2)).addRows(a.bottomRows(rows-rows/2));
+  r = tsqr.matrixR();
+  VERIFY_IS_APPROX(DenseType(r.adjoint() * r), DenseType(a.adjoint() * a));
+  VERIFY_RAISES_ASSERT(tsqr.addRows(a, b));
+}
+
+template<typename MatrixType>
+void tall_skinny_qr_verify_assert()
+{
+  MatrixType tmp(2, 3);
+  TallSkinnyQR<MatrixType> tsqr;
+  VERIFY_RAISES_ASSERT(tsqr.matrixR());
+  VERIFY_RAISES_ASSERT(tsqr.solution());
+  VERIFY_RAISES_ASSERT(tsqr.addRows(tmp));
+  // not tall
+  VERIFY_RAISES_ASSERT(tsqr.compute(tmp));
+}
+
+EIGEN_DECLARE_TEST(tall_skinny_qr)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    Index cols = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE/8);
+    Index rows = internal::random<Index>(cols,40*cols);
+    Index blockRows = internal::random<Index>(1,4*cols);
+    TEST_SET_BUT_UNUSED_VARIABLE(rows)
+    TEST_SET_BUT_UNUSED_VARIABLE(blockRows)
+    CALL_SUBTEST_1(( tall_skinny_qr<MatrixXd>(rows, cols, blockRows) ));
+    CALL_SUBTEST_2(( tall_skinny_qr<MatrixXcf>(rows, cols, blockRows) ));
+    CALL_SUBTEST_3(( tall_skinny_qr<Matrix<float,Dynamic,4,RowMajor> >(internal::random<Index>(4,200), 4, internal::random<Index>(1,20)) ));
+  }
+  CALL_SUBTEST_1(( tall_skinny_qr_verify_assert<MatrixXd>() ));
+
+  // more leaves than threads, and a large last level of the tree
+  CALL_SUBTEST_1(( tall_skinny_qr<MatrixXd>(20000, 16, 0) ));
+  setNbThreads(3);
+  CALL_SUBTEST_4(( tall_skinny_qr<MatrixXd>(5000, 20, 60) ));
+}